@@ -0,0 +1,503 @@
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // command line option names
+#include <algorithm>        // frame time percentiles
+#include <chrono>           // scene setup time
+#include <fstream>          // benchmark results file
+#include <sstream>          // object count lists
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShaderManager.h"
+#include "UniformCache.h"
+#include "GLStateCache.h"
+#include "HeadlessRenderer.h"
+#include "SceneGenerator.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title
+	const char* const WINDOW_TITLE = "Scene Benchmark";
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// uniform cache object for resolving shader uniform locations once
+	UniformCache* g_UniformCache = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+
+	struct BENCHMARK_OPTIONS
+	{
+		// scene sizes to run, in objects
+		std::vector<int> objectCounts = { 1000, 10000, 100000 };
+		// frames rendered before the timed frames
+		int warmupFrames = 30;
+		// timed frames of each scene size
+		int frameCount = 300;
+		uint32_t seed = 1;
+		int width = HeadlessRenderer::DEFAULT_WIDTH;
+		int height = HeadlessRenderer::DEFAULT_HEIGHT;
+		// camera path file, or empty to circle the generated scene
+		std::string cameraPath;
+		// results file, or empty to write the results to stdout
+		std::string outputFile;
+		// threads updating, culling and sorting the scene, including
+		// the rendering thread, or 0 for one per processor core
+		int threadCount = 0;
+		// true to merge the generated objects into static batches
+		bool bStatic = false;
+		// true to submit the instanced draws with multi-draw calls
+		bool bMultiDraw = true;
+		// true to skip the objects hidden behind large occluders
+		bool bOcclusion = true;
+	};
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool ParseCommandLine(int argc, char* argv[], BENCHMARK_OPTIONS& options);
+bool InitializeGLFW();
+bool InitializeGLEW();
+bool RunBenchmark(const BENCHMARK_OPTIONS& options, int objectCount, std::ostream& results);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the benchmark has been
+ *  launched.  It renders generated scenes of every requested
+ *  size offscreen, from the repository root so the shaders
+ *  and textures are found, and writes one line of JSON with
+ *  the results of each size.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	BENCHMARK_OPTIONS options;
+	if (ParseCommandLine(argc, argv, options) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// the results go to stdout, or the results file, and every
+	// other message printed by the scene goes to stderr
+	std::streambuf* pStdoutBuffer = std::cout.rdbuf();
+	std::ofstream resultsFile;
+	if (options.outputFile.empty() == false)
+	{
+		resultsFile.open(options.outputFile, std::ios::trunc);
+		if (!resultsFile)
+		{
+			std::cerr << "Could not open results file: " << options.outputFile << std::endl;
+			return(EXIT_FAILURE);
+		}
+	}
+	std::ostream results((options.outputFile.empty() == false) ? resultsFile.rdbuf() : pStdoutBuffer);
+	std::cout.rdbuf(std::cerr.rdbuf());
+
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager);
+
+	// create the hidden window owning the OpenGL context
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+	if (g_Window == NULL)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// load the shader code from the external GLSL files
+	GLuint programID = g_ShaderManager->LoadShaders(
+		"Shaders/vertexShader.glsl",
+		"Shaders/fragmentShader.glsl");
+	GLStateCache::UseProgram(programID);
+
+	// create the uniform cache used by the scene manager
+	g_UniformCache = new UniformCache();
+
+	// prepare the textures, materials, lights and meshes of the
+	// scene - the objects are replaced by each scene size
+	g_SceneManager = new SceneManager(g_ShaderManager, g_UniformCache);
+	if (options.threadCount > 0)
+	{
+		g_SceneManager->SetWorkerThreads(options.threadCount - 1);
+	}
+	g_SceneManager->SetMultiDrawEnabled(options.bMultiDraw);
+	g_SceneManager->SetOcclusionCulling(options.bOcclusion);
+	g_UniformCache->Initialize();
+	g_SceneManager->PrepareScene();
+
+	int exitCode = EXIT_SUCCESS;
+	for (size_t i = 0; i < options.objectCounts.size(); i++)
+	{
+		if (RunBenchmark(options, options.objectCounts[i], results) == false)
+		{
+			exitCode = EXIT_FAILURE;
+			break;
+		}
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_UniformCache)
+	{
+		delete g_UniformCache;
+		g_UniformCache = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	glfwTerminate();
+	std::cout.rdbuf(pStdoutBuffer);
+	return(exitCode);
+}
+
+/***********************************************************
+ *	RunBenchmark()
+ *
+ *  This function is used to generate a scene of the passed
+ *  in size, render the warm-up frames and then the timed
+ *  frames along the camera path, and write the results.
+ *  Counters are divided by the timed frames so results of
+ *  different frame counts can be compared.
+ ***********************************************************/
+bool RunBenchmark(const BENCHMARK_OPTIONS& options, int objectCount, std::ostream& results)
+{
+	SceneGenerator generator(g_SceneManager);
+	SceneGenerator::GENERATED_SCENE scene;
+
+	std::chrono::steady_clock::time_point setupStart = std::chrono::steady_clock::now();
+	generator.Generate(objectCount, options.seed, scene);
+	if (options.bStatic == true)
+	{
+		// the generated scene never moves
+		for (int i = 0; i < g_SceneManager->GetItemCount(); i++)
+		{
+			g_SceneManager->SetItemStatic(i, true);
+		}
+	}
+	double setupTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count();
+
+	CameraPath cameraPath;
+	if (options.cameraPath.empty() == false)
+	{
+		if (cameraPath.Load(options.cameraPath) == false)
+		{
+			return(false);
+		}
+	}
+	else
+	{
+		SceneGenerator::BuildCameraPath(scene, cameraPath);
+	}
+
+	HeadlessRenderer renderer(g_ViewManager, g_SceneManager);
+	HeadlessRenderer::HEADLESS_OPTIONS renderOptions;
+	renderOptions.width = options.width;
+	renderOptions.height = options.height;
+
+	// the warm-up frames build the bounding volumes and settle
+	// the caches before anything is timed
+	if (options.warmupFrames > 0)
+	{
+		renderOptions.frameCount = options.warmupFrames;
+		if (renderer.Run(renderOptions, cameraPath) == false)
+		{
+			return(false);
+		}
+	}
+
+	g_SceneManager->ResetRenderStats();
+	g_UniformCache->ResetStats();
+	GLStateCache::ResetStats();
+
+	renderOptions.frameCount = options.frameCount;
+	if (renderer.Run(renderOptions, cameraPath) == false)
+	{
+		return(false);
+	}
+
+	const SceneManager::RENDER_STATS& renderStats = g_SceneManager->GetRenderStats();
+	const UniformCache::UNIFORM_STATS& uniformStats = g_UniformCache->GetStats();
+	const GLStateCache::STATE_STATS& glStateStats = GLStateCache::GetStats();
+
+	std::vector<float> frameTimes = renderer.GetFrameTimes();
+	std::sort(frameTimes.begin(), frameTimes.end());
+	double totalTime = 0.0;
+	for (size_t i = 0; i < frameTimes.size(); i++)
+	{
+		totalTime += frameTimes[i];
+	}
+
+	double frames = (double)std::max(options.frameCount, 1);
+	size_t last = frameTimes.size() - 1;
+
+	results << "{\"objects\":" << objectCount <<
+		",\"pencils\":" << scene.pencils <<
+		",\"books\":" << scene.books <<
+		",\"monitors\":" << scene.monitors <<
+		",\"seed\":" << options.seed <<
+		",\"width\":" << options.width <<
+		",\"height\":" << options.height <<
+		",\"frames\":" << options.frameCount <<
+		",\"threads\":" << g_SceneManager->GetThreadCount() <<
+		",\"static\":" << ((options.bStatic == true) ? "true" : "false") <<
+		",\"multi_draw\":" << ((options.bMultiDraw == true) ? "true" : "false") <<
+		",\"occlusion\":" << ((options.bOcclusion == true) ? "true" : "false") <<
+		",\"setup_ms\":" << setupTime <<
+		",\"cpu_frame_ms\":{\"mean\":" << (totalTime / frames) <<
+		",\"min\":" << frameTimes.front() <<
+		",\"p50\":" << frameTimes[last * 50 / 100] <<
+		",\"p95\":" << frameTimes[last * 95 / 100] <<
+		",\"p99\":" << frameTimes[last * 99 / 100] <<
+		",\"max\":" << frameTimes.back() << "}" <<
+		",\"frames_per_second\":" << ((renderer.GetRunTime() > 0.0) ? (frames / renderer.GetRunTime()) : 0.0) <<
+		",\"drawn_items_per_frame\":" << (renderStats.drawnItems / frames) <<
+		",\"draw_calls_per_frame\":" << (renderStats.drawCalls / frames) <<
+		",\"instanced_draws_per_frame\":" << (renderStats.instancedDraws / frames) <<
+		",\"multi_draws_per_frame\":" << (renderStats.multiDraws / frames) <<
+		",\"reduced_detail_items_per_frame\":" << (renderStats.reducedDetailItems / frames) <<
+		",\"static_batch_draws_per_frame\":" << (renderStats.staticBatchDraws / frames) <<
+		",\"static_batch_items_per_frame\":" << (renderStats.staticBatchItems / frames) <<
+		",\"occluders_per_frame\":" << (renderStats.occluders / frames) <<
+		",\"occluded_items_per_frame\":" << (renderStats.occludedItems / frames) <<
+		",\"state_changes_per_frame\":" << (renderStats.stateChanges / frames) <<
+		",\"uniform_uploads_per_frame\":" << (uniformStats.uploads / frames) <<
+		",\"uniform_skipped_per_frame\":" << (uniformStats.skipped / frames) <<
+		",\"gl_state_calls_per_frame\":" << (glStateStats.issued / frames) <<
+		",\"gl_state_calls_elided_per_frame\":" << (glStateStats.elided / frames) <<
+		"}" << std::endl;
+
+	return(results.good());
+}
+
+/***********************************************************
+ *	ParseCommandLine()
+ *
+ *  This function is used to read the command line options:
+ *
+ *  --objects <n,n,...>   scene sizes to run, in objects
+ *  --frames <count>      timed frames of each scene size
+ *  --warmup <count>      frames rendered before timing
+ *  --seed <number>       seed of the generated scenes
+ *  --camera-path <file>  camera path instead of the orbit
+ *  --output <file>       results file instead of stdout
+ *  --width <pixels>      width of the rendered frames
+ *  --height <pixels>     height of the rendered frames
+ *  --threads <count>     threads updating the scene, 1 for
+ *                        no worker threads
+ *  --static <0|1>        1 to merge the generated objects
+ *                        into static batches
+ *  --multi-draw <0|1>    0 to draw the instanced draws one
+ *                        call at a time
+ *  --occlusion <0|1>     0 to draw the objects hidden behind
+ *                        large boxes and planes
+ ***********************************************************/
+bool ParseCommandLine(int argc, char* argv[], BENCHMARK_OPTIONS& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* option = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (value == NULL)
+		{
+			std::cerr << "Unknown option or missing value: " << option << std::endl;
+			std::cerr << "Usage: " << argv[0] << " [--objects <n,n,...>] [--frames <count>] [--warmup <count>] [--seed <number>] [--camera-path <file>] [--output <file>] [--width <pixels>] [--height <pixels>] [--threads <count>] [--static <0|1>] [--multi-draw <0|1>] [--occlusion <0|1>]" << std::endl;
+			return(false);
+		}
+
+		if (strcmp(option, "--objects") == 0)
+		{
+			options.objectCounts.clear();
+			std::istringstream counts(value);
+			std::string count;
+			while (std::getline(counts, count, ','))
+			{
+				options.objectCounts.push_back(atoi(count.c_str()));
+			}
+		}
+		else if (strcmp(option, "--frames") == 0)
+		{
+			options.frameCount = atoi(value);
+		}
+		else if (strcmp(option, "--warmup") == 0)
+		{
+			options.warmupFrames = atoi(value);
+		}
+		else if (strcmp(option, "--seed") == 0)
+		{
+			options.seed = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(option, "--camera-path") == 0)
+		{
+			options.cameraPath = value;
+		}
+		else if (strcmp(option, "--output") == 0)
+		{
+			options.outputFile = value;
+		}
+		else if (strcmp(option, "--width") == 0)
+		{
+			options.width = atoi(value);
+		}
+		else if (strcmp(option, "--height") == 0)
+		{
+			options.height = atoi(value);
+		}
+		else if (strcmp(option, "--threads") == 0)
+		{
+			options.threadCount = atoi(value);
+		}
+		else if (strcmp(option, "--static") == 0)
+		{
+			options.bStatic = (atoi(value) != 0);
+		}
+		else if (strcmp(option, "--multi-draw") == 0)
+		{
+			options.bMultiDraw = (atoi(value) != 0);
+		}
+		else if (strcmp(option, "--occlusion") == 0)
+		{
+			options.bOcclusion = (atoi(value) != 0);
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << option << std::endl;
+			return(false);
+		}
+		i++;
+	}
+
+	if ((options.objectCounts.empty() == true) ||
+		(*std::min_element(options.objectCounts.begin(), options.objectCounts.end()) <= 0))
+	{
+		std::cerr << "The object counts must be positive" << std::endl;
+		return(false);
+	}
+	if ((options.frameCount <= 0) || (options.warmupFrames < 0) || (options.width <= 0) || (options.height <= 0))
+	{
+		std::cerr << "The frame count, width and height must be positive" << std::endl;
+		return(false);
+	}
+	if (options.threadCount < 0)
+	{
+		std::cerr << "The thread count must not be negative" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ *
+ *  This function is used to initialize the GLFW library for
+ *  rendering without a display.  GLFW 3.4 runs on its null
+ *  platform with an OSMesa (software) context, so the
+ *  benchmark also runs on machines without a GPU; older
+ *  versions use a hidden window.
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+#ifdef GLFW_PLATFORM_NULL
+	glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+	if (glfwInit() == GLFW_FALSE)
+	{
+		std::cerr << "Failed to initialize GLFW" << std::endl;
+		return(false);
+	}
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use - software
+	// implementations such as llvmpipe stop at 4.5
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+
+	// the window is only used for its context
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+	glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+	// an OSMesa context has no GLX display, but the functions
+	// have still been loaded
+	if (GLEW_ERROR_NO_GLX_DISPLAY == GLEWInitResult)
+	{
+		GLEWInitResult = GLEW_OK;
+	}
+#endif
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return(false);
+	}
+	// GLEW: end -------------------------------
+
+	// Displays the OpenGL implementation the results were measured on
+	std::cout << "INFO: OpenGL Renderer: " << glGetString(GL_RENDERER) << "\n";
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
+}
@@ -0,0 +1,203 @@
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // command line option names
+#include <algorithm>        // per frame and per test times
+#include <chrono>           // timing
+#include <random>           // tested boxes
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "OcclusionBuffer.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	struct OCCLUSION_OPTIONS
+	{
+		// occluder frames rasterized per run
+		int frameCount = 1000;
+		// boxes tested per run
+		int testCount = 1000000;
+		// occluders drawn per frame, like SceneManager's limit
+		int occluderCount = 32;
+		uint32_t seed = 1;
+		int width = OcclusionBuffer::DEFAULT_WIDTH;
+		int height = OcclusionBuffer::DEFAULT_HEIGHT;
+	};
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool ParseCommandLine(int argc, char* argv[], OCCLUSION_OPTIONS& options);
+void RunBenchmark(const OCCLUSION_OPTIONS& options, bool bSimd);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the benchmark has been
+ *  launched.  It times the occlusion buffer with and
+ *  without SSE, and writes one line of JSON for each.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	OCCLUSION_OPTIONS options;
+	if (ParseCommandLine(argc, argv, options) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	RunBenchmark(options, true);
+	RunBenchmark(options, false);
+
+	return(EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *	RunBenchmark()
+ *
+ *  This function is used to time rasterizing a row of
+ *  walls and a floor reaching behind the camera, with
+ *  DrawBox() and Finish(), and then testing random boxes
+ *  behind and around them with IsBoxVisible().
+ ***********************************************************/
+void RunBenchmark(const OCCLUSION_OPTIONS& options, bool bSimd)
+{
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)options.width / (float)options.height, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 10.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 viewProjection = projection * view;
+
+	BOUNDING_BOX unitBox;
+	unitBox.min = glm::vec3(-0.5f);
+	unitBox.max = glm::vec3(0.5f);
+	BOUNDING_BOX floorPlane;
+	floorPlane.min = glm::vec3(-1.0f, 0.0f, -1.0f);
+	floorPlane.max = glm::vec3(1.0f, 0.0f, 1.0f);
+
+	std::vector<glm::mat4> occluders;
+	for (int i = 0; i < options.occluderCount; i++)
+	{
+		glm::mat4 wall = glm::translate(glm::mat4(1.0f), glm::vec3((float)(i % 8) * 2.0f - 7.0f, 1.0f, -(float)(i / 8) * 3.0f));
+		occluders.push_back(glm::scale(wall, glm::vec3(1.5f, 2.0f, 0.2f)));
+	}
+	glm::mat4 floor = glm::scale(glm::mat4(1.0f), glm::vec3(50.0f, 1.0f, 50.0f));
+
+	OcclusionBuffer buffer;
+	buffer.SetSize(options.width, options.height);
+	buffer.SetSimdEnabled(bSimd);
+
+	auto drawStart = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < options.frameCount; frame++)
+	{
+		buffer.Begin(viewProjection);
+		for (size_t i = 0; i < occluders.size(); i++)
+		{
+			buffer.DrawBox(unitBox, occluders[i]);
+		}
+		buffer.DrawBox(floorPlane, floor);
+		buffer.Finish();
+	}
+	double drawTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - drawStart).count();
+
+	// the boxes are made before timing the tests
+	std::mt19937 random(options.seed);
+	std::uniform_real_distribution<float> x(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> y(-1.0f, 4.0f);
+	std::uniform_real_distribution<float> z(-30.0f, 5.0f);
+	std::uniform_real_distribution<float> size(0.05f, 1.0f);
+	std::vector<BOUNDING_BOX> boxes(options.testCount);
+	for (int i = 0; i < options.testCount; i++)
+	{
+		glm::vec3 center(x(random), y(random), z(random));
+		glm::vec3 extent(size(random), size(random), size(random));
+		boxes[i].min = center - extent;
+		boxes[i].max = center + extent;
+	}
+
+	int visible = 0;
+	auto testStart = std::chrono::steady_clock::now();
+	for (int i = 0; i < options.testCount; i++)
+	{
+		if (buffer.IsBoxVisible(boxes[i]) == true)
+		{
+			visible++;
+		}
+	}
+	double testTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - testStart).count();
+
+	std::cout << "{\"simd\":" << ((bSimd == true) ? "true" : "false") <<
+		",\"width\":" << buffer.GetWidth() <<
+		",\"height\":" << buffer.GetHeight() <<
+		",\"occluders\":" << (occluders.size() + 1) <<
+		",\"triangles\":" << buffer.GetTriangleCount() <<
+		",\"frames\":" << options.frameCount <<
+		",\"draw_frame_ms\":" << (drawTime / std::max(options.frameCount, 1)) <<
+		",\"tests\":" << options.testCount <<
+		",\"visible\":" << visible <<
+		",\"test_ns\":" << (testTime * 1000000.0 / std::max(options.testCount, 1)) <<
+		"}" << std::endl;
+}
+
+/***********************************************************
+ *	ParseCommandLine()
+ *
+ *  This function is used to read the benchmark options
+ *  from the command line.
+ ***********************************************************/
+bool ParseCommandLine(int argc, char* argv[], OCCLUSION_OPTIONS& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* option = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (value == NULL)
+		{
+			std::cerr << "Unknown option or missing value: " << option << std::endl;
+			std::cerr << "Usage: " << argv[0] << " [--frames <count>] [--tests <count>] [--occluders <count>] [--seed <number>] [--width <pixels>] [--height <pixels>]" << std::endl;
+			return(false);
+		}
+
+		if (strcmp(option, "--frames") == 0)
+		{
+			options.frameCount = atoi(value);
+		}
+		else if (strcmp(option, "--tests") == 0)
+		{
+			options.testCount = atoi(value);
+		}
+		else if (strcmp(option, "--occluders") == 0)
+		{
+			options.occluderCount = atoi(value);
+		}
+		else if (strcmp(option, "--seed") == 0)
+		{
+			options.seed = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(option, "--width") == 0)
+		{
+			options.width = atoi(value);
+		}
+		else if (strcmp(option, "--height") == 0)
+		{
+			options.height = atoi(value);
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << option << std::endl;
+			return(false);
+		}
+		i++;
+	}
+
+	if ((options.frameCount < 0) || (options.testCount < 0) || (options.occluderCount < 0) ||
+		(options.width <= 0) || (options.height <= 0))
+	{
+		std::cerr << "The counts must not be negative and the size must be positive" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
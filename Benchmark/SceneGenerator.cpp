@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegenerator.cpp
+// ============
+// generate reproducible scenes of any size for benchmarking
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// declaration of the global variables and defines
+namespace
+{
+	// height of the objects above the ground
+	const float PENCIL_HEIGHT = 0.1f;
+	const float BOOKS_HEIGHT = 1.3f;
+	const float MONITOR_HEIGHT = 1.5f;
+
+	// scene manager nodes and draw items added per object, at most
+	const int NODES_PER_OBJECT = 4;
+	const int ITEMS_PER_OBJECT = 3;
+
+	// camera path around the generated scenes
+	const int CAMERA_PATH_KEYS = 8;
+	const float CAMERA_HEIGHT = 6.0f;
+	const float MIN_CAMERA_RADIUS = 5.0f;
+
+	// number between -0.5 and 0.5 - the standard distributions
+	// are not required to give the same numbers everywhere, the
+	// engine itself is
+	float Jitter(std::mt19937& random)
+	{
+		return((float)(random() >> 8) / (float)(1 << 24) - 0.5f);
+	}
+}
+
+/***********************************************************
+ *  SceneGenerator()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneGenerator::SceneGenerator(SceneManager* pSceneManager)
+{
+	m_pSceneManager = pSceneManager;
+}
+
+/***********************************************************
+ *  ~SceneGenerator()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneGenerator::~SceneGenerator()
+{
+	m_pSceneManager = NULL;
+}
+
+/***********************************************************
+ *  Generate()
+ *
+ *  This method is used for replacing the scene with a square
+ *  grid of the passed in number of objects.  Each cell gets
+ *  a random kind of object, moved randomly within its cell.
+ ***********************************************************/
+void SceneGenerator::Generate(int objectCount, uint32_t seed, GENERATED_SCENE& scene)
+{
+	scene.objectCount = objectCount;
+	scene.pencils = 0;
+	scene.books = 0;
+	scene.monitors = 0;
+	scene.center = glm::vec3(0.0f);
+	scene.extent = 0.0f;
+
+	m_pSceneManager->ClearScene();
+	if (objectCount <= 0)
+	{
+		return;
+	}
+	m_pSceneManager->ReserveSceneObjects(objectCount * NODES_PER_OBJECT, objectCount * ITEMS_PER_OBJECT);
+
+	std::mt19937 random(seed);
+	int gridSize = (int)std::ceil(std::sqrt((double)objectCount));
+	float origin = -0.5f * (float)(gridSize - 1) * CELL_SIZE;
+
+	for (int i = 0; i < objectCount; i++)
+	{
+		float x = origin + (float)(i % gridSize) * CELL_SIZE + Jitter(random);
+		float z = origin + (float)(i / gridSize) * CELL_SIZE + Jitter(random);
+
+		switch (random() % 3)
+		{
+		case 0:
+			m_pSceneManager->AddPencil(glm::vec3(x, PENCIL_HEIGHT, z));
+			scene.pencils++;
+			break;
+		case 1:
+			m_pSceneManager->AddStackOfBooks(glm::vec3(x, BOOKS_HEIGHT, z));
+			scene.books++;
+			break;
+		default:
+			m_pSceneManager->AddComputerMonitor(glm::vec3(x, MONITOR_HEIGHT, z));
+			scene.monitors++;
+			break;
+		}
+	}
+
+	scene.extent = (float)gridSize * CELL_SIZE;
+}
+
+/***********************************************************
+ *  BuildCameraPath()
+ *
+ *  This method is used for building a camera path that
+ *  circles a generated scene once, a little above the
+ *  objects and looking at the center, so that larger scenes
+ *  keep many objects within the far plane.
+ ***********************************************************/
+void SceneGenerator::BuildCameraPath(const GENERATED_SCENE& scene, CameraPath& cameraPath)
+{
+	cameraPath.Clear();
+
+	float radius = std::max(scene.extent * 0.4f, MIN_CAMERA_RADIUS);
+	for (int i = 0; i <= CAMERA_PATH_KEYS; i++)
+	{
+		float angle = glm::radians(360.0f * (float)i / (float)CAMERA_PATH_KEYS);
+		glm::vec3 position = scene.center + glm::vec3(std::sin(angle) * radius, CAMERA_HEIGHT, std::cos(angle) * radius);
+		cameraPath.AddKey(position, scene.center - position);
+	}
+}
@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegenerator.h
+// ============
+// generate reproducible scenes of any size for benchmarking
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CameraPath.h"
+#include "SceneManager.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+/***********************************************************
+ *  SceneGenerator
+ *
+ *  This class fills the scene manager with a grid of the
+ *  desk objects - pencils, stacks of books and computer
+ *  monitors - picked and nudged by a seeded random number
+ *  generator, so the same count and seed always build the
+ *  same scene on every machine.
+ ***********************************************************/
+class SceneGenerator
+{
+public:
+	// constructor
+	SceneGenerator(SceneManager* pSceneManager);
+	// destructor
+	~SceneGenerator();
+
+	// distance between the centers of neighbouring objects
+	static constexpr float CELL_SIZE = 3.0f;
+
+	struct GENERATED_SCENE
+	{
+		int objectCount;
+		int pencils;
+		int books;
+		int monitors;
+		// center and width of the square the objects cover
+		glm::vec3 center;
+		float extent;
+	};
+
+	// replace the scene with the passed in number of objects
+	void Generate(int objectCount, uint32_t seed, GENERATED_SCENE& scene);
+	// camera path circling a generated scene
+	static void BuildCameraPath(const GENERATED_SCENE& scene, CameraPath& cameraPath);
+
+private:
+	// pointer to the scene manager object
+	SceneManager* m_pSceneManager;
+};
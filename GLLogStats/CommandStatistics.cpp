@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////
+// commandstatistics.cpp
+// ============
+// count the draws, state changes and uploads of recorded frames
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CommandStatistics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+// declaration of the global variables and defines
+namespace
+{
+	// add the counters of a frame to a total
+	void AddStats(CommandStatistics::FRAME_STATS& total, const CommandStatistics::FRAME_STATS& frame)
+	{
+		total.drawCalls += frame.drawCalls;
+		total.instancedDraws += frame.instancedDraws;
+		total.multiDraws += frame.multiDraws;
+		total.instances += frame.instances;
+		total.stateChanges += frame.stateChanges;
+		total.redundantStateChanges += frame.redundantStateChanges;
+		total.uniformSets += frame.uniformSets;
+		total.redundantUniformSets += frame.redundantUniformSets;
+		total.bufferUploads += frame.bufferUploads;
+		total.redundantBufferUploads += frame.redundantBufferUploads;
+		total.uploadedBytes += frame.uploadedBytes;
+		total.redundantUploadedBytes += frame.redundantUploadedBytes;
+		total.textureBytes += frame.textureBytes;
+	}
+
+	// write one line of the report table
+	void ReportLine(std::ostream& output, const char* name, uint64_t total, double frames, uint64_t redundant, bool bHasRedundant)
+	{
+		output << std::left << std::setw(26) << name << std::right <<
+			std::setw(16) << total <<
+			std::setw(16) << std::fixed << std::setprecision(1) << (total / frames);
+		if (bHasRedundant == true)
+		{
+			double percent = (total > 0) ? (100.0 * redundant / total) : 0.0;
+			output << std::setw(16) << redundant <<
+				std::setw(11) << std::setprecision(1) << percent << "%";
+		}
+		output << std::endl;
+	}
+}
+
+/***********************************************************
+ *  CommandStatistics()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CommandStatistics::CommandStatistics()
+{
+	memset(&m_preamble, 0, sizeof(m_preamble));
+	m_activeTexture = 0;
+	m_vertexArray = 0;
+	m_bVertexArrayKnown = false;
+	m_program = 0;
+	m_bProgramKnown = false;
+}
+
+/***********************************************************
+ *  Execute()
+ *
+ *  This method is used for applying a replayed command to
+ *  the tracked state and counting it in the current frame.
+ ***********************************************************/
+void CommandStatistics::Execute(const GLReplayer::REPLAY_COMMAND& command)
+{
+	switch (command.command)
+	{
+	case LOG_COMMAND_FRAME:
+	{
+		FRAME_STATS frame;
+		memset(&frame, 0, sizeof(frame));
+		m_frames.push_back(frame);
+		break;
+	}
+	case LOG_COMMAND_UNIFORM:
+	{
+		const LOG_UNIFORM_COMMAND* uniform = (const LOG_UNIFORM_COMMAND*)command.payload;
+		uint32_t size = LOG_UNIFORM_SIZES[uniform->type];
+
+		std::map<int32_t, UNIFORM_VALUE>::iterator found = m_uniforms.find(uniform->location);
+		bool bRedundant = (found != m_uniforms.end()) &&
+			(found->second.type == uniform->type) &&
+			(memcmp(found->second.value, command.value, size) == 0);
+
+		UNIFORM_VALUE& value = m_uniforms[uniform->location];
+		value.type = uniform->type;
+		memcpy(value.value, command.value, size);
+
+		Current().uniformSets++;
+		if (bRedundant == true)
+		{
+			Current().redundantUniformSets++;
+		}
+		break;
+	}
+	case LOG_COMMAND_BIND_BUFFER:
+	{
+		const LOG_BIND_BUFFER_COMMAND* bind = (const LOG_BIND_BUFFER_COMMAND*)command.payload;
+		std::map<uint32_t, uint32_t>::iterator found = m_buffers.find(bind->target);
+		CountStateChange((found != m_buffers.end()) && (found->second == bind->buffer));
+		m_buffers[bind->target] = bind->buffer;
+		break;
+	}
+	case LOG_COMMAND_BIND_BUFFER_BASE:
+	{
+		// binding to an indexed point also binds the buffer to
+		// the generic binding point of the target
+		const LOG_BIND_BUFFER_BASE_COMMAND* bind = (const LOG_BIND_BUFFER_BASE_COMMAND*)command.payload;
+		std::pair<uint32_t, uint32_t> key(bind->target, bind->index);
+		std::map<std::pair<uint32_t, uint32_t>, uint32_t>::iterator found = m_bufferBases.find(key);
+		CountStateChange((found != m_bufferBases.end()) && (found->second == bind->buffer));
+		m_bufferBases[key] = bind->buffer;
+		m_buffers[bind->target] = bind->buffer;
+		break;
+	}
+	case LOG_COMMAND_BUFFER_DATA:
+	{
+		const LOG_BUFFER_DATA_COMMAND* data = (const LOG_BUFFER_DATA_COMMAND*)command.payload;
+		// storage allocated without data, as when a buffer is
+		// orphaned, is not an upload - the uploads that refill
+		// it are still compared with the ones before it
+		if (data->hash != 0)
+		{
+			CountUpload(data->target, 0, data->size, data->hash);
+		}
+		break;
+	}
+	case LOG_COMMAND_BUFFER_SUB_DATA:
+	{
+		const LOG_BUFFER_SUB_DATA_COMMAND* data = (const LOG_BUFFER_SUB_DATA_COMMAND*)command.payload;
+		CountUpload(data->target, data->offset, data->size, data->hash);
+		break;
+	}
+	case LOG_COMMAND_ACTIVE_TEXTURE:
+	{
+		const LOG_ACTIVE_TEXTURE_COMMAND* active = (const LOG_ACTIVE_TEXTURE_COMMAND*)command.payload;
+		CountStateChange(active->unit == m_activeTexture);
+		m_activeTexture = active->unit;
+		break;
+	}
+	case LOG_COMMAND_BIND_TEXTURE:
+	{
+		const LOG_BIND_TEXTURE_COMMAND* bind = (const LOG_BIND_TEXTURE_COMMAND*)command.payload;
+		std::pair<uint32_t, uint32_t> key(m_activeTexture, bind->target);
+		std::map<std::pair<uint32_t, uint32_t>, uint32_t>::iterator found = m_textures.find(key);
+		CountStateChange((found != m_textures.end()) && (found->second == bind->texture));
+		m_textures[key] = bind->texture;
+		break;
+	}
+	case LOG_COMMAND_TEX_IMAGE:
+	{
+		const LOG_TEX_IMAGE_COMMAND* image = (const LOG_TEX_IMAGE_COMMAND*)command.payload;
+		Current().textureBytes += image->size;
+		break;
+	}
+	case LOG_COMMAND_BIND_VERTEX_ARRAY:
+	{
+		const LOG_BIND_VERTEX_ARRAY_COMMAND* bind = (const LOG_BIND_VERTEX_ARRAY_COMMAND*)command.payload;
+		CountStateChange((m_bVertexArrayKnown == true) && (m_vertexArray == bind->vertexArray));
+		m_vertexArray = bind->vertexArray;
+		m_bVertexArrayKnown = true;
+		break;
+	}
+	case LOG_COMMAND_USE_PROGRAM:
+	{
+		const LOG_USE_PROGRAM_COMMAND* use = (const LOG_USE_PROGRAM_COMMAND*)command.payload;
+		CountStateChange((m_bProgramKnown == true) && (m_program == use->program));
+		m_program = use->program;
+		m_bProgramKnown = true;
+		break;
+	}
+	case LOG_COMMAND_ENABLE:
+	{
+		const LOG_ENABLE_COMMAND* enable = (const LOG_ENABLE_COMMAND*)command.payload;
+		CountStateChange(m_enabled.insert(enable->capability).second == false);
+		break;
+	}
+	case LOG_COMMAND_DRAW_MESH:
+	{
+		// the meshes bind their own vertex arrays
+		Current().drawCalls++;
+		Current().instances++;
+		m_bVertexArrayKnown = false;
+		break;
+	}
+	case LOG_COMMAND_DRAW_ELEMENTS_INSTANCED:
+	{
+		const LOG_DRAW_ELEMENTS_INSTANCED_COMMAND* draw = (const LOG_DRAW_ELEMENTS_INSTANCED_COMMAND*)command.payload;
+		Current().drawCalls++;
+		Current().instancedDraws++;
+		Current().instances += (uint64_t)std::max(draw->instanceCount, 0);
+		break;
+	}
+	case LOG_COMMAND_MULTI_DRAW_ELEMENTS_INDIRECT:
+	{
+		// one call, but each of its draws is an instanced draw
+		const LOG_MULTI_DRAW_ELEMENTS_INDIRECT_COMMAND* draw = (const LOG_MULTI_DRAW_ELEMENTS_INDIRECT_COMMAND*)command.payload;
+		Current().drawCalls++;
+		Current().multiDraws++;
+		Current().instancedDraws += (uint64_t)std::max(draw->drawCount, 0);
+		Current().instances += (uint64_t)std::max(draw->instanceCount, 0);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+/***********************************************************
+ *  Report()
+ *
+ *  This method is used for writing the totals of all frames,
+ *  their average per frame and the redundant part of them.
+ ***********************************************************/
+void CommandStatistics::Report(std::ostream& output) const
+{
+	FRAME_STATS total;
+	memset(&total, 0, sizeof(total));
+	for (size_t i = 0; i < m_frames.size(); i++)
+	{
+		AddStats(total, m_frames[i]);
+	}
+	double frames = (double)std::max(m_frames.size(), (size_t)1);
+
+	output << "Frames: " << m_frames.size() << std::endl;
+	output << "Uploads before the first frame: " << m_preamble.uploadedBytes << " buffer bytes, " <<
+		m_preamble.textureBytes << " texture bytes" << std::endl << std::endl;
+
+	output << std::left << std::setw(26) << "" << std::right <<
+		std::setw(16) << "total" <<
+		std::setw(16) << "per frame" <<
+		std::setw(16) << "redundant" <<
+		std::setw(12) << "redundant %" << std::endl;
+	ReportLine(output, "draw calls", total.drawCalls, frames, 0, false);
+	ReportLine(output, "instanced draws", total.instancedDraws, frames, 0, false);
+	ReportLine(output, "multi-draw calls", total.multiDraws, frames, 0, false);
+	ReportLine(output, "instances", total.instances, frames, 0, false);
+	ReportLine(output, "state changes", total.stateChanges, frames, total.redundantStateChanges, true);
+	ReportLine(output, "uniform sets", total.uniformSets, frames, total.redundantUniformSets, true);
+	ReportLine(output, "buffer uploads", total.bufferUploads, frames, total.redundantBufferUploads, true);
+	ReportLine(output, "buffer bytes uploaded", total.uploadedBytes, frames, total.redundantUploadedBytes, true);
+	ReportLine(output, "texture bytes uploaded", total.textureBytes, frames, 0, false);
+}
+
+/***********************************************************
+ *  ReportFrames()
+ *
+ *  This method is used for writing the counters of every
+ *  frame as lines of CSV, after a header line.
+ ***********************************************************/
+void CommandStatistics::ReportFrames(std::ostream& output) const
+{
+	output << "frame,draw_calls,instanced_draws,multi_draws,instances,state_changes,redundant_state_changes," <<
+		"uniform_sets,redundant_uniform_sets,buffer_uploads,redundant_buffer_uploads," <<
+		"uploaded_bytes,redundant_uploaded_bytes,texture_bytes" << std::endl;
+	for (size_t i = 0; i < m_frames.size(); i++)
+	{
+		const FRAME_STATS& frame = m_frames[i];
+		output << i << "," <<
+			frame.drawCalls << "," <<
+			frame.instancedDraws << "," <<
+			frame.multiDraws << "," <<
+			frame.instances << "," <<
+			frame.stateChanges << "," <<
+			frame.redundantStateChanges << "," <<
+			frame.uniformSets << "," <<
+			frame.redundantUniformSets << "," <<
+			frame.bufferUploads << "," <<
+			frame.redundantBufferUploads << "," <<
+			frame.uploadedBytes << "," <<
+			frame.redundantUploadedBytes << "," <<
+			frame.textureBytes << std::endl;
+	}
+}
+
+/***********************************************************
+ *  Current()
+ *
+ *  This method is used for getting the counters of the frame
+ *  being replayed.
+ ***********************************************************/
+CommandStatistics::FRAME_STATS& CommandStatistics::Current()
+{
+	if (m_frames.empty())
+	{
+		return(m_preamble);
+	}
+	return(m_frames.back());
+}
+
+/***********************************************************
+ *  CountStateChange()
+ *
+ *  This method is used for counting a bind or enable.
+ ***********************************************************/
+void CommandStatistics::CountStateChange(bool bRedundant)
+{
+	Current().stateChanges++;
+	if (bRedundant == true)
+	{
+		Current().redundantStateChanges++;
+	}
+}
+
+/***********************************************************
+ *  CountUpload()
+ *
+ *  This method is used for counting an upload into the
+ *  buffer bound to a target, and remembering its hash to
+ *  compare the next upload of the same range against.
+ ***********************************************************/
+void CommandStatistics::CountUpload(uint32_t target, uint64_t offset, uint64_t size, uint64_t hash)
+{
+	std::tuple<uint32_t, uint64_t, uint64_t> key(m_buffers[target], offset, size);
+	std::map<std::tuple<uint32_t, uint64_t, uint64_t>, uint64_t>::iterator found = m_uploads.find(key);
+	bool bRedundant = (found != m_uploads.end()) && (found->second == hash);
+	m_uploads[key] = hash;
+
+	FRAME_STATS& frame = Current();
+	frame.bufferUploads++;
+	frame.uploadedBytes += size;
+	if (bRedundant == true)
+	{
+		frame.redundantBufferUploads++;
+		frame.redundantUploadedBytes += size;
+	}
+}
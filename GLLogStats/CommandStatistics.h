@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// commandstatistics.h
+// ============
+// count the draws, state changes and uploads of recorded frames
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GLReplayer.h"
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/***********************************************************
+ *  CommandStatistics
+ *
+ *  This class is a replay handler that tracks the OpenGL
+ *  state set by the replayed commands, and counts for each
+ *  frame the draws, the state changes and uniform sets -
+ *  redundant ones leave the state as it was - and the bytes
+ *  uploaded into buffers and textures.  An upload is
+ *  redundant when it writes the same bytes into the same
+ *  range of the same buffer as the upload before it.
+ ***********************************************************/
+class CommandStatistics : public GLReplayer::Handler
+{
+public:
+	// constructor
+	CommandStatistics();
+
+	struct FRAME_STATS
+	{
+		uint64_t drawCalls;
+		uint64_t instancedDraws;
+		// calls submitting several draws from an indirect buffer
+		uint64_t multiDraws;
+		uint64_t instances;
+		uint64_t stateChanges;
+		uint64_t redundantStateChanges;
+		uint64_t uniformSets;
+		uint64_t redundantUniformSets;
+		uint64_t bufferUploads;
+		uint64_t redundantBufferUploads;
+		uint64_t uploadedBytes;
+		uint64_t redundantUploadedBytes;
+		uint64_t textureBytes;
+	};
+
+	// track and count one replayed command
+	void Execute(const GLReplayer::REPLAY_COMMAND& command) override;
+
+	// counters of each recorded frame
+	const std::vector<FRAME_STATS>& GetFrames() const { return(m_frames); }
+	// counters of the commands recorded before the first frame
+	const FRAME_STATS& GetPreamble() const { return(m_preamble); }
+
+	// write the totals and per frame averages as a table
+	void Report(std::ostream& output) const;
+	// write the counters of every frame as CSV lines
+	void ReportFrames(std::ostream& output) const;
+
+private:
+	struct UNIFORM_VALUE
+	{
+		uint32_t type;
+		unsigned char value[64];
+	};
+
+	std::vector<FRAME_STATS> m_frames;
+	FRAME_STATS m_preamble;
+
+	// tracked state - buffers by target, indexed buffers by
+	// target and index, textures by unit and target
+	std::map<uint32_t, uint32_t> m_buffers;
+	std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_bufferBases;
+	std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_textures;
+	std::map<int32_t, UNIFORM_VALUE> m_uniforms;
+	std::set<uint32_t> m_enabled;
+	uint32_t m_activeTexture;
+	uint32_t m_vertexArray;
+	bool m_bVertexArrayKnown;
+	uint32_t m_program;
+	bool m_bProgramKnown;
+	// hash of the last upload into each buffer, offset and size
+	std::map<std::tuple<uint32_t, uint64_t, uint64_t>, uint64_t> m_uploads;
+
+	// counters of the frame being replayed
+	FRAME_STATS& Current();
+	// count a state change, which is redundant when the
+	// tracked state already had the value
+	void CountStateChange(bool bRedundant);
+	// count an upload into the buffer bound to a target
+	void CountUpload(uint32_t target, uint64_t offset, uint64_t size, uint64_t hash);
+};
@@ -0,0 +1,192 @@
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // command line option names
+#include <fstream>          // per frame results file
+#include <string>
+
+#include "GLReplayer.h"
+#include "CommandStatistics.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	struct STATS_OPTIONS
+	{
+		// command log recorded with --record
+		std::string logFile;
+		// CSV file receiving the counters of every frame
+		std::string framesFile;
+		// print every command of the log
+		bool bDump = false;
+	};
+
+	/***********************************************************
+	 *  CommandPrinter
+	 *
+	 *  Replay handler printing each command and its payload
+	 *  as one line of text.
+	 ***********************************************************/
+	class CommandPrinter : public GLReplayer::Handler
+	{
+	public:
+		void Execute(const GLReplayer::REPLAY_COMMAND& command) override
+		{
+			const uint32_t* fields = (const uint32_t*)command.payload;
+
+			switch (command.command)
+			{
+			case LOG_COMMAND_FRAME:
+				std::cout << "frame " << fields[0] << std::endl;
+				return;
+			case LOG_COMMAND_UNIFORM:
+			{
+				const LOG_UNIFORM_COMMAND* uniform = (const LOG_UNIFORM_COMMAND*)command.payload;
+				const float* values = (const float*)command.value;
+				std::cout << "  Uniform " << uniform->location;
+				if (uniform->type == LOG_UNIFORM_INT)
+				{
+					std::cout << " " << *(const int32_t*)command.value;
+				}
+				else
+				{
+					for (uint32_t i = 0; i < LOG_UNIFORM_SIZES[uniform->type] / sizeof(float); i++)
+					{
+						std::cout << " " << values[i];
+					}
+				}
+				std::cout << std::endl;
+				return;
+			}
+			case LOG_COMMAND_BUFFER_DATA:
+			{
+				const LOG_BUFFER_DATA_COMMAND* data = (const LOG_BUFFER_DATA_COMMAND*)command.payload;
+				std::cout << "  BufferData " << data->target << " " << data->size << " bytes" << std::endl;
+				return;
+			}
+			case LOG_COMMAND_BUFFER_SUB_DATA:
+			{
+				const LOG_BUFFER_SUB_DATA_COMMAND* data = (const LOG_BUFFER_SUB_DATA_COMMAND*)command.payload;
+				std::cout << "  BufferSubData " << data->target << " " << data->size << " bytes at " << data->offset << std::endl;
+				return;
+			}
+			case LOG_COMMAND_TEX_IMAGE:
+			{
+				const LOG_TEX_IMAGE_COMMAND* image = (const LOG_TEX_IMAGE_COMMAND*)command.payload;
+				std::cout << "  TexSubImage3D level " << image->level << " " << image->width << "x" << image->height << " " << image->size << " bytes" << std::endl;
+				return;
+			}
+			default:
+				break;
+			}
+
+			// the remaining payloads are made of 32 bit fields
+			std::cout << "  " << GLReplayer::GetCommandName(command.command);
+			size_t count = GLReplayer::GetPayloadSize(command.command) / sizeof(uint32_t);
+			for (size_t i = 0; i < count; i++)
+			{
+				std::cout << " " << fields[i];
+			}
+			std::cout << std::endl;
+		}
+	};
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool ParseCommandLine(int argc, char* argv[], STATS_OPTIONS& options);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the tool has been
+ *  launched.  It replays a command log recorded by the
+ *  application into the statistics handler, and prints the
+ *  draw calls, state changes and uploads of its frames.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	STATS_OPTIONS options;
+	if (ParseCommandLine(argc, argv, options) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	GLReplayer replayer;
+	if (replayer.Open(options.logFile) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	if (options.bDump == true)
+	{
+		CommandPrinter printer;
+		replayer.Replay(printer);
+		std::cout << std::endl;
+	}
+
+	CommandStatistics statistics;
+	if (replayer.Replay(statistics) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+	statistics.Report(std::cout);
+
+	if (options.framesFile.empty() == false)
+	{
+		std::ofstream framesFile(options.framesFile, std::ios::trunc);
+		if (!framesFile)
+		{
+			std::cerr << "Could not open frames file: " << options.framesFile << std::endl;
+			return(EXIT_FAILURE);
+		}
+		statistics.ReportFrames(framesFile);
+	}
+
+	return(EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *	ParseCommandLine()
+ *
+ *  This function is used to read the command line options:
+ *
+ *  <log file>            command log to replay
+ *  --frames <file>       write the counters of every frame
+ *                        to a CSV file
+ *  --dump                print every command of the log
+ ***********************************************************/
+bool ParseCommandLine(int argc, char* argv[], STATS_OPTIONS& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* option = argv[i];
+
+		if (strcmp(option, "--dump") == 0)
+		{
+			options.bDump = true;
+		}
+		else if ((strcmp(option, "--frames") == 0) && (i + 1 < argc))
+		{
+			options.framesFile = argv[++i];
+		}
+		else if ((option[0] != '-') && (options.logFile.empty() == true))
+		{
+			options.logFile = option;
+		}
+		else
+		{
+			std::cerr << "Unknown option or missing value: " << option << std::endl;
+			options.logFile.clear();
+			break;
+		}
+	}
+
+	if (options.logFile.empty() == true)
+	{
+		std::cerr << "Usage: " << argv[0] << " <log file> [--frames <file>] [--dump]" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// fragmentShader.glsl
+// ============
+// calculate the lit color of every rendered fragment
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#version 440 core
+
+#define MAX_LIGHTS 16
+
+// the members are ordered so each float fills the std430
+// padding after the vec3 before it
+struct Material
+{
+	vec3 ambientColor;
+	float ambientStrength;
+	vec3 diffuseColor;
+	float shininess;
+	vec3 specularColor;
+};
+
+// the members are ordered so each float fills the std140
+// padding after the vec3 before it
+struct LightSource
+{
+	vec3 position;
+	float focalStrength;
+	vec3 ambientColor;
+	float specularIntensity;
+	vec3 diffuseColor;
+	vec3 specularColor;
+};
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+flat in int fragmentMaterialIndex;
+
+out vec4 outFragmentColor;
+
+uniform bool bUseTexture = false;
+uniform bool bUseLighting = false;
+uniform bool bUseInstancing = false;
+uniform vec4 objectColor = vec4(1.0f);
+// textures are layers of arrays, one array per texture size
+uniform sampler2DArray objectTexture;
+uniform int objectTextureLayer = 0;
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+// index of the material used by non-instanced draw calls
+uniform int materialIndex = 0;
+
+// camera of the current frame, shared with the vertex shader
+layout (std140, binding = 1) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 viewPosition;
+};
+
+// every defined material, selected by index
+layout (std430, binding = 2) readonly buffer MaterialBuffer
+{
+	Material materials[];
+};
+
+// light sources, updated with one buffer upload per frame
+layout (std140, binding = 0) uniform LightBlock
+{
+	int numLights;
+	LightSource lightSources[MAX_LIGHTS];
+};
+
+vec3 CalcLightSource(LightSource light, Material surface, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection);
+
+void main()
+{
+	// instanced draws take the material index from the instance data
+	int surfaceIndex = materialIndex;
+	if (bUseInstancing == true)
+	{
+		surfaceIndex = fragmentMaterialIndex;
+	}
+	Material surface = materials[clamp(surfaceIndex, 0, materials.length() - 1)];
+
+	vec4 baseColor = objectColor;
+	if (bUseTexture == true)
+	{
+		baseColor = texture(objectTexture, vec3(fragmentTextureCoordinate * UVscale, objectTextureLayer));
+	}
+
+	if (bUseLighting == true)
+	{
+		// properties
+		vec3 lightNormal = normalize(fragmentVertexNormal);
+		vec3 viewDirection = normalize(viewPosition - fragmentPosition);
+		vec3 phongResult = vec3(0.0f);
+
+		for (int i = 0; i < min(numLights, MAX_LIGHTS); i++)
+		{
+			phongResult += CalcLightSource(lightSources[i], surface, lightNormal, fragmentPosition, viewDirection);
+		}
+
+		outFragmentColor = vec4(phongResult * baseColor.xyz, baseColor.w);
+	}
+	else
+	{
+		outFragmentColor = baseColor;
+	}
+}
+
+// calculates the color when using a light source
+vec3 CalcLightSource(LightSource light, Material surface, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection)
+{
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+
+	//**Calculate Ambient lighting**
+	ambient = light.ambientColor * surface.ambientColor * surface.ambientStrength;
+
+	//**Calculate Diffuse lighting**
+	vec3 lightDirection = normalize(light.position - vertexPosition); // Calculate distance (light direction) between light source and fragments/pixels on cube
+	float impact = max(dot(lightNormal, lightDirection), 0.0);// Calculate diffuse impact by generating dot product of normal and light
+	diffuse = impact * light.diffuseColor * surface.diffuseColor; // Generate diffuse light color
+
+	//**Calculate Specular lighting**
+	vec3 reflectDir = reflect(-lightDirection, lightNormal);// Calculate reflection vector
+	// Calculate specular component
+	float specularComponent = pow(max(dot(viewDirection, reflectDir), 0.0), light.focalStrength);
+	specular = light.specularIntensity * specularComponent * light.specularColor * surface.specularColor;
+
+	return(ambient + diffuse + specular);
+}
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// vertexShader.glsl
+// ============
+// transform the mesh vertices into the 2D view
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#version 440 core
+
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+
+// per-instance data used by instanced draw calls - the model
+// matrix takes the four locations from 3 to 6
+layout (location = 3) in mat4 instanceModel;
+layout (location = 7) in int instanceMaterial;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+flat out int fragmentMaterialIndex;
+
+uniform bool bUseInstancing = false;
+uniform mat4 model;
+
+// camera of the current frame, updated once per frame
+layout (std140, binding = 1) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 viewPosition;
+};
+
+void main()
+{
+	// instanced draws take the model matrix from the instance data
+	mat4 modelMatrix = model;
+	if (bUseInstancing == true)
+	{
+		modelMatrix = instanceModel;
+	}
+
+	// vertex position in world space for the lighting calculations
+	fragmentPosition = vec3(modelMatrix * vec4(inVertexPosition, 1.0f));
+
+	// transforms vertices into clip coordinates
+	gl_Position = projection * view * vec4(fragmentPosition, 1.0f);
+
+	// get normal vectors in world space only and exclude normal translation properties
+	fragmentVertexNormal = mat3(transpose(inverse(modelMatrix))) * inVertexNormal;
+	fragmentTextureCoordinate = inTextureCoordinate;
+	fragmentMaterialIndex = instanceMaterial;
+}
@@ -0,0 +1,458 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumes.cpp
+// ============
+// bounding boxes, view frustum tests and a bounding volume hierarchy
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BoundingVolumes.h"
+
+#include <algorithm>
+
+// declaration of the global variables and defines
+namespace
+{
+	// largest number of items kept in a leaf node
+	const int BVH_LEAF_SIZE = 4;
+	// fewest items worth splitting a query over the threads
+	const int PARALLEL_QUERY_ITEMS = 4096;
+	// subtrees tested by each thread of a split query, so
+	// threads finishing early can steal the remaining ones
+	const int QUERY_SUBTREES_PER_THREAD = 4;
+
+	/***********************************************************
+	 *  MergeBoxes()
+	 *
+	 *  Return the box around both passed in boxes.
+	 ***********************************************************/
+	BOUNDING_BOX MergeBoxes(const BOUNDING_BOX& a, const BOUNDING_BOX& b)
+	{
+		BOUNDING_BOX box;
+		box.min = glm::min(a.min, b.min);
+		box.max = glm::max(a.max, b.max);
+		return(box);
+	}
+
+	/***********************************************************
+	 *  SameBox()
+	 *
+	 *  Return true if the two boxes are identical.
+	 ***********************************************************/
+	bool SameBox(const BOUNDING_BOX& a, const BOUNDING_BOX& b)
+	{
+		return((a.min == b.min) && (a.max == b.max));
+	}
+}
+
+/***********************************************************
+ *  Frustum()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+Frustum::Frustum()
+{
+	for (int i = 0; i < 6; i++)
+	{
+		m_planes[i] = glm::vec4(0.0f);
+	}
+}
+
+/***********************************************************
+ *  Extract()
+ *
+ *  This method is used for extracting the six clipping
+ *  planes from the rows of the combined projection and view
+ *  matrix.  The planes are normalized so that the distance
+ *  of a point to a plane can be compared between planes.
+ ***********************************************************/
+void Frustum::Extract(const glm::mat4& viewProjection)
+{
+	// glm matrices are column major, so row i is m[0..3][i]
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++)
+	{
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	m_planes[0] = rows[3] + rows[0];	// left
+	m_planes[1] = rows[3] - rows[0];	// right
+	m_planes[2] = rows[3] + rows[1];	// bottom
+	m_planes[3] = rows[3] - rows[1];	// top
+	m_planes[4] = rows[3] + rows[2];	// near
+	m_planes[5] = rows[3] - rows[2];	// far
+
+	for (int i = 0; i < 6; i++)
+	{
+		float length = glm::length(glm::vec3(m_planes[i]));
+		if (length > 0.0f)
+		{
+			m_planes[i] /= length;
+		}
+	}
+}
+
+/***********************************************************
+ *  TestBox()
+ *
+ *  This method is used for testing a world space box against
+ *  the planes.  For each plane, the box corner farthest
+ *  along the plane normal decides whether the box is
+ *  outside, and the nearest corner whether it crosses it.
+ ***********************************************************/
+FRUSTUM_RESULT Frustum::TestBox(const BOUNDING_BOX& box) const
+{
+	FRUSTUM_RESULT result = FRUSTUM_INSIDE;
+
+	for (int i = 0; i < 6; i++)
+	{
+		glm::vec3 normal = glm::vec3(m_planes[i]);
+		glm::vec3 farCorner = glm::vec3(
+			(normal.x >= 0.0f) ? box.max.x : box.min.x,
+			(normal.y >= 0.0f) ? box.max.y : box.min.y,
+			(normal.z >= 0.0f) ? box.max.z : box.min.z);
+		glm::vec3 nearCorner = glm::vec3(
+			(normal.x >= 0.0f) ? box.min.x : box.max.x,
+			(normal.y >= 0.0f) ? box.min.y : box.max.y,
+			(normal.z >= 0.0f) ? box.min.z : box.max.z);
+
+		if (glm::dot(normal, farCorner) + m_planes[i].w < 0.0f)
+		{
+			return(FRUSTUM_OUTSIDE);
+		}
+		if (glm::dot(normal, nearCorner) + m_planes[i].w < 0.0f)
+		{
+			result = FRUSTUM_INTERSECTING;
+		}
+	}
+
+	return(result);
+}
+
+/***********************************************************
+ *  BoundingVolumeHierarchy()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+{
+}
+
+/***********************************************************
+ *  ~BoundingVolumeHierarchy()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+	m_nodes.clear();
+}
+
+/***********************************************************
+ *  TransformBox()
+ *
+ *  This method is used for getting the world space box of a
+ *  local space box.  The center is transformed as a point
+ *  and the half size by the absolute rotation and scale, so
+ *  the corners never need to be transformed one by one.
+ ***********************************************************/
+BOUNDING_BOX BoundingVolumeHierarchy::TransformBox(const BOUNDING_BOX& box, const glm::mat4& transform)
+{
+	glm::vec3 center = (box.min + box.max) * 0.5f;
+	glm::vec3 halfSize = (box.max - box.min) * 0.5f;
+
+	glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+	glm::vec3 worldHalfSize =
+		glm::abs(glm::vec3(transform[0])) * halfSize.x +
+		glm::abs(glm::vec3(transform[1])) * halfSize.y +
+		glm::abs(glm::vec3(transform[2])) * halfSize.z;
+
+	BOUNDING_BOX worldBox;
+	worldBox.min = worldCenter - worldHalfSize;
+	worldBox.max = worldCenter + worldHalfSize;
+
+	return(worldBox);
+}
+
+/***********************************************************
+ *  ComputeRangeBox()
+ *
+ *  This method is used for getting the box around the items
+ *  in a range of the item order.
+ ***********************************************************/
+BOUNDING_BOX BoundingVolumeHierarchy::ComputeRangeBox(int first, int count) const
+{
+	BOUNDING_BOX box = m_itemBoxes[m_itemOrder[first]];
+	for (int i = first + 1; i < first + count; i++)
+	{
+		box = MergeBoxes(box, m_itemBoxes[m_itemOrder[i]]);
+	}
+
+	return(box);
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the tree over the passed
+ *  in item boxes, replacing any previous tree.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Build(const std::vector<BOUNDING_BOX>& itemBoxes)
+{
+	m_itemBoxes = itemBoxes;
+	m_itemOrder.resize(itemBoxes.size());
+	m_itemLeaves.assign(itemBoxes.size(), -1);
+	m_nodes.clear();
+	m_dirtyLeaves.clear();
+
+	for (size_t i = 0; i < m_itemOrder.size(); i++)
+	{
+		m_itemOrder[i] = (int)i;
+	}
+
+	if (m_itemBoxes.size() > 0)
+	{
+		m_nodes.reserve(m_itemBoxes.size() * 2);
+		BuildNode(-1, 0, (int)m_itemBoxes.size());
+	}
+}
+
+/***********************************************************
+ *  BuildNode()
+ *
+ *  This method is used for creating the node for a range of
+ *  items.  Ranges larger than a leaf are split at the median
+ *  item center along the longest axis of the centers.
+ ***********************************************************/
+int BoundingVolumeHierarchy::BuildNode(int parent, int first, int count)
+{
+	int nodeIndex = (int)m_nodes.size();
+
+	BVH_NODE node;
+	node.box = ComputeRangeBox(first, count);
+	node.parent = parent;
+	node.left = -1;
+	node.right = -1;
+	node.first = first;
+	node.count = count;
+	m_nodes.push_back(node);
+
+	if (count <= BVH_LEAF_SIZE)
+	{
+		for (int i = first; i < first + count; i++)
+		{
+			m_itemLeaves[m_itemOrder[i]] = nodeIndex;
+		}
+		return(nodeIndex);
+	}
+
+	// find the longest axis of the item centers
+	glm::vec3 centerMin = glm::vec3(1e30f);
+	glm::vec3 centerMax = glm::vec3(-1e30f);
+	for (int i = first; i < first + count; i++)
+	{
+		const BOUNDING_BOX& box = m_itemBoxes[m_itemOrder[i]];
+		glm::vec3 center = (box.min + box.max) * 0.5f;
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+	glm::vec3 extent = centerMax - centerMin;
+	int axis = 0;
+	if (extent.y > extent[axis])
+	{
+		axis = 1;
+	}
+	if (extent.z > extent[axis])
+	{
+		axis = 2;
+	}
+
+	int half = count / 2;
+	std::nth_element(
+		m_itemOrder.begin() + first,
+		m_itemOrder.begin() + first + half,
+		m_itemOrder.begin() + first + count,
+		[this, axis](int a, int b)
+		{
+			return((m_itemBoxes[a].min[axis] + m_itemBoxes[a].max[axis]) <
+				(m_itemBoxes[b].min[axis] + m_itemBoxes[b].max[axis]));
+		});
+
+	int left = BuildNode(nodeIndex, first, half);
+	int right = BuildNode(nodeIndex, first + half, count - half);
+	m_nodes[nodeIndex].left = left;
+	m_nodes[nodeIndex].right = right;
+
+	return(nodeIndex);
+}
+
+/***********************************************************
+ *  SetItemBox()
+ *
+ *  This method is used for changing the box of a moved item.
+ *  The nodes above it are refit by the next Refit() call.
+ ***********************************************************/
+void BoundingVolumeHierarchy::SetItemBox(int item, const BOUNDING_BOX& box)
+{
+	if ((item < 0) || (item >= (int)m_itemBoxes.size()))
+	{
+		return;
+	}
+
+	if (SameBox(m_itemBoxes[item], box) == true)
+	{
+		return;
+	}
+
+	m_itemBoxes[item] = box;
+	m_dirtyLeaves.push_back(m_itemLeaves[item]);
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used for recomputing the boxes of the
+ *  leaves holding changed items, and of their parents up
+ *  to the first node whose box does not change.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Refit()
+{
+	for (size_t i = 0; i < m_dirtyLeaves.size(); i++)
+	{
+		int nodeIndex = m_dirtyLeaves[i];
+		BVH_NODE& leaf = m_nodes[nodeIndex];
+		leaf.box = ComputeRangeBox(leaf.first, leaf.count);
+
+		int parent = leaf.parent;
+		while (parent >= 0)
+		{
+			BVH_NODE& node = m_nodes[parent];
+			BOUNDING_BOX box = MergeBoxes(m_nodes[node.left].box, m_nodes[node.right].box);
+			if (SameBox(box, node.box) == true)
+			{
+				break;
+			}
+			node.box = box;
+			parent = node.parent;
+		}
+	}
+	m_dirtyLeaves.clear();
+}
+
+/***********************************************************
+ *  Query()
+ *
+ *  This method is used for appending the items that are at
+ *  least partly inside the frustum.  Large trees are split
+ *  into subtrees below the root, which are tested on the
+ *  threads of the job system into separate lists and then
+ *  appended in subtree order, so the result does not depend
+ *  on which thread tested which subtree.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Query(const Frustum& frustum, std::vector<int>& visibleItems, JobSystem* pJobSystem) const
+{
+	if (m_nodes.size() == 0)
+	{
+		return;
+	}
+
+	if ((NULL == pJobSystem) ||
+		(pJobSystem->GetThreadCount() == 1) ||
+		((int)m_itemBoxes.size() < PARALLEL_QUERY_ITEMS))
+	{
+		QueryNode(frustum, 0, visibleItems);
+		return;
+	}
+
+	// replace the inner nodes by their children, one level at a
+	// time, until there are enough subtrees - the frustum tests
+	// skipped for the replaced nodes are repeated by the children,
+	// whose boxes they contain
+	size_t subtreeCount = (size_t)pJobSystem->GetThreadCount() * QUERY_SUBTREES_PER_THREAD;
+	std::vector<int> subtrees(1, 0);
+	bool bSplit = true;
+	while ((subtrees.size() < subtreeCount) && (bSplit == true))
+	{
+		std::vector<int> children;
+		bSplit = false;
+		for (size_t i = 0; i < subtrees.size(); i++)
+		{
+			const BVH_NODE& node = m_nodes[subtrees[i]];
+			if (node.left < 0)
+			{
+				children.push_back(subtrees[i]);
+				continue;
+			}
+			children.push_back(node.left);
+			children.push_back(node.right);
+			bSplit = true;
+		}
+		subtrees.swap(children);
+	}
+
+	std::vector<std::vector<int>> subtreeItems(subtrees.size());
+	pJobSystem->ParallelFor((int)subtrees.size(), 1,
+		[this, &frustum, &subtrees, &subtreeItems](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				QueryNode(frustum, subtrees[i], subtreeItems[i]);
+			}
+		});
+
+	for (size_t i = 0; i < subtreeItems.size(); i++)
+	{
+		visibleItems.insert(visibleItems.end(), subtreeItems[i].begin(), subtreeItems[i].end());
+	}
+}
+
+/***********************************************************
+ *  QueryNode()
+ *
+ *  This method is used for appending the items of a subtree
+ *  that are at least partly inside the frustum.  Subtrees
+ *  completely inside are appended without testing their
+ *  children.
+ ***********************************************************/
+void BoundingVolumeHierarchy::QueryNode(const Frustum& frustum, int rootNode, std::vector<int>& visibleItems) const
+{
+	int stack[64];
+	int stackSize = 0;
+	stack[stackSize++] = rootNode;
+
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+
+		FRUSTUM_RESULT result = frustum.TestBox(node.box);
+		if (result == FRUSTUM_OUTSIDE)
+		{
+			continue;
+		}
+
+		if (result == FRUSTUM_INSIDE)
+		{
+			visibleItems.insert(visibleItems.end(),
+				m_itemOrder.begin() + node.first,
+				m_itemOrder.begin() + node.first + node.count);
+			continue;
+		}
+
+		// the items of a leaf crossing a plane are tested one by one
+		if (node.left < 0)
+		{
+			for (int i = node.first; i < node.first + node.count; i++)
+			{
+				if (frustum.TestBox(m_itemBoxes[m_itemOrder[i]]) != FRUSTUM_OUTSIDE)
+				{
+					visibleItems.push_back(m_itemOrder[i]);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.left;
+		stack[stackSize++] = node.right;
+	}
+}
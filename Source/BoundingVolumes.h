@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumes.h
+// ============
+// bounding boxes, view frustum tests and a bounding volume hierarchy
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "JobSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// axis aligned bounding box
+struct BOUNDING_BOX
+{
+	glm::vec3 min;
+	glm::vec3 max;
+};
+
+// result of testing a bounding volume against the view frustum
+enum FRUSTUM_RESULT
+{
+	FRUSTUM_OUTSIDE = 0,
+	FRUSTUM_INTERSECTING,
+	FRUSTUM_INSIDE
+};
+
+/***********************************************************
+ *  Frustum
+ *
+ *  This class holds the six clipping planes of a camera,
+ *  extracted from its combined projection and view matrix,
+ *  and tests bounding boxes against them.
+ ***********************************************************/
+class Frustum
+{
+public:
+	// constructor
+	Frustum();
+
+	// extract the planes from a projection * view matrix
+	void Extract(const glm::mat4& viewProjection);
+	// test a world space box against the planes
+	FRUSTUM_RESULT TestBox(const BOUNDING_BOX& box) const;
+
+private:
+	// plane normals in xyz and distances in w, pointing inwards
+	glm::vec4 m_planes[6];
+};
+
+/***********************************************************
+ *  BoundingVolumeHierarchy
+ *
+ *  This class keeps a binary tree of bounding boxes over a
+ *  set of items, such as the draw items of a render queue.
+ *  Each node covers a contiguous range of the reordered
+ *  items, so a node found completely inside the frustum
+ *  adds its whole range without testing its children.
+ *  Moved items are refit in place by walking up from their
+ *  leaf, without rebuilding the tree.
+ ***********************************************************/
+class BoundingVolumeHierarchy
+{
+public:
+	// constructor
+	BoundingVolumeHierarchy();
+	// destructor
+	~BoundingVolumeHierarchy();
+
+	// build the tree over the passed in item boxes
+	void Build(const std::vector<BOUNDING_BOX>& itemBoxes);
+	// change the box of an item, to be refit by Refit()
+	void SetItemBox(int item, const BOUNDING_BOX& box);
+	// grow the boxes of the nodes above the changed items
+	void Refit();
+	// append the items that are at least partly inside the frustum,
+	// testing the subtrees on the threads of the job system when
+	// one is passed in
+	void Query(const Frustum& frustum, std::vector<int>& visibleItems, JobSystem* pJobSystem = NULL) const;
+
+	// number of items the tree was built over
+	int GetItemCount() const { return((int)m_itemBoxes.size()); }
+	// current box of an item
+	const BOUNDING_BOX& GetItemBox(int item) const { return(m_itemBoxes[item]); }
+
+	// box of a local space box after a transformation
+	static BOUNDING_BOX TransformBox(const BOUNDING_BOX& box, const glm::mat4& transform);
+
+private:
+	struct BVH_NODE
+	{
+		BOUNDING_BOX box;
+		int parent;
+		int left;
+		int right;
+		int first;
+		int count;
+	};
+
+	// tree nodes, the root first
+	std::vector<BVH_NODE> m_nodes;
+	// boxes of the items, indexed by item
+	std::vector<BOUNDING_BOX> m_itemBoxes;
+	// items in tree order, each node covering a range
+	std::vector<int> m_itemOrder;
+	// leaf node of each item
+	std::vector<int> m_itemLeaves;
+	// leaves holding items changed since the last refit
+	std::vector<int> m_dirtyLeaves;
+
+	// recursively split a range of items into nodes
+	int BuildNode(int parent, int first, int count);
+	// box around the items in a range of the item order
+	BOUNDING_BOX ComputeRangeBox(int first, int count) const;
+	// append the items of a subtree that are at least partly
+	// inside the frustum
+	void QueryNode(const Frustum& frustum, int rootNode, std::vector<int>& visibleItems) const;
+};
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerapath.cpp
+// ============
+// camera positions and directions to be followed over a number of frames
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/***********************************************************
+ *  CameraPath()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CameraPath::CameraPath()
+{
+}
+
+/***********************************************************
+ *  ~CameraPath()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+CameraPath::~CameraPath()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading the keys of a camera
+ *  path file.  The first line that cannot be read is
+ *  reported and no keys are kept.
+ ***********************************************************/
+bool CameraPath::Load(const std::string& filename)
+{
+	Clear();
+
+	std::ifstream file(filename);
+	if (!file)
+	{
+		std::cout << "Could not open camera path:" << filename << std::endl;
+		return(false);
+	}
+
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		// ignore comments and blank lines
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+		{
+			continue;
+		}
+
+		std::istringstream values(line);
+		CAMERA_KEY key;
+		std::string extra;
+		if (!(values >> key.position.x >> key.position.y >> key.position.z >>
+			key.front.x >> key.front.y >> key.front.z) || (values >> extra))
+		{
+			std::cout << "Camera path " << filename << " line " << lineNumber << ": expected position and front" << std::endl;
+			Clear();
+			return(false);
+		}
+
+		AddKey(key.position, key.front);
+	}
+
+	if (IsEmpty() == true)
+	{
+		std::cout << "Camera path " << filename << " has no keys" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddKey()
+ *
+ *  This method is used for adding a key pose at the end of
+ *  the path.
+ ***********************************************************/
+void CameraPath::AddKey(const glm::vec3& position, const glm::vec3& front)
+{
+	CAMERA_KEY key;
+	key.position = position;
+	key.front = glm::normalize(front);
+	m_keys.push_back(key);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the keys.
+ ***********************************************************/
+void CameraPath::Clear()
+{
+	m_keys.clear();
+}
+
+/***********************************************************
+ *  Sample()
+ *
+ *  This method is used for getting the camera pose at a
+ *  point of the path.  The position is blended linearly
+ *  between the two nearest keys, and so is the direction,
+ *  which is then normalized again.
+ ***********************************************************/
+void CameraPath::Sample(float pathPosition, glm::vec3& position, glm::vec3& front) const
+{
+	if (IsEmpty() == true)
+	{
+		return;
+	}
+	if (m_keys.size() == 1)
+	{
+		position = m_keys[0].position;
+		front = m_keys[0].front;
+		return;
+	}
+
+	float keyPosition = std::min(std::max(pathPosition, 0.0f), 1.0f) * (float)(m_keys.size() - 1);
+	int key = std::min((int)keyPosition, (int)m_keys.size() - 2);
+	float blend = keyPosition - (float)key;
+
+	const CAMERA_KEY& from = m_keys[key];
+	const CAMERA_KEY& to = m_keys[key + 1];
+	position = from.position + (to.position - from.position) * blend;
+	front = glm::normalize(from.front + (to.front - from.front) * blend);
+}
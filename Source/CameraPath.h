@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerapath.h
+// ============
+// camera positions and directions to be followed over a number of frames
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  CameraPath
+ *
+ *  This class holds the key poses of a camera path, each a
+ *  camera position and the direction the camera faces, and
+ *  blends between them along the path.  The keys are spread
+ *  evenly over the length of the path.
+ *
+ *  Camera path files have one key per line, with # starting
+ *  a comment:
+ *
+ *  <position x y z> <front x y z>
+ ***********************************************************/
+class CameraPath
+{
+public:
+	// constructor
+	CameraPath();
+	// destructor
+	~CameraPath();
+
+	struct CAMERA_KEY
+	{
+		glm::vec3 position;
+		glm::vec3 front;
+	};
+
+	// read the keys of a camera path file
+	bool Load(const std::string& filename);
+	// add a key at the end of the path
+	void AddKey(const glm::vec3& position, const glm::vec3& front);
+	// remove all the keys
+	void Clear();
+
+	// true when the path has no keys
+	bool IsEmpty() const { return(m_keys.empty()); }
+	// number of keys
+	int GetKeyCount() const { return((int)m_keys.size()); }
+
+	// camera pose at a point of the path, from 0 at the first
+	// key to 1 at the last key
+	void Sample(float pathPosition, glm::vec3& position, glm::vec3& front) const;
+
+private:
+	// key poses in path order
+	std::vector<CAMERA_KEY> m_keys;
+};
@@ -0,0 +1,536 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// time the phases of each frame on the CPU and the GPU
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// name of the scope covering each whole frame
+	const char* const FRAME_SCOPE_NAME = "Frame";
+
+	// bucket of the histograms counting a time in milliseconds
+	int HistogramBucket(float milliseconds)
+	{
+		float microseconds = milliseconds * 1000.0f;
+		if (microseconds < 1.0f)
+		{
+			return(0);
+		}
+		int bucket = (int)std::floor(std::log2(microseconds)) + 1;
+		return(std::min(bucket, FrameProfiler::HISTOGRAM_BUCKETS - 1));
+	}
+
+	// write a string as a JSON string value
+	void WriteJsonString(std::ostream& output, const std::string& value)
+	{
+		output << '"';
+		for (size_t i = 0; i < value.size(); i++)
+		{
+			if ((value[i] == '"') || (value[i] == '\\'))
+			{
+				output << '\\';
+			}
+			output << value[i];
+		}
+		output << '"';
+	}
+}
+
+/***********************************************************
+ *  FrameProfiler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameProfiler::FrameProfiler()
+{
+	for (int i = 0; i < QUERY_LATENCY; i++)
+	{
+		m_queryFrames[i].clockOffset = 0;
+		m_queryFrames[i].bPending = false;
+	}
+	m_queryFrame = 0;
+	m_bStarted = false;
+	m_bGpuTimers = false;
+	m_startTime = std::chrono::steady_clock::now();
+	m_maxTraceEvents = 0;
+	m_frameScope = RegisterScope(FRAME_SCOPE_NAME);
+}
+
+/***********************************************************
+ *  ~FrameProfiler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameProfiler::~FrameProfiler()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for creating the timestamp queries
+ *  of every frame in flight, when GPU timing is wanted.
+ ***********************************************************/
+void FrameProfiler::Start(bool bGpuTimers)
+{
+	if (m_bStarted == true)
+	{
+		return;
+	}
+
+	m_bGpuTimers = bGpuTimers;
+	if (m_bGpuTimers == true)
+	{
+		for (int i = 0; i < QUERY_LATENCY; i++)
+		{
+			// one query for the start and one for the end of a scope
+			m_queryFrames[i].queries.resize(MAX_GPU_SCOPES * 2);
+			glGenQueries(MAX_GPU_SCOPES * 2, m_queryFrames[i].queries.data());
+			m_queryFrames[i].scopes.reserve(MAX_GPU_SCOPES);
+			m_queryFrames[i].bPending = false;
+		}
+	}
+	m_queryFrame = 0;
+	m_bStarted = true;
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for reading the queries of the frames
+ *  still in flight, so the statistics and trace include
+ *  them, and for freeing the queries.
+ ***********************************************************/
+void FrameProfiler::Stop()
+{
+	if (m_bStarted == false)
+	{
+		return;
+	}
+
+	if (m_bGpuTimers == true)
+	{
+		for (int i = 0; i < QUERY_LATENCY; i++)
+		{
+			QUERY_FRAME& frame = m_queryFrames[(m_queryFrame + i) % QUERY_LATENCY];
+			if (frame.bPending == true)
+			{
+				ResolveQueries(frame);
+			}
+			glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+			frame.queries.clear();
+			frame.scopes.clear();
+		}
+	}
+
+	m_bGpuTimers = false;
+	m_bStarted = false;
+}
+
+/***********************************************************
+ *  RegisterScope()
+ *
+ *  This method is used for adding a scope name to the
+ *  registry and getting the ID it is timed with.
+ ***********************************************************/
+int FrameProfiler::RegisterScope(const char* name)
+{
+	for (size_t i = 0; i < m_scopes.size(); i++)
+	{
+		if (m_scopes[i].name == name)
+		{
+			return((int)i);
+		}
+	}
+
+	SCOPE scope;
+	scope.name = name;
+	scope.cpu.samples.resize(HISTORY_FRAMES);
+	scope.gpu.samples.resize(HISTORY_FRAMES);
+	scope.cpuFrameTime = 0.0;
+	scope.bEnteredThisFrame = false;
+	m_scopes.push_back(scope);
+
+	return((int)m_scopes.size() - 1);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting a frame.  The queries
+ *  issued QUERY_LATENCY frames ago are read first, which by
+ *  now have almost always finished on the GPU, and the
+ *  difference between the GPU and CPU clocks is sampled to
+ *  line the GPU scopes up with the CPU ones in the trace.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	if (m_bGpuTimers == true)
+	{
+		QUERY_FRAME& frame = m_queryFrames[m_queryFrame];
+		if (frame.bPending == true)
+		{
+			ResolveQueries(frame);
+		}
+
+		GLint64 gpuTime = 0;
+		glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+		frame.clockOffset = gpuTime - Now();
+	}
+
+	for (size_t i = 0; i < m_scopes.size(); i++)
+	{
+		m_scopes[i].cpuFrameTime = 0.0;
+		m_scopes[i].bEnteredThisFrame = false;
+	}
+
+	BeginScope(m_frameScope, true);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for ending a frame and adding the
+ *  time spent in every scope entered during the frame to
+ *  its rolling window.
+ ***********************************************************/
+void FrameProfiler::EndFrame()
+{
+	// scopes left open end with the frame
+	while (m_openScopes.empty() == false)
+	{
+		EndScope();
+	}
+
+	for (size_t i = 0; i < m_scopes.size(); i++)
+	{
+		if (m_scopes[i].bEnteredThisFrame == true)
+		{
+			m_scopes[i].cpu.Add((float)(m_scopes[i].cpuFrameTime / 1000000.0));
+		}
+	}
+
+	if (m_bGpuTimers == true)
+	{
+		m_queryFrames[m_queryFrame].bPending = (m_queryFrames[m_queryFrame].scopes.empty() == false);
+		m_queryFrame = (m_queryFrame + 1) % QUERY_LATENCY;
+	}
+}
+
+/***********************************************************
+ *  BeginScope()
+ *
+ *  This method is used for starting the timing of a scope.
+ *  A timestamp query is issued for GPU scopes until the
+ *  frame runs out of queries.
+ ***********************************************************/
+void FrameProfiler::BeginScope(int scope, bool bGpu)
+{
+	OPEN_SCOPE open;
+	open.scope = scope;
+	open.query = -1;
+
+	if ((bGpu == true) && (m_bGpuTimers == true))
+	{
+		QUERY_FRAME& frame = m_queryFrames[m_queryFrame];
+		if ((int)frame.scopes.size() < MAX_GPU_SCOPES)
+		{
+			GPU_SCOPE gpuScope;
+			gpuScope.scope = scope;
+			gpuScope.query = (int)frame.scopes.size() * 2;
+			frame.scopes.push_back(gpuScope);
+
+			glQueryCounter(frame.queries[gpuScope.query], GL_TIMESTAMP);
+			open.query = gpuScope.query;
+		}
+	}
+
+	open.cpuStart = Now();
+	m_openScopes.push_back(open);
+}
+
+/***********************************************************
+ *  EndScope()
+ *
+ *  This method is used for ending the timing of the
+ *  innermost open scope.
+ ***********************************************************/
+void FrameProfiler::EndScope()
+{
+	if (m_openScopes.empty() == true)
+	{
+		return;
+	}
+
+	int64_t end = Now();
+	OPEN_SCOPE open = m_openScopes.back();
+	m_openScopes.pop_back();
+
+	if (open.query >= 0)
+	{
+		glQueryCounter(m_queryFrames[m_queryFrame].queries[open.query + 1], GL_TIMESTAMP);
+	}
+
+	SCOPE& scope = m_scopes[open.scope];
+	scope.cpuFrameTime += (double)(end - open.cpuStart);
+	scope.bEnteredThisFrame = true;
+
+	AddTraceEvent(open.scope, false, open.cpuStart, end);
+}
+
+/***********************************************************
+ *  ResolveQueries()
+ *
+ *  This method is used for reading the timestamps of the
+ *  GPU scopes of a frame and adding the time spent in every
+ *  scope to its rolling window.
+ ***********************************************************/
+void FrameProfiler::ResolveQueries(QUERY_FRAME& frame)
+{
+	std::vector<double> frameTimes(m_scopes.size(), -1.0);
+
+	for (size_t i = 0; i < frame.scopes.size(); i++)
+	{
+		const GPU_SCOPE& gpuScope = frame.scopes[i];
+		GLuint64 begin = 0;
+		GLuint64 end = 0;
+		glGetQueryObjectui64v(frame.queries[gpuScope.query], GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(frame.queries[gpuScope.query + 1], GL_QUERY_RESULT, &end);
+
+		double duration = (end > begin) ? (double)(end - begin) : 0.0;
+		frameTimes[gpuScope.scope] = std::max(frameTimes[gpuScope.scope], 0.0) + duration;
+
+		AddTraceEvent(gpuScope.scope, true, (int64_t)begin - frame.clockOffset, (int64_t)end - frame.clockOffset);
+	}
+
+	for (size_t i = 0; i < frameTimes.size(); i++)
+	{
+		if (frameTimes[i] >= 0.0)
+		{
+			m_scopes[i].gpu.Add((float)(frameTimes[i] / 1000000.0));
+		}
+	}
+
+	frame.scopes.clear();
+	frame.bPending = false;
+}
+
+/***********************************************************
+ *  StartTrace()
+ *
+ *  This method is used for capturing the timed scopes for a
+ *  trace file.  Capturing stops once the passed in number
+ *  of events has been reached.
+ ***********************************************************/
+void FrameProfiler::StartTrace(size_t maxEvents)
+{
+	m_traceEvents.clear();
+	m_traceEvents.reserve(std::min(maxEvents, (size_t)65536));
+	m_maxTraceEvents = maxEvents;
+}
+
+/***********************************************************
+ *  AddTraceEvent()
+ *
+ *  This method is used for keeping a timed scope for the
+ *  trace while capturing.
+ ***********************************************************/
+void FrameProfiler::AddTraceEvent(int scope, bool bGpu, int64_t start, int64_t end)
+{
+	if (m_traceEvents.size() >= m_maxTraceEvents)
+	{
+		return;
+	}
+
+	TRACE_EVENT event;
+	event.scope = scope;
+	event.bGpu = bGpu;
+	event.start = start;
+	event.duration = std::max(end - start, (int64_t)0);
+	m_traceEvents.push_back(event);
+}
+
+/***********************************************************
+ *  WriteTrace()
+ *
+ *  This method is used for writing the captured scopes in
+ *  the Chrome trace event format, with the CPU and the GPU
+ *  scopes on two separate tracks.
+ ***********************************************************/
+bool FrameProfiler::WriteTrace(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "Could not write trace:" << filename << std::endl;
+		return(false);
+	}
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+	for (size_t i = 0; i < m_traceEvents.size(); i++)
+	{
+		const TRACE_EVENT& event = m_traceEvents[i];
+		file << ",\n{\"name\":";
+		WriteJsonString(file, m_scopes[event.scope].name);
+		file << ",\"cat\":\"" << ((event.bGpu == true) ? "gpu" : "cpu") << "\",\"ph\":\"X\"";
+		file << ",\"ts\":" << (event.start / 1000.0) << ",\"dur\":" << (event.duration / 1000.0);
+		file << ",\"pid\":1,\"tid\":" << ((event.bGpu == true) ? 2 : 1) << "}";
+	}
+	file << "\n]}\n";
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  GetStats()
+ *
+ *  This method is used for getting the statistics of the
+ *  time spent in a scope per frame over the rolling window.
+ *  It returns false when the scope has no samples.
+ ***********************************************************/
+bool FrameProfiler::GetStats(int scope, bool bGpu, SCOPE_STATS& stats) const
+{
+	const HISTORY& history = (bGpu == true) ? m_scopes[scope].gpu : m_scopes[scope].cpu;
+	if (history.count == 0)
+	{
+		return(false);
+	}
+
+	std::vector<float> sorted(history.samples.begin(), history.samples.begin() + history.count);
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0.0;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		total += sorted[i];
+	}
+
+	stats.frames = history.count;
+	stats.mean = total / history.count;
+	stats.min = sorted.front();
+	stats.max = sorted.back();
+	stats.p50 = sorted[(sorted.size() - 1) * 50 / 100];
+	stats.p95 = sorted[(sorted.size() - 1) * 95 / 100];
+	stats.p99 = sorted[(sorted.size() - 1) * 99 / 100];
+	std::copy(history.histogram, history.histogram + HISTOGRAM_BUCKETS, stats.histogram);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Report()
+ *
+ *  This method is used for printing the CPU and GPU
+ *  statistics of every scope, followed by the histogram of
+ *  the CPU frame times.
+ ***********************************************************/
+void FrameProfiler::Report(std::ostream& output) const
+{
+	std::ios::fmtflags flags = output.flags();
+	std::streamsize precision = output.precision();
+
+	output << std::fixed << std::setprecision(3);
+	output << "Frame profile (milliseconds per frame)" << std::endl;
+	output << std::left << std::setw(28) << "scope" << std::right <<
+		std::setw(10) << "cpu mean" << std::setw(10) << "p95" << std::setw(10) << "max" <<
+		std::setw(10) << "gpu mean" << std::setw(10) << "p95" << std::setw(10) << "max" << std::endl;
+
+	for (size_t i = 0; i < m_scopes.size(); i++)
+	{
+		SCOPE_STATS cpu;
+		SCOPE_STATS gpu;
+		bool bCpu = GetStats((int)i, false, cpu);
+		bool bGpu = GetStats((int)i, true, gpu);
+		if ((bCpu == false) && (bGpu == false))
+		{
+			continue;
+		}
+
+		output << std::left << std::setw(28) << m_scopes[i].name << std::right;
+		if (bCpu == true)
+		{
+			output << std::setw(10) << cpu.mean << std::setw(10) << cpu.p95 << std::setw(10) << cpu.max;
+		}
+		else
+		{
+			output << std::setw(30) << "-";
+		}
+		if (bGpu == true)
+		{
+			output << std::setw(10) << gpu.mean << std::setw(10) << gpu.p95 << std::setw(10) << gpu.max;
+		}
+		output << std::endl;
+	}
+
+	SCOPE_STATS frame;
+	if (GetStats(m_frameScope, false, frame) == true)
+	{
+		output << "Frame time histogram over " << frame.frames << " frames" << std::endl;
+		for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+		{
+			if (frame.histogram[i] == 0)
+			{
+				continue;
+			}
+			output << "  " << ((i == HISTOGRAM_BUCKETS - 1) ? ">= " : "< ") <<
+				std::setw(9) << (std::ldexp(1.0, (i == HISTOGRAM_BUCKETS - 1) ? i - 1 : i) / 1000.0) << " ms: " <<
+				std::string((size_t)frame.histogram[i] * 50 / frame.frames, '#') << " " << frame.histogram[i] << std::endl;
+		}
+	}
+
+	output.flags(flags);
+	output.precision(precision);
+}
+
+/***********************************************************
+ *  Now()
+ *
+ *  This method is used for getting the nanoseconds passed
+ *  on the CPU clock since the profiler was created.
+ ***********************************************************/
+int64_t FrameProfiler::Now() const
+{
+	return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+}
+
+/***********************************************************
+ *  HISTORY::Add()
+ *
+ *  This method is used for adding the time of the latest
+ *  frame to the rolling window, replacing the oldest time
+ *  once the window is full and keeping the histogram in
+ *  step.
+ ***********************************************************/
+void FrameProfiler::HISTORY::Add(float milliseconds)
+{
+	if (count == HISTORY_FRAMES)
+	{
+		histogram[HistogramBucket(samples[next])]--;
+	}
+	else
+	{
+		count++;
+	}
+
+	samples[next] = milliseconds;
+	histogram[HistogramBucket(milliseconds)]++;
+	next = (next + 1) % HISTORY_FRAMES;
+}
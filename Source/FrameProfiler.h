@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// time the phases of each frame on the CPU and the GPU
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FrameProfiler
+ *
+ *  This class times named scopes of each frame, on the CPU
+ *  with a steady clock and on the GPU with timestamp
+ *  queries.  The GPU results are read a few frames later so
+ *  the render loop never waits for them.  The time spent in
+ *  each scope per frame is kept over a rolling window of
+ *  frames, with a histogram and percentiles for reports, and
+ *  every timed scope can be captured into a Chrome trace
+ *  file (chrome://tracing or ui.perfetto.dev).
+ *
+ *  Scope names are registered once and timed by their ID,
+ *  usually through the ProfileScope class.
+ ***********************************************************/
+class FrameProfiler
+{
+public:
+	// constructor
+	FrameProfiler();
+	// destructor
+	~FrameProfiler();
+
+	// number of frames kept for the statistics
+	static const int HISTORY_FRAMES = 240;
+	// histogram buckets, bucket i counting times up to 2^i
+	// microseconds and the last one everything longer
+	static const int HISTOGRAM_BUCKETS = 16;
+	// frames before the GPU queries of a frame are read
+	static const int QUERY_LATENCY = 3;
+	// GPU scopes timed per frame, later scopes are CPU only
+	static const int MAX_GPU_SCOPES = 256;
+
+	struct SCOPE_STATS
+	{
+		int frames;
+		double mean;
+		double min;
+		double max;
+		double p50;
+		double p95;
+		double p99;
+		int histogram[HISTOGRAM_BUCKETS];
+	};
+
+	// create the GPU queries and start timing - GPU timing
+	// needs a current OpenGL context
+	void Start(bool bGpuTimers);
+	// read the remaining GPU queries and free them
+	void Stop();
+
+	// register a scope name and return its ID, reusing the ID
+	// of an already registered name
+	int RegisterScope(const char* name);
+	int GetScopeCount() const { return((int)m_scopes.size()); }
+	const std::string& GetScopeName(int scope) const { return(m_scopes[scope].name); }
+
+	// mark the start and the end of a frame
+	void BeginFrame();
+	void EndFrame();
+	// time a scope of the current frame, scopes nesting inside
+	// one another
+	void BeginScope(int scope, bool bGpu);
+	void EndScope();
+
+	// capture every timed scope for a trace, up to the passed
+	// in number of events
+	void StartTrace(size_t maxEvents);
+	// write the captured scopes as Chrome trace JSON
+	bool WriteTrace(const std::string& filename) const;
+
+	// statistics of a scope over the rolling window, in
+	// milliseconds per frame
+	bool GetStats(int scope, bool bGpu, SCOPE_STATS& stats) const;
+	// print the statistics of every scope
+	void Report(std::ostream& output) const;
+
+private:
+	// rolling window of the time spent in a scope per frame
+	struct HISTORY
+	{
+		std::vector<float> samples;
+		int next = 0;
+		int count = 0;
+		int histogram[HISTOGRAM_BUCKETS] = {};
+
+		void Add(float milliseconds);
+	};
+
+	struct SCOPE
+	{
+		std::string name;
+		HISTORY cpu;
+		HISTORY gpu;
+		// time spent in the scope during the current frame
+		double cpuFrameTime;
+		bool bEnteredThisFrame;
+	};
+
+	struct OPEN_SCOPE
+	{
+		int scope;
+		int64_t cpuStart;
+		int query;
+	};
+
+	struct GPU_SCOPE
+	{
+		int scope;
+		int query;
+	};
+
+	// queries and GPU scopes issued during one frame
+	struct QUERY_FRAME
+	{
+		std::vector<GLuint> queries;
+		std::vector<GPU_SCOPE> scopes;
+		// GPU clock minus CPU clock when the frame started
+		int64_t clockOffset;
+		bool bPending;
+	};
+
+	struct TRACE_EVENT
+	{
+		int scope;
+		bool bGpu;
+		int64_t start;
+		int64_t duration;
+	};
+
+	// registered scopes, indexed by ID
+	std::vector<SCOPE> m_scopes;
+	// scopes currently open, innermost last
+	std::vector<OPEN_SCOPE> m_openScopes;
+	// ring of frames waiting for their GPU queries
+	QUERY_FRAME m_queryFrames[QUERY_LATENCY];
+	int m_queryFrame;
+	int m_frameScope;
+	bool m_bStarted;
+	bool m_bGpuTimers;
+	// CPU clock origin of all the times
+	std::chrono::steady_clock::time_point m_startTime;
+	// captured trace events
+	std::vector<TRACE_EVENT> m_traceEvents;
+	size_t m_maxTraceEvents;
+
+	// nanoseconds on the CPU clock since the profiler started
+	int64_t Now() const;
+	// read the queries of a frame and add their times
+	void ResolveQueries(QUERY_FRAME& frame);
+	// keep a timed scope for the trace
+	void AddTraceEvent(int scope, bool bGpu, int64_t start, int64_t end);
+};
+
+/***********************************************************
+ *  ProfileScope
+ *
+ *  Times a scope from its construction to the end of the
+ *  enclosing block.  Nothing is timed without a profiler.
+ ***********************************************************/
+class ProfileScope
+{
+public:
+	ProfileScope(FrameProfiler* pProfiler, int scope, bool bGpu = true)
+	{
+		m_pProfiler = pProfiler;
+		if (m_pProfiler != NULL)
+		{
+			m_pProfiler->BeginScope(scope, bGpu);
+		}
+	}
+
+	~ProfileScope()
+	{
+		if (m_pProfiler != NULL)
+		{
+			m_pProfiler->EndScope();
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	FrameProfiler* m_pProfiler;
+};
@@ -0,0 +1,339 @@
+///////////////////////////////////////////////////////////////////////////////
+// framereadback.cpp
+// ============
+// read rendered frames back asynchronously and encode them on worker threads
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameReadback.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+// declaration of the global variables and defines
+namespace
+{
+	// bytes per pixel read back from the framebuffer
+	const int READBACK_CHANNELS = 4;
+	// time to wait on a fence before checking it again
+	const GLuint64 FENCE_WAIT_NANOSECONDS = 1000000000;
+}
+
+/***********************************************************
+ *  FrameReadback()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameReadback::FrameReadback()
+{
+	for (int i = 0; i < RING_SIZE; i++)
+	{
+		m_slots[i].pixelBuffer = 0;
+		m_slots[i].fence = 0;
+	}
+	m_nextSlot = 0;
+	m_width = 0;
+	m_height = 0;
+	m_format = ImageEncoder::FORMAT_PNG;
+	m_activeEncodes = 0;
+	m_failedWrites = 0;
+	m_bStopping = false;
+}
+
+/***********************************************************
+ *  ~FrameReadback()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameReadback::~FrameReadback()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for creating the ring of pixel
+ *  buffers for frames of the passed in size and for
+ *  starting the encoder threads.  By default one encoder is
+ *  started for every processor core except the one running
+ *  the render loop.
+ ***********************************************************/
+void FrameReadback::Start(int width, int height, ImageEncoder::IMAGE_FORMAT format, int workerCount)
+{
+	if (m_workers.size() > 0)
+	{
+		return;
+	}
+
+	m_width = width;
+	m_height = height;
+	m_format = format;
+	m_nextSlot = 0;
+	m_failedWrites = 0;
+
+	GLsizeiptr frameSize = (GLsizeiptr)width * height * READBACK_CHANNELS;
+	for (int i = 0; i < RING_SIZE; i++)
+	{
+		glGenBuffers(1, &m_slots[i].pixelBuffer);
+		GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, m_slots[i].pixelBuffer);
+		GLRecorder::BufferData(GL_PIXEL_PACK_BUFFER, frameSize, NULL, GL_STREAM_READ);
+		m_slots[i].fence = 0;
+	}
+	GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (workerCount <= 0)
+	{
+		workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+	}
+
+	m_bStopping = false;
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&FrameReadback::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for writing every frame read so far,
+ *  then stopping the encoder threads and freeing the pixel
+ *  buffers.
+ ***********************************************************/
+bool FrameReadback::Stop()
+{
+	bool bSuccess = true;
+	if (m_workers.size() > 0)
+	{
+		bSuccess = Finish();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_jobReady.notify_all();
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+	m_jobs.clear();
+	m_freePixels.clear();
+
+	for (int i = 0; i < RING_SIZE; i++)
+	{
+		if (m_slots[i].fence != 0)
+		{
+			glDeleteSync(m_slots[i].fence);
+			m_slots[i].fence = 0;
+		}
+		if (m_slots[i].pixelBuffer != 0)
+		{
+			GLStateCache::DeleteBuffers(1, &m_slots[i].pixelBuffer);
+			m_slots[i].pixelBuffer = 0;
+		}
+	}
+
+	return(bSuccess);
+}
+
+/***********************************************************
+ *  ReadFrame()
+ *
+ *  This method is used for starting the copy of the bound
+ *  read framebuffer into the oldest pixel buffer of the
+ *  ring.  With a pixel pack buffer bound, glReadPixels only
+ *  queues the copy on the GPU.  The frame last copied into
+ *  the slot is completed first, which only waits if the GPU
+ *  is a whole ring of frames behind.
+ ***********************************************************/
+void FrameReadback::ReadFrame(const std::string& filename)
+{
+	READBACK_SLOT& slot = m_slots[m_nextSlot];
+	if (slot.fence != 0)
+	{
+		CompleteSlot(slot, true);
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+	glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slot.filename = filename;
+
+	m_nextSlot = (m_nextSlot + 1) % RING_SIZE;
+
+	// pick up any earlier frames that have already arrived
+	Poll();
+}
+
+/***********************************************************
+ *  Poll()
+ *
+ *  This method is used for handing the frames that have
+ *  arrived to the encoders without waiting for the others.
+ *  The slots are checked oldest first and the check stops at
+ *  the first frame still in flight, keeping the frames in
+ *  order.
+ ***********************************************************/
+void FrameReadback::Poll()
+{
+	for (int i = 0; i < RING_SIZE; i++)
+	{
+		READBACK_SLOT& slot = m_slots[(m_nextSlot + i) % RING_SIZE];
+		if ((slot.fence != 0) && (CompleteSlot(slot, false) == false))
+		{
+			break;
+		}
+	}
+}
+
+/***********************************************************
+ *  Finish()
+ *
+ *  This method is used for waiting until every frame read so
+ *  far has arrived, been encoded and been written.  It
+ *  returns false if any frame could not be written.
+ ***********************************************************/
+bool FrameReadback::Finish()
+{
+	for (int i = 0; i < RING_SIZE; i++)
+	{
+		READBACK_SLOT& slot = m_slots[(m_nextSlot + i) % RING_SIZE];
+		if (slot.fence != 0)
+		{
+			CompleteSlot(slot, true);
+		}
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_jobDone.wait(lock, [this]() { return((m_jobs.size() == 0) && (m_activeEncodes == 0)); });
+
+	return(m_failedWrites == 0);
+}
+
+/***********************************************************
+ *  CompleteSlot()
+ *
+ *  This method is used for checking the fence of a slot and,
+ *  once the copy has arrived, copying the pixels out of the
+ *  mapped pixel buffer into storage owned by an encode job.
+ *  When too many frames are already waiting for an encoder
+ *  the render loop waits here for one to finish.
+ ***********************************************************/
+bool FrameReadback::CompleteSlot(READBACK_SLOT& slot, bool bWait)
+{
+	GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	while ((bWait == true) && (result == GL_TIMEOUT_EXPIRED))
+	{
+		result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_NANOSECONDS);
+	}
+	if (result == GL_TIMEOUT_EXPIRED)
+	{
+		return(false);
+	}
+
+	glDeleteSync(slot.fence);
+	slot.fence = 0;
+
+	ENCODE_JOB job;
+	job.filename = slot.filename;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_jobDone.wait(lock, [this]() { return((int)m_jobs.size() < MAX_QUEUED_FRAMES); });
+		if (m_freePixels.size() > 0)
+		{
+			job.pixels = std::move(m_freePixels.back());
+			m_freePixels.pop_back();
+		}
+	}
+
+	size_t frameSize = (size_t)m_width * m_height * READBACK_CHANNELS;
+	job.pixels.resize(frameSize);
+
+	bool bMapped = false;
+	if (result != GL_WAIT_FAILED)
+	{
+		GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+		const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameSize, GL_MAP_READ_BIT);
+		if (pixels != NULL)
+		{
+			memcpy(job.pixels.data(), pixels, frameSize);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			bMapped = true;
+		}
+		GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (bMapped == true)
+	{
+		m_jobs.push_back(std::move(job));
+		m_jobReady.notify_one();
+	}
+	else
+	{
+		std::cout << "Could not read back frame:" << slot.filename << std::endl;
+		m_failedWrites++;
+		m_freePixels.push_back(std::move(job.pixels));
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is run by every encoder thread.  It takes the
+ *  next queued frame and, outside of the lock, encodes and
+ *  writes its image file, then returns the pixel storage
+ *  for the next frame to use.
+ ***********************************************************/
+void FrameReadback::WorkerLoop()
+{
+	std::vector<unsigned char> image;
+
+	while (true)
+	{
+		ENCODE_JOB job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobReady.wait(lock, [this]() { return((m_bStopping == true) || (m_jobs.size() > 0)); });
+			if (m_bStopping == true)
+			{
+				return;
+			}
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			m_activeEncodes++;
+		}
+		// a queue slot was freed for the render loop
+		m_jobDone.notify_all();
+
+		ImageEncoder::Encode(m_format, job.pixels.data(), m_width, m_height, image);
+		bool bWritten = ImageEncoder::WriteFile(job.filename, image);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_activeEncodes--;
+			if (bWritten == false)
+			{
+				m_failedWrites++;
+			}
+			m_freePixels.push_back(std::move(job.pixels));
+		}
+		m_jobDone.notify_all();
+	}
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// framereadback.h
+// ============
+// read rendered frames back asynchronously and encode them on worker threads
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ImageEncoder.h"
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  FrameReadback
+ *
+ *  This class copies rendered frames into a ring of pixel
+ *  buffer objects, so glReadPixels returns without waiting
+ *  for the frame to finish on the GPU.  A fence placed after
+ *  each copy tells when the pixels can be mapped; they are
+ *  then handed to a pool of worker threads that encode and
+ *  write the image files while the next frames render.  The
+ *  render loop only waits when a ring slot is reused before
+ *  the GPU has finished with it, or when the encoders fall
+ *  far behind.
+ ***********************************************************/
+class FrameReadback
+{
+public:
+	// constructor
+	FrameReadback();
+	// destructor
+	~FrameReadback();
+
+	// number of frames that can be in flight on the GPU
+	static const int RING_SIZE = 3;
+	// number of read frames that can wait for an encoder
+	static const int MAX_QUEUED_FRAMES = 16;
+
+	// create the pixel buffers and start the encoder threads
+	void Start(int width, int height, ImageEncoder::IMAGE_FORMAT format, int workerCount = 0);
+	// wait for every frame to be written, then stop the threads
+	// and free the pixel buffers
+	bool Stop();
+
+	// copy the bound read framebuffer into the next pixel buffer,
+	// to be written to the passed in file once it arrives
+	void ReadFrame(const std::string& filename);
+	// hand every frame that has arrived to the encoders
+	void Poll();
+	// wait for every frame read so far to be written
+	bool Finish();
+
+	// format the frames are written in
+	ImageEncoder::IMAGE_FORMAT GetFormat() const { return(m_format); }
+
+private:
+	struct READBACK_SLOT
+	{
+		GLuint pixelBuffer;
+		GLsync fence;
+		std::string filename;
+	};
+
+	struct ENCODE_JOB
+	{
+		std::string filename;
+		std::vector<unsigned char> pixels;
+	};
+
+	// ring of pixel buffers, m_nextSlot being the oldest
+	READBACK_SLOT m_slots[RING_SIZE];
+	int m_nextSlot;
+	int m_width;
+	int m_height;
+	ImageEncoder::IMAGE_FORMAT m_format;
+
+	// encoder threads
+	std::vector<std::thread> m_workers;
+	// frames waiting to be encoded
+	std::deque<ENCODE_JOB> m_jobs;
+	// pixel storage returned by the encoders for reuse
+	std::vector<std::vector<unsigned char>> m_freePixels;
+	// number of frames currently being encoded
+	int m_activeEncodes;
+	// number of frames that could not be written
+	int m_failedWrites;
+	// guards the queue, the free storage and the counters
+	std::mutex m_mutex;
+	// wakes the encoders when frames are queued
+	std::condition_variable m_jobReady;
+	// wakes the render loop when an encoder finishes a frame
+	std::condition_variable m_jobDone;
+	// set when the encoders need to exit
+	bool m_bStopping;
+
+	// map a slot whose copy has arrived and queue its pixels,
+	// returning false if the copy is still running and the
+	// caller does not wait for it
+	bool CompleteSlot(READBACK_SLOT& slot, bool bWait);
+	// loop run by each encoder thread
+	void WorkerLoop();
+};
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+// glcommandlog.h
+// ============
+// binary layout of the recorded OpenGL command logs
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+/***********************************************************
+ *  GL command log
+ *
+ *  A log starts with a LOG_HEADER, followed by one record
+ *  per command: a one byte LOG_COMMAND and the payload struct
+ *  of that command.  Uniform records are followed by the
+ *  uniform value, whose size depends on its type.  Uploaded
+ *  data is not stored, only its size and a hash of it, so
+ *  that repeated uploads of the same bytes can be found.
+ *  The OpenGL enums and object names are stored as they
+ *  were passed to OpenGL, so the log does not depend on the
+ *  OpenGL headers.
+ ***********************************************************/
+
+// commands stored in the log
+enum LOG_COMMAND
+{
+	LOG_COMMAND_FRAME = 1,
+	LOG_COMMAND_UNIFORM,
+	LOG_COMMAND_BIND_BUFFER,
+	LOG_COMMAND_BIND_BUFFER_BASE,
+	LOG_COMMAND_BUFFER_DATA,
+	LOG_COMMAND_BUFFER_SUB_DATA,
+	LOG_COMMAND_ACTIVE_TEXTURE,
+	LOG_COMMAND_BIND_TEXTURE,
+	LOG_COMMAND_TEX_IMAGE,
+	LOG_COMMAND_BIND_VERTEX_ARRAY,
+	LOG_COMMAND_ENABLE,
+	LOG_COMMAND_CLEAR,
+	LOG_COMMAND_DRAW_MESH,
+	LOG_COMMAND_DRAW_ELEMENTS_INSTANCED,
+	LOG_COMMAND_MULTI_DRAW_ELEMENTS_INDIRECT,
+	LOG_COMMAND_USE_PROGRAM,
+	LOG_COMMAND_COUNT
+};
+
+// types of the recorded uniform values
+enum LOG_UNIFORM_TYPE
+{
+	LOG_UNIFORM_INT,
+	LOG_UNIFORM_FLOAT,
+	LOG_UNIFORM_VEC2,
+	LOG_UNIFORM_VEC3,
+	LOG_UNIFORM_VEC4,
+	LOG_UNIFORM_MAT4,
+	LOG_UNIFORM_TYPE_COUNT
+};
+
+// size in bytes of the value of each uniform type
+const uint32_t LOG_UNIFORM_SIZES[LOG_UNIFORM_TYPE_COUNT] = { 4, 4, 8, 12, 16, 64 };
+
+// "GLCL" read as a little-endian number
+const uint32_t LOG_MAGIC = 0x4C434C47;
+const uint32_t LOG_VERSION = 1;
+
+struct LOG_HEADER
+{
+	uint32_t magic;
+	uint32_t version;
+};
+
+// payloads of the commands - every field is 32 or 64 bits
+// wide and the 64 bit fields come first, so the structs
+// have no padding
+struct LOG_FRAME_COMMAND
+{
+	uint32_t frame;
+};
+
+struct LOG_UNIFORM_COMMAND
+{
+	int32_t location;
+	uint32_t type;
+};
+
+struct LOG_BIND_BUFFER_COMMAND
+{
+	uint32_t target;
+	uint32_t buffer;
+};
+
+struct LOG_BIND_BUFFER_BASE_COMMAND
+{
+	uint32_t target;
+	uint32_t index;
+	uint32_t buffer;
+};
+
+// hash is zero when the buffer is only allocated
+struct LOG_BUFFER_DATA_COMMAND
+{
+	uint64_t hash;
+	uint64_t size;
+	uint32_t target;
+	uint32_t usage;
+};
+
+struct LOG_BUFFER_SUB_DATA_COMMAND
+{
+	uint64_t hash;
+	uint64_t offset;
+	uint64_t size;
+	uint32_t target;
+	uint32_t reserved;
+};
+
+struct LOG_ACTIVE_TEXTURE_COMMAND
+{
+	uint32_t unit;
+};
+
+struct LOG_BIND_TEXTURE_COMMAND
+{
+	uint32_t target;
+	uint32_t texture;
+};
+
+struct LOG_TEX_IMAGE_COMMAND
+{
+	uint64_t size;
+	uint32_t target;
+	int32_t level;
+	int32_t width;
+	int32_t height;
+};
+
+struct LOG_BIND_VERTEX_ARRAY_COMMAND
+{
+	uint32_t vertexArray;
+};
+
+struct LOG_ENABLE_COMMAND
+{
+	uint32_t capability;
+};
+
+struct LOG_CLEAR_COMMAND
+{
+	uint32_t mask;
+};
+
+// draw of a basic shape mesh issued outside the recording
+// layer, by the ShapeMeshes class
+struct LOG_DRAW_MESH_COMMAND
+{
+	uint32_t mesh;
+};
+
+struct LOG_DRAW_ELEMENTS_INSTANCED_COMMAND
+{
+	uint32_t mode;
+	int32_t count;
+	int32_t instanceCount;
+};
+
+// the draw commands themselves stay in the indirect buffer,
+// so only their number and total instances are stored
+struct LOG_MULTI_DRAW_ELEMENTS_INDIRECT_COMMAND
+{
+	uint32_t mode;
+	int32_t drawCount;
+	int32_t instanceCount;
+};
+
+struct LOG_USE_PROGRAM_COMMAND
+{
+	uint32_t program;
+};
@@ -0,0 +1,554 @@
+///////////////////////////////////////////////////////////////////////////////
+// glrecorder.cpp
+// ============
+// record the OpenGL commands of each frame into a binary log
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GLRecorder.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// declaration of the global variables and defines
+namespace
+{
+	// size of the buffered records that triggers a write
+	const size_t LOG_FLUSH_SIZE = 1 << 20;
+
+	std::ofstream g_LogFile;
+	std::vector<unsigned char> g_LogBuffer;
+	bool g_bRecording = false;
+	bool g_bWriteFailed = false;
+	uint32_t g_FrameIndex = 0;
+
+	// bytes in one pixel of an uploaded image
+	size_t PixelSize(GLenum format, GLenum type)
+	{
+		size_t channels = 4;
+		switch (format)
+		{
+		case GL_RED:
+			channels = 1;
+			break;
+		case GL_RG:
+			channels = 2;
+			break;
+		case GL_RGB:
+		case GL_BGR:
+			channels = 3;
+			break;
+		default:
+			break;
+		}
+
+		size_t channelSize = 1;
+		if ((type == GL_FLOAT) || (type == GL_UNSIGNED_INT) || (type == GL_INT))
+		{
+			channelSize = 4;
+		}
+		else if ((type == GL_HALF_FLOAT) || (type == GL_UNSIGNED_SHORT) || (type == GL_SHORT))
+		{
+			channelSize = 2;
+		}
+
+		return(channels * channelSize);
+	}
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for opening the log file and writing
+ *  its header.  Every wrapped call made after this is
+ *  recorded, until the log is stopped.
+ ***********************************************************/
+bool GLRecorder::Start(const std::string& filename)
+{
+	if (g_bRecording == true)
+	{
+		Stop();
+	}
+
+	g_LogFile.open(filename, std::ios::binary | std::ios::trunc);
+	if (!g_LogFile)
+	{
+		std::cout << "Could not open the command log file:" << filename << std::endl;
+		return(false);
+	}
+
+	LOG_HEADER header;
+	header.magic = LOG_MAGIC;
+	header.version = LOG_VERSION;
+
+	g_LogBuffer.clear();
+	g_LogBuffer.reserve(LOG_FLUSH_SIZE * 2);
+	g_LogBuffer.insert(g_LogBuffer.end(), (const unsigned char*)&header, (const unsigned char*)&header + sizeof(header));
+	g_bRecording = true;
+	g_bWriteFailed = false;
+	g_FrameIndex = 0;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for writing the buffered records and
+ *  closing the log file.
+ ***********************************************************/
+bool GLRecorder::Stop()
+{
+	if (g_bRecording == false)
+	{
+		return(false);
+	}
+
+	Flush();
+	g_LogFile.close();
+	g_bRecording = false;
+
+	// release the buffer memory
+	std::vector<unsigned char>().swap(g_LogBuffer);
+
+	if (g_bWriteFailed == true)
+	{
+		std::cout << "Could not write the whole command log" << std::endl;
+		return(false);
+	}
+	return(true);
+}
+
+/***********************************************************
+ *  IsRecording()
+ *
+ *  This method is used for checking whether a log is being
+ *  recorded.
+ ***********************************************************/
+bool GLRecorder::IsRecording()
+{
+	return(g_bRecording);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for recording the start of the next
+ *  frame, which also ends the frame before it.
+ ***********************************************************/
+void GLRecorder::BeginFrame()
+{
+	if (g_bRecording == false)
+	{
+		return;
+	}
+
+	LOG_FRAME_COMMAND command;
+	command.frame = g_FrameIndex++;
+	Write(LOG_COMMAND_FRAME, &command, sizeof(command));
+
+	// write the records of the frames before this one, so a
+	// long run does not keep its whole log in memory
+	if (g_LogBuffer.size() >= LOG_FLUSH_SIZE)
+	{
+		Flush();
+	}
+}
+
+/***********************************************************
+ *  RecordDrawMesh()
+ *
+ *  This method is used for recording the draw of a basic
+ *  shape mesh, whose OpenGL calls are made by ShapeMeshes.
+ ***********************************************************/
+void GLRecorder::RecordDrawMesh(int mesh)
+{
+	if (g_bRecording == false)
+	{
+		return;
+	}
+
+	LOG_DRAW_MESH_COMMAND command;
+	command.mesh = (uint32_t)mesh;
+	Write(LOG_COMMAND_DRAW_MESH, &command, sizeof(command));
+}
+
+/***********************************************************
+ *  Uniform*()
+ *
+ *  These methods are used for setting the value of a uniform
+ *  of the program in use, and recording it.
+ ***********************************************************/
+void GLRecorder::Uniform1i(GLint location, GLint value)
+{
+	glUniform1i(location, value);
+	WriteUniform(location, LOG_UNIFORM_INT, &value);
+}
+
+void GLRecorder::Uniform1f(GLint location, GLfloat value)
+{
+	glUniform1f(location, value);
+	WriteUniform(location, LOG_UNIFORM_FLOAT, &value);
+}
+
+void GLRecorder::Uniform2fv(GLint location, const GLfloat* value)
+{
+	glUniform2fv(location, 1, value);
+	WriteUniform(location, LOG_UNIFORM_VEC2, value);
+}
+
+void GLRecorder::Uniform3fv(GLint location, const GLfloat* value)
+{
+	glUniform3fv(location, 1, value);
+	WriteUniform(location, LOG_UNIFORM_VEC3, value);
+}
+
+void GLRecorder::Uniform4fv(GLint location, const GLfloat* value)
+{
+	glUniform4fv(location, 1, value);
+	WriteUniform(location, LOG_UNIFORM_VEC4, value);
+}
+
+void GLRecorder::UniformMatrix4fv(GLint location, const GLfloat* value)
+{
+	glUniformMatrix4fv(location, 1, GL_FALSE, value);
+	WriteUniform(location, LOG_UNIFORM_MAT4, value);
+}
+
+/***********************************************************
+ *  BindBuffer()
+ *
+ *  This method is used for binding a buffer to a target.
+ ***********************************************************/
+void GLRecorder::BindBuffer(GLenum target, GLuint buffer)
+{
+	glBindBuffer(target, buffer);
+	if (g_bRecording == true)
+	{
+		LOG_BIND_BUFFER_COMMAND command;
+		command.target = target;
+		command.buffer = buffer;
+		Write(LOG_COMMAND_BIND_BUFFER, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  BindBufferBase()
+ *
+ *  This method is used for binding a buffer to an indexed
+ *  binding point of a target.
+ ***********************************************************/
+void GLRecorder::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	glBindBufferBase(target, index, buffer);
+	if (g_bRecording == true)
+	{
+		LOG_BIND_BUFFER_BASE_COMMAND command;
+		command.target = target;
+		command.index = index;
+		command.buffer = buffer;
+		Write(LOG_COMMAND_BIND_BUFFER_BASE, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  BufferData()
+ *
+ *  This method is used for allocating the storage of the
+ *  buffer bound to a target, and filling it when data is
+ *  passed in.
+ ***********************************************************/
+void GLRecorder::BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+	glBufferData(target, size, data, usage);
+	if (g_bRecording == true)
+	{
+		LOG_BUFFER_DATA_COMMAND command;
+		command.hash = (NULL != data) ? Hash(data, (size_t)size) : 0;
+		command.size = (uint64_t)size;
+		command.target = target;
+		command.usage = usage;
+		Write(LOG_COMMAND_BUFFER_DATA, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  BufferSubData()
+ *
+ *  This method is used for uploading data into a range of
+ *  the buffer bound to a target.
+ ***********************************************************/
+void GLRecorder::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+	glBufferSubData(target, offset, size, data);
+	if (g_bRecording == true)
+	{
+		LOG_BUFFER_SUB_DATA_COMMAND command;
+		command.hash = Hash(data, (size_t)size);
+		command.offset = (uint64_t)offset;
+		command.size = (uint64_t)size;
+		command.target = target;
+		command.reserved = 0;
+		Write(LOG_COMMAND_BUFFER_SUB_DATA, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  ActiveTexture()
+ *
+ *  This method is used for selecting the texture unit that
+ *  the next texture binds apply to.
+ ***********************************************************/
+void GLRecorder::ActiveTexture(GLenum unit)
+{
+	glActiveTexture(unit);
+	if (g_bRecording == true)
+	{
+		LOG_ACTIVE_TEXTURE_COMMAND command;
+		command.unit = unit;
+		Write(LOG_COMMAND_ACTIVE_TEXTURE, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  BindTexture()
+ *
+ *  This method is used for binding a texture to a target of
+ *  the active texture unit.
+ ***********************************************************/
+void GLRecorder::BindTexture(GLenum target, GLuint texture)
+{
+	glBindTexture(target, texture);
+	if (g_bRecording == true)
+	{
+		LOG_BIND_TEXTURE_COMMAND command;
+		command.target = target;
+		command.texture = texture;
+		Write(LOG_COMMAND_BIND_TEXTURE, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  TexSubImage3D()
+ *
+ *  This method is used for uploading part of one level of
+ *  the texture bound to a target, such as a layer of a
+ *  texture array.  The pixels may be an offset into a bound
+ *  pixel buffer, so only the size of the image is recorded.
+ ***********************************************************/
+void GLRecorder::TexSubImage3D(
+	GLenum target,
+	GLint level,
+	GLint xOffset,
+	GLint yOffset,
+	GLint zOffset,
+	GLsizei width,
+	GLsizei height,
+	GLsizei depth,
+	GLenum format,
+	GLenum type,
+	const void* pixels)
+{
+	glTexSubImage3D(target, level, xOffset, yOffset, zOffset, width, height, depth, format, type, pixels);
+	if (g_bRecording == true)
+	{
+		LOG_TEX_IMAGE_COMMAND command;
+		command.size = (uint64_t)width * (uint64_t)height * (uint64_t)depth * PixelSize(format, type);
+		command.target = target;
+		command.level = level;
+		command.width = width;
+		command.height = height;
+		Write(LOG_COMMAND_TEX_IMAGE, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  BindVertexArray()
+ *
+ *  This method is used for binding a vertex array object.
+ ***********************************************************/
+void GLRecorder::BindVertexArray(GLuint vertexArray)
+{
+	glBindVertexArray(vertexArray);
+	if (g_bRecording == true)
+	{
+		LOG_BIND_VERTEX_ARRAY_COMMAND command;
+		command.vertexArray = vertexArray;
+		Write(LOG_COMMAND_BIND_VERTEX_ARRAY, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  UseProgram()
+ *
+ *  This method is used for making a shader program current.
+ ***********************************************************/
+void GLRecorder::UseProgram(GLuint program)
+{
+	glUseProgram(program);
+	if (g_bRecording == true)
+	{
+		LOG_USE_PROGRAM_COMMAND command;
+		command.program = program;
+		Write(LOG_COMMAND_USE_PROGRAM, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  Enable()
+ *
+ *  This method is used for enabling an OpenGL capability.
+ ***********************************************************/
+void GLRecorder::Enable(GLenum capability)
+{
+	glEnable(capability);
+	if (g_bRecording == true)
+	{
+		LOG_ENABLE_COMMAND command;
+		command.capability = capability;
+		Write(LOG_COMMAND_ENABLE, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for clearing buffers of the bound
+ *  framebuffer.
+ ***********************************************************/
+void GLRecorder::Clear(GLbitfield mask)
+{
+	glClear(mask);
+	if (g_bRecording == true)
+	{
+		LOG_CLEAR_COMMAND command;
+		command.mask = mask;
+		Write(LOG_COMMAND_CLEAR, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  DrawElementsInstanced()
+ *
+ *  This method is used for drawing several instances of the
+ *  indexed triangles of the bound vertex array.
+ ***********************************************************/
+void GLRecorder::DrawElementsInstanced(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLsizei instanceCount)
+{
+	glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+	if (g_bRecording == true)
+	{
+		LOG_DRAW_ELEMENTS_INSTANCED_COMMAND command;
+		command.mode = mode;
+		command.count = count;
+		command.instanceCount = instanceCount;
+		Write(LOG_COMMAND_DRAW_ELEMENTS_INSTANCED, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  MultiDrawElementsIndirect()
+ *
+ *  This method is used for issuing several instanced draws
+ *  whose commands are read from the bound indirect buffer.
+ ***********************************************************/
+void GLRecorder::MultiDrawElementsIndirect(
+	GLenum mode,
+	GLenum type,
+	const void* indirect,
+	GLsizei drawCount,
+	GLsizei stride,
+	GLsizei instanceCount)
+{
+	glMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+	if (g_bRecording == true)
+	{
+		LOG_MULTI_DRAW_ELEMENTS_INDIRECT_COMMAND command;
+		command.mode = mode;
+		command.drawCount = drawCount;
+		command.instanceCount = instanceCount;
+		Write(LOG_COMMAND_MULTI_DRAW_ELEMENTS_INDIRECT, &command, sizeof(command));
+	}
+}
+
+/***********************************************************
+ *  Write()
+ *
+ *  This method is used for appending a command record,
+ *  made of the command byte, its payload and an optional
+ *  value, to the buffered records.
+ ***********************************************************/
+void GLRecorder::Write(LOG_COMMAND command, const void* payload, size_t size, const void* value, size_t valueSize)
+{
+	g_LogBuffer.push_back((unsigned char)command);
+	g_LogBuffer.insert(g_LogBuffer.end(), (const unsigned char*)payload, (const unsigned char*)payload + size);
+	if (valueSize > 0)
+	{
+		g_LogBuffer.insert(g_LogBuffer.end(), (const unsigned char*)value, (const unsigned char*)value + valueSize);
+	}
+}
+
+/***********************************************************
+ *  WriteUniform()
+ *
+ *  This method is used for recording a uniform value.
+ ***********************************************************/
+void GLRecorder::WriteUniform(GLint location, LOG_UNIFORM_TYPE type, const void* value)
+{
+	if (g_bRecording == false)
+	{
+		return;
+	}
+
+	LOG_UNIFORM_COMMAND command;
+	command.location = location;
+	command.type = (uint32_t)type;
+	Write(LOG_COMMAND_UNIFORM, &command, sizeof(command), value, LOG_UNIFORM_SIZES[type]);
+}
+
+/***********************************************************
+ *  Flush()
+ *
+ *  This method is used for writing the buffered records to
+ *  the log file.
+ ***********************************************************/
+void GLRecorder::Flush()
+{
+	if (g_LogBuffer.empty())
+	{
+		return;
+	}
+
+	g_LogFile.write((const char*)g_LogBuffer.data(), (std::streamsize)g_LogBuffer.size());
+	if (!g_LogFile)
+	{
+		g_bWriteFailed = true;
+	}
+	g_LogBuffer.clear();
+}
+
+/***********************************************************
+ *  Hash()
+ *
+ *  This method is used for computing the 64-bit FNV-1a hash
+ *  of a block of uploaded bytes.
+ ***********************************************************/
+uint64_t GLRecorder::Hash(const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return(hash);
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// glrecorder.h
+// ============
+// record the OpenGL commands of each frame into a binary log
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GLCommandLog.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/***********************************************************
+ *  GLRecorder
+ *
+ *  This class is a thin layer between the scene code and
+ *  OpenGL.  Each wrapped call is passed on to OpenGL, and
+ *  while a log is being recorded it is also appended to the
+ *  log, as described in GLCommandLog.h.  The meshes drawn by
+ *  the ShapeMeshes class are recorded as one draw command
+ *  per mesh, since their OpenGL calls are made outside this
+ *  layer.  Object creation, vertex attribute setup, texture
+ *  storage and parameters, writes through mapped buffers,
+ *  pixel reads and shader compilation are not recorded.
+ *  Commands are buffered in memory and written to the file
+ *  in large blocks, and must all be made from the thread
+ *  owning the OpenGL context.
+ ***********************************************************/
+class GLRecorder
+{
+public:
+	// start recording the wrapped calls into a log file
+	static bool Start(const std::string& filename);
+	// write out the buffered commands and close the log,
+	// returning whether the whole log was written
+	static bool Stop();
+	// true while a log is being recorded
+	static bool IsRecording();
+
+	// mark the start of the next frame
+	static void BeginFrame();
+	// record the draw of a basic shape mesh
+	static void RecordDrawMesh(int mesh);
+
+	// wrapped OpenGL calls
+	static void UseProgram(GLuint program);
+	static void Uniform1i(GLint location, GLint value);
+	static void Uniform1f(GLint location, GLfloat value);
+	static void Uniform2fv(GLint location, const GLfloat* value);
+	static void Uniform3fv(GLint location, const GLfloat* value);
+	static void Uniform4fv(GLint location, const GLfloat* value);
+	static void UniformMatrix4fv(GLint location, const GLfloat* value);
+	static void BindBuffer(GLenum target, GLuint buffer);
+	static void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+	static void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+	static void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+	static void ActiveTexture(GLenum unit);
+	static void BindTexture(GLenum target, GLuint texture);
+	static void TexSubImage3D(
+		GLenum target,
+		GLint level,
+		GLint xOffset,
+		GLint yOffset,
+		GLint zOffset,
+		GLsizei width,
+		GLsizei height,
+		GLsizei depth,
+		GLenum format,
+		GLenum type,
+		const void* pixels);
+	static void BindVertexArray(GLuint vertexArray);
+	static void Enable(GLenum capability);
+	static void Clear(GLbitfield mask);
+	static void DrawElementsInstanced(
+		GLenum mode,
+		GLsizei count,
+		GLenum type,
+		const void* indices,
+		GLsizei instanceCount);
+	// the total instances of the draws are only used for the log
+	static void MultiDrawElementsIndirect(
+		GLenum mode,
+		GLenum type,
+		const void* indirect,
+		GLsizei drawCount,
+		GLsizei stride,
+		GLsizei instanceCount);
+
+private:
+	// append a command record to the log
+	static void Write(LOG_COMMAND command, const void* payload, size_t size, const void* value = NULL, size_t valueSize = 0);
+	static void WriteUniform(GLint location, LOG_UNIFORM_TYPE type, const void* value);
+	// write the buffered records to the file
+	static void Flush();
+	// hash of uploaded bytes, to find repeated uploads
+	static uint64_t Hash(const void* data, size_t size);
+};
@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////
+// glreplayer.cpp
+// ============
+// read recorded OpenGL command logs back, command by command
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GLReplayer.h"
+
+#include <cstring>
+#include <iostream>
+
+/***********************************************************
+ *  GLReplayer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GLReplayer::GLReplayer()
+{
+}
+
+/***********************************************************
+ *  ~GLReplayer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GLReplayer::~GLReplayer()
+{
+	Close();
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for mapping a log file and checking
+ *  that it was written by a matching version of the
+ *  recorder.
+ ***********************************************************/
+bool GLReplayer::Open(const std::string& filename)
+{
+	if (m_file.Open(filename) == false)
+	{
+		std::cout << "Could not open the command log file:" << filename << std::endl;
+		return(false);
+	}
+
+	LOG_HEADER header;
+	if (m_file.GetSize() < sizeof(header))
+	{
+		std::cout << "Command log file is too small:" << filename << std::endl;
+		Close();
+		return(false);
+	}
+	memcpy(&header, m_file.GetData(), sizeof(header));
+	if ((header.magic != LOG_MAGIC) || (header.version != LOG_VERSION))
+	{
+		std::cout << "Not a command log file of this version:" << filename << std::endl;
+		Close();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for releasing the log file.
+ ***********************************************************/
+void GLReplayer::Close()
+{
+	m_file.Close();
+}
+
+/***********************************************************
+ *  Replay()
+ *
+ *  This method is used for decoding the records of the log
+ *  and passing them to the handler.  The payloads are
+ *  copied out of the mapped file, since the records are
+ *  packed without alignment.
+ ***********************************************************/
+bool GLReplayer::Replay(Handler& handler)
+{
+	if (m_file.IsOpen() == false)
+	{
+		return(false);
+	}
+
+	const unsigned char* data = m_file.GetData();
+	size_t size = m_file.GetSize();
+	size_t offset = sizeof(LOG_HEADER);
+
+	// large enough for the biggest payload and uniform value
+	uint64_t payload[8];
+	uint64_t value[8];
+
+	while (offset < size)
+	{
+		LOG_COMMAND command = (LOG_COMMAND)data[offset++];
+		size_t payloadSize = GetPayloadSize(command);
+		if ((payloadSize == 0) || (offset + payloadSize > size))
+		{
+			std::cout << "Command log is damaged at offset " << offset - 1 << std::endl;
+			return(false);
+		}
+		memcpy(payload, data + offset, payloadSize);
+		offset += payloadSize;
+
+		REPLAY_COMMAND replay;
+		replay.command = command;
+		replay.payload = payload;
+		replay.value = NULL;
+
+		if (command == LOG_COMMAND_UNIFORM)
+		{
+			const LOG_UNIFORM_COMMAND* uniform = (const LOG_UNIFORM_COMMAND*)payload;
+			if (uniform->type >= LOG_UNIFORM_TYPE_COUNT)
+			{
+				std::cout << "Command log is damaged at offset " << offset << std::endl;
+				return(false);
+			}
+			size_t valueSize = LOG_UNIFORM_SIZES[uniform->type];
+			if (offset + valueSize > size)
+			{
+				std::cout << "Command log is damaged at offset " << offset << std::endl;
+				return(false);
+			}
+			memcpy(value, data + offset, valueSize);
+			offset += valueSize;
+			replay.value = value;
+		}
+
+		handler.Execute(replay);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetCommandName()
+ *
+ *  This method is used for getting the name of a command.
+ ***********************************************************/
+const char* GLReplayer::GetCommandName(LOG_COMMAND command)
+{
+	switch (command)
+	{
+	case LOG_COMMAND_FRAME:
+		return("Frame");
+	case LOG_COMMAND_UNIFORM:
+		return("Uniform");
+	case LOG_COMMAND_BIND_BUFFER:
+		return("BindBuffer");
+	case LOG_COMMAND_BIND_BUFFER_BASE:
+		return("BindBufferBase");
+	case LOG_COMMAND_BUFFER_DATA:
+		return("BufferData");
+	case LOG_COMMAND_BUFFER_SUB_DATA:
+		return("BufferSubData");
+	case LOG_COMMAND_ACTIVE_TEXTURE:
+		return("ActiveTexture");
+	case LOG_COMMAND_BIND_TEXTURE:
+		return("BindTexture");
+	case LOG_COMMAND_TEX_IMAGE:
+		return("TexSubImage3D");
+	case LOG_COMMAND_BIND_VERTEX_ARRAY:
+		return("BindVertexArray");
+	case LOG_COMMAND_ENABLE:
+		return("Enable");
+	case LOG_COMMAND_CLEAR:
+		return("Clear");
+	case LOG_COMMAND_DRAW_MESH:
+		return("DrawMesh");
+	case LOG_COMMAND_DRAW_ELEMENTS_INSTANCED:
+		return("DrawElementsInstanced");
+	case LOG_COMMAND_MULTI_DRAW_ELEMENTS_INDIRECT:
+		return("MultiDrawElementsIndirect");
+	case LOG_COMMAND_USE_PROGRAM:
+		return("UseProgram");
+	default:
+		return("Unknown");
+	}
+}
+
+/***********************************************************
+ *  GetPayloadSize()
+ *
+ *  This method is used for getting the size of the payload
+ *  struct of a command, or zero for unknown commands.
+ ***********************************************************/
+size_t GLReplayer::GetPayloadSize(LOG_COMMAND command)
+{
+	switch (command)
+	{
+	case LOG_COMMAND_FRAME:
+		return(sizeof(LOG_FRAME_COMMAND));
+	case LOG_COMMAND_UNIFORM:
+		return(sizeof(LOG_UNIFORM_COMMAND));
+	case LOG_COMMAND_BIND_BUFFER:
+		return(sizeof(LOG_BIND_BUFFER_COMMAND));
+	case LOG_COMMAND_BIND_BUFFER_BASE:
+		return(sizeof(LOG_BIND_BUFFER_BASE_COMMAND));
+	case LOG_COMMAND_BUFFER_DATA:
+		return(sizeof(LOG_BUFFER_DATA_COMMAND));
+	case LOG_COMMAND_BUFFER_SUB_DATA:
+		return(sizeof(LOG_BUFFER_SUB_DATA_COMMAND));
+	case LOG_COMMAND_ACTIVE_TEXTURE:
+		return(sizeof(LOG_ACTIVE_TEXTURE_COMMAND));
+	case LOG_COMMAND_BIND_TEXTURE:
+		return(sizeof(LOG_BIND_TEXTURE_COMMAND));
+	case LOG_COMMAND_TEX_IMAGE:
+		return(sizeof(LOG_TEX_IMAGE_COMMAND));
+	case LOG_COMMAND_BIND_VERTEX_ARRAY:
+		return(sizeof(LOG_BIND_VERTEX_ARRAY_COMMAND));
+	case LOG_COMMAND_ENABLE:
+		return(sizeof(LOG_ENABLE_COMMAND));
+	case LOG_COMMAND_CLEAR:
+		return(sizeof(LOG_CLEAR_COMMAND));
+	case LOG_COMMAND_DRAW_MESH:
+		return(sizeof(LOG_DRAW_MESH_COMMAND));
+	case LOG_COMMAND_DRAW_ELEMENTS_INSTANCED:
+		return(sizeof(LOG_DRAW_ELEMENTS_INSTANCED_COMMAND));
+	case LOG_COMMAND_MULTI_DRAW_ELEMENTS_INDIRECT:
+		return(sizeof(LOG_MULTI_DRAW_ELEMENTS_INDIRECT_COMMAND));
+	case LOG_COMMAND_USE_PROGRAM:
+		return(sizeof(LOG_USE_PROGRAM_COMMAND));
+	default:
+		return(0);
+	}
+}
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////
+// glreplayer.h
+// ============
+// read recorded OpenGL command logs back, command by command
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GLCommandLog.h"
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/***********************************************************
+ *  GLReplayer
+ *
+ *  This class maps a log written by the GLRecorder class and
+ *  replays its commands, in the order they were recorded,
+ *  into a handler.  Handlers keep whatever state they need
+ *  to analyze the command stream, so a log can be studied
+ *  without an OpenGL context.
+ ***********************************************************/
+class GLReplayer
+{
+public:
+	// one decoded command - payload points to the payload
+	// struct matching the command, and value to the value of
+	// uniform commands
+	struct REPLAY_COMMAND
+	{
+		LOG_COMMAND command;
+		const void* payload;
+		const void* value;
+	};
+
+	// receiver of the replayed commands
+	class Handler
+	{
+	public:
+		virtual ~Handler() {}
+		virtual void Execute(const REPLAY_COMMAND& command) = 0;
+	};
+
+	// constructor
+	GLReplayer();
+	// destructor
+	~GLReplayer();
+
+	// map a log file and check its header
+	bool Open(const std::string& filename);
+	// release the log file
+	void Close();
+	// pass every command of the log to the handler, returning
+	// false when the log ends in the middle of a record
+	bool Replay(Handler& handler);
+
+	// name of a command, for printing logs
+	static const char* GetCommandName(LOG_COMMAND command);
+	// size of the payload struct of a command
+	static size_t GetPayloadSize(LOG_COMMAND command);
+
+private:
+	MappedFile m_file;
+};
@@ -0,0 +1,400 @@
+///////////////////////////////////////////////////////////////////////////////
+// glstatecache.cpp
+// ============
+// shadow the bound OpenGL state and drop redundant state changes
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GLStateCache.h"
+#include "GLRecorder.h"
+
+// declaration of the global variables and defines
+namespace
+{
+	// shadow value of state that is not known
+	const GLuint UNKNOWN_STATE = 0xFFFFFFFF;
+
+	// texture units, texture targets, caps, buffer targets and
+	// indexed binding points that are shadowed - calls for any
+	// others go straight through
+	const int MAX_CACHED_TEXTURE_UNITS = 32;
+	const GLenum CACHED_TEXTURE_TARGETS[] = { GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY };
+	const GLenum CACHED_CAPABILITIES[] = { GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST };
+	// the element array binding belongs to the vertex array,
+	// so it is not shadowed
+	const GLenum CACHED_BUFFER_TARGETS[] = { GL_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER };
+	const GLenum CACHED_INDEXED_TARGETS[] = { GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER };
+	const int MAX_CACHED_BINDINGS = 16;
+
+	const int TEXTURE_TARGET_COUNT = sizeof(CACHED_TEXTURE_TARGETS) / sizeof(CACHED_TEXTURE_TARGETS[0]);
+	const int CAPABILITY_COUNT = sizeof(CACHED_CAPABILITIES) / sizeof(CACHED_CAPABILITIES[0]);
+	const int BUFFER_TARGET_COUNT = sizeof(CACHED_BUFFER_TARGETS) / sizeof(CACHED_BUFFER_TARGETS[0]);
+	const int INDEXED_TARGET_COUNT = sizeof(CACHED_INDEXED_TARGETS) / sizeof(CACHED_INDEXED_TARGETS[0]);
+
+	// shadowed state - caps hold GL_TRUE or GL_FALSE
+	GLuint g_Program = UNKNOWN_STATE;
+	GLuint g_ActiveTexture = UNKNOWN_STATE;
+	GLuint g_Textures[MAX_CACHED_TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+	GLuint g_Capabilities[CAPABILITY_COUNT];
+	GLuint g_BlendSource = UNKNOWN_STATE;
+	GLuint g_BlendDestination = UNKNOWN_STATE;
+	GLuint g_Buffers[BUFFER_TARGET_COUNT];
+	GLuint g_IndexedBuffers[INDEXED_TARGET_COUNT][MAX_CACHED_BINDINGS];
+	GLuint g_VertexArray = UNKNOWN_STATE;
+	bool g_bInitialized = false;
+
+	GLStateCache::STATE_STATS g_Stats = { 0, 0 };
+
+	// index of a value in a list, or -1 when it is not there
+	int FindIndex(const GLenum* values, int count, GLenum value)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (values[i] == value)
+			{
+				return(i);
+			}
+		}
+		return(-1);
+	}
+
+	// set every shadow matching a deleted name to unknown
+	void ForgetName(GLuint* shadows, int count, GLuint name)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (shadows[i] == name)
+			{
+				shadows[i] = UNKNOWN_STATE;
+			}
+		}
+	}
+
+	// the shadow arrays start out unknown
+	void InitializeShadows()
+	{
+		if (g_bInitialized == false)
+		{
+			GLStateCache::Invalidate();
+		}
+	}
+}
+
+/***********************************************************
+ *  UseProgram()
+ *
+ *  This method is used for making a shader program current.
+ ***********************************************************/
+void GLStateCache::UseProgram(GLuint program)
+{
+	if (Update(g_Program, program) == true)
+	{
+		GLRecorder::UseProgram(program);
+	}
+}
+
+/***********************************************************
+ *  ActiveTexture()
+ *
+ *  This method is used for selecting the texture unit that
+ *  the next texture binds apply to.
+ ***********************************************************/
+void GLStateCache::ActiveTexture(GLenum unit)
+{
+	if (Update(g_ActiveTexture, unit) == true)
+	{
+		GLRecorder::ActiveTexture(unit);
+	}
+}
+
+/***********************************************************
+ *  BindTexture()
+ *
+ *  This method is used for binding a texture to a target of
+ *  the active texture unit.
+ ***********************************************************/
+void GLStateCache::BindTexture(GLenum target, GLuint texture)
+{
+	InitializeShadows();
+
+	int unit = (g_ActiveTexture != UNKNOWN_STATE) ? (int)(g_ActiveTexture - GL_TEXTURE0) : -1;
+	int targetIndex = FindIndex(CACHED_TEXTURE_TARGETS, TEXTURE_TARGET_COUNT, target);
+	if ((unit < 0) || (unit >= MAX_CACHED_TEXTURE_UNITS) || (targetIndex < 0))
+	{
+		g_Stats.issued++;
+		GLRecorder::BindTexture(target, texture);
+		return;
+	}
+
+	if (Update(g_Textures[unit][targetIndex], texture) == true)
+	{
+		GLRecorder::BindTexture(target, texture);
+	}
+}
+
+/***********************************************************
+ *  Enable()
+ *
+ *  This method is used for enabling an OpenGL capability.
+ ***********************************************************/
+void GLStateCache::Enable(GLenum capability)
+{
+	InitializeShadows();
+
+	int index = FindIndex(CACHED_CAPABILITIES, CAPABILITY_COUNT, capability);
+	if (index < 0)
+	{
+		g_Stats.issued++;
+		GLRecorder::Enable(capability);
+		return;
+	}
+
+	if (Update(g_Capabilities[index], GL_TRUE) == true)
+	{
+		GLRecorder::Enable(capability);
+	}
+}
+
+/***********************************************************
+ *  BlendFunc()
+ *
+ *  This method is used for setting the factors that blend
+ *  the drawn colors with the framebuffer.
+ ***********************************************************/
+void GLStateCache::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+{
+	if ((g_BlendSource == sourceFactor) && (g_BlendDestination == destinationFactor))
+	{
+		g_Stats.elided++;
+		return;
+	}
+
+	g_Stats.issued++;
+	g_BlendSource = sourceFactor;
+	g_BlendDestination = destinationFactor;
+	glBlendFunc(sourceFactor, destinationFactor);
+}
+
+/***********************************************************
+ *  BindBuffer()
+ *
+ *  This method is used for binding a buffer to the generic
+ *  binding point of a target.
+ ***********************************************************/
+void GLStateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+	InitializeShadows();
+
+	int index = FindIndex(CACHED_BUFFER_TARGETS, BUFFER_TARGET_COUNT, target);
+	if (index < 0)
+	{
+		g_Stats.issued++;
+		GLRecorder::BindBuffer(target, buffer);
+		return;
+	}
+
+	if (Update(g_Buffers[index], buffer) == true)
+	{
+		GLRecorder::BindBuffer(target, buffer);
+	}
+}
+
+/***********************************************************
+ *  BindBufferBase()
+ *
+ *  This method is used for binding a buffer to an indexed
+ *  binding point of a target, which also binds it to the
+ *  generic binding point.
+ ***********************************************************/
+void GLStateCache::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	InitializeShadows();
+
+	int targetIndex = FindIndex(CACHED_INDEXED_TARGETS, INDEXED_TARGET_COUNT, target);
+	int genericIndex = FindIndex(CACHED_BUFFER_TARGETS, BUFFER_TARGET_COUNT, target);
+	if ((targetIndex < 0) || (index >= (GLuint)MAX_CACHED_BINDINGS))
+	{
+		g_Stats.issued++;
+		GLRecorder::BindBufferBase(target, index, buffer);
+		if (genericIndex >= 0)
+		{
+			g_Buffers[genericIndex] = buffer;
+		}
+		return;
+	}
+
+	// the generic binding is also set by the call, so it can
+	// only be skipped when both bindings already match
+	if ((g_IndexedBuffers[targetIndex][index] == buffer) &&
+		((genericIndex < 0) || (g_Buffers[genericIndex] == buffer)))
+	{
+		g_Stats.elided++;
+		return;
+	}
+
+	g_Stats.issued++;
+	g_IndexedBuffers[targetIndex][index] = buffer;
+	if (genericIndex >= 0)
+	{
+		g_Buffers[genericIndex] = buffer;
+	}
+	GLRecorder::BindBufferBase(target, index, buffer);
+}
+
+/***********************************************************
+ *  BindVertexArray()
+ *
+ *  This method is used for binding a vertex array object.
+ ***********************************************************/
+void GLStateCache::BindVertexArray(GLuint vertexArray)
+{
+	if (Update(g_VertexArray, vertexArray) == true)
+	{
+		GLRecorder::BindVertexArray(vertexArray);
+	}
+}
+
+/***********************************************************
+ *  DeleteBuffers()
+ *
+ *  This method is used for deleting buffers.  OpenGL unbinds
+ *  deleted buffers, and may hand their names out again, so
+ *  the bindings of the deleted names become unknown.
+ ***********************************************************/
+void GLStateCache::DeleteBuffers(GLsizei count, const GLuint* buffers)
+{
+	InitializeShadows();
+
+	for (GLsizei i = 0; i < count; i++)
+	{
+		ForgetName(g_Buffers, BUFFER_TARGET_COUNT, buffers[i]);
+		ForgetName(&g_IndexedBuffers[0][0], INDEXED_TARGET_COUNT * MAX_CACHED_BINDINGS, buffers[i]);
+	}
+	glDeleteBuffers(count, buffers);
+}
+
+/***********************************************************
+ *  DeleteTextures()
+ *
+ *  This method is used for deleting textures, forgetting the
+ *  texture units they were bound to.
+ ***********************************************************/
+void GLStateCache::DeleteTextures(GLsizei count, const GLuint* textures)
+{
+	InitializeShadows();
+
+	for (GLsizei i = 0; i < count; i++)
+	{
+		ForgetName(&g_Textures[0][0], MAX_CACHED_TEXTURE_UNITS * TEXTURE_TARGET_COUNT, textures[i]);
+	}
+	glDeleteTextures(count, textures);
+}
+
+/***********************************************************
+ *  DeleteVertexArrays()
+ *
+ *  This method is used for deleting vertex array objects.
+ ***********************************************************/
+void GLStateCache::DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays)
+{
+	for (GLsizei i = 0; i < count; i++)
+	{
+		ForgetName(&g_VertexArray, 1, vertexArrays[i]);
+	}
+	glDeleteVertexArrays(count, vertexArrays);
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for forgetting all the shadowed
+ *  state, so the next call of each kind goes through.
+ ***********************************************************/
+void GLStateCache::Invalidate()
+{
+	g_Program = UNKNOWN_STATE;
+	g_ActiveTexture = UNKNOWN_STATE;
+	for (int i = 0; i < MAX_CACHED_TEXTURE_UNITS; i++)
+	{
+		for (int j = 0; j < TEXTURE_TARGET_COUNT; j++)
+		{
+			g_Textures[i][j] = UNKNOWN_STATE;
+		}
+	}
+	for (int i = 0; i < CAPABILITY_COUNT; i++)
+	{
+		g_Capabilities[i] = UNKNOWN_STATE;
+	}
+	g_BlendSource = UNKNOWN_STATE;
+	g_BlendDestination = UNKNOWN_STATE;
+	for (int i = 0; i < BUFFER_TARGET_COUNT; i++)
+	{
+		g_Buffers[i] = UNKNOWN_STATE;
+	}
+	for (int i = 0; i < INDEXED_TARGET_COUNT; i++)
+	{
+		for (int j = 0; j < MAX_CACHED_BINDINGS; j++)
+		{
+			g_IndexedBuffers[i][j] = UNKNOWN_STATE;
+		}
+	}
+	g_VertexArray = UNKNOWN_STATE;
+	g_bInitialized = true;
+}
+
+/***********************************************************
+ *  InvalidateVertexState()
+ *
+ *  This method is used for forgetting the vertex array and
+ *  array buffer bindings.
+ ***********************************************************/
+void GLStateCache::InvalidateVertexState()
+{
+	InitializeShadows();
+
+	g_VertexArray = UNKNOWN_STATE;
+	g_Buffers[FindIndex(CACHED_BUFFER_TARGETS, BUFFER_TARGET_COUNT, GL_ARRAY_BUFFER)] = UNKNOWN_STATE;
+}
+
+/***********************************************************
+ *  GetStats()
+ *
+ *  This method is used for getting the number of state
+ *  changes made and skipped since the counters were reset.
+ ***********************************************************/
+const GLStateCache::STATE_STATS& GLStateCache::GetStats()
+{
+	return(g_Stats);
+}
+
+/***********************************************************
+ *  ResetStats()
+ *
+ *  This method is used for resetting the counters.
+ ***********************************************************/
+void GLStateCache::ResetStats()
+{
+	g_Stats.issued = 0;
+	g_Stats.elided = 0;
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for comparing a state change with
+ *  its shadow, storing the new value and counting the call.
+ ***********************************************************/
+bool GLStateCache::Update(GLuint& shadow, GLuint value)
+{
+	if (shadow == value)
+	{
+		g_Stats.elided++;
+		return(false);
+	}
+
+	g_Stats.issued++;
+	shadow = value;
+	return(true);
+}
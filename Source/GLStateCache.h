@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////
+// glstatecache.h
+// ============
+// shadow the bound OpenGL state and drop redundant state changes
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  GLStateCache
+ *
+ *  This class keeps a shadow copy of the OpenGL state that
+ *  is changed while drawing - the program in use, the active
+ *  texture unit and its bound textures, the enabled caps,
+ *  the blend function, the buffers bound to the generic and
+ *  indexed binding points and the vertex array - and skips
+ *  calls that would set the state to the value it already
+ *  has.  The calls that are made go through the GLRecorder
+ *  layer.  Uniform values are shadowed by the UniformCache.
+ *
+ *  State starts out unknown, so the first call always goes
+ *  through.  Code changing the shadowed state behind the
+ *  cache, such as the ShapeMeshes draws, must invalidate it,
+ *  and objects must be deleted through the cache so their
+ *  names can be reused safely.
+ ***********************************************************/
+class GLStateCache
+{
+public:
+	struct STATE_STATS
+	{
+		unsigned int issued;
+		unsigned int elided;
+	};
+
+	// shadowed state changes
+	static void UseProgram(GLuint program);
+	static void ActiveTexture(GLenum unit);
+	static void BindTexture(GLenum target, GLuint texture);
+	static void Enable(GLenum capability);
+	static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+	static void BindBuffer(GLenum target, GLuint buffer);
+	static void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+	static void BindVertexArray(GLuint vertexArray);
+
+	// delete objects, forgetting where they were bound
+	static void DeleteBuffers(GLsizei count, const GLuint* buffers);
+	static void DeleteTextures(GLsizei count, const GLuint* textures);
+	static void DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays);
+
+	// forget all the shadowed state
+	static void Invalidate();
+	// forget the vertex array and array buffer bindings, after
+	// code outside the cache has bound its own
+	static void InvalidateVertexState();
+
+	// counters of the state changes made and skipped
+	static const STATE_STATS& GetStats();
+	static void ResetStats();
+
+private:
+	// count a call, returning true when it must be made
+	static bool Update(GLuint& shadow, GLuint value);
+};
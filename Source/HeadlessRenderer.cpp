@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+// headlessrenderer.cpp
+// ============
+// render batches of frames into an offscreen framebuffer
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HeadlessRenderer.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+/***********************************************************
+ *  HeadlessRenderer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+HeadlessRenderer::HeadlessRenderer(ViewManager* pViewManager, SceneManager* pSceneManager, FrameProfiler* pProfiler)
+{
+	m_pViewManager = pViewManager;
+	m_pSceneManager = pSceneManager;
+	m_pProfiler = pProfiler;
+	m_framebuffer = 0;
+	m_colorBuffer = 0;
+	m_depthBuffer = 0;
+	m_width = 0;
+	m_height = 0;
+	m_runTime = 0.0;
+}
+
+/***********************************************************
+ *  ~HeadlessRenderer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+HeadlessRenderer::~HeadlessRenderer()
+{
+	DestroyFramebuffer();
+	m_pViewManager = NULL;
+	m_pSceneManager = NULL;
+	m_pProfiler = NULL;
+}
+
+/***********************************************************
+ *  CreateFramebuffer()
+ *
+ *  This method is used for creating the offscreen
+ *  framebuffer with a color and a depth renderbuffer.
+ ***********************************************************/
+bool HeadlessRenderer::CreateFramebuffer(int width, int height)
+{
+	DestroyFramebuffer();
+
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Could not create the offscreen framebuffer, status:" << status << std::endl;
+		DestroyFramebuffer();
+		return(false);
+	}
+
+	m_width = width;
+	m_height = height;
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyFramebuffer()
+ *
+ *  This method is used for freeing the offscreen
+ *  framebuffer and its renderbuffers.
+ ***********************************************************/
+void HeadlessRenderer::DestroyFramebuffer()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_colorBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_colorBuffer);
+		m_colorBuffer = 0;
+	}
+	if (m_depthBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_depthBuffer = 0;
+	}
+	m_width = 0;
+	m_height = 0;
+}
+
+/***********************************************************
+ *  Run()
+ *
+ *  This method is used for loading the camera path file
+ *  named in the options, if any, and rendering the frames
+ *  along it.
+ ***********************************************************/
+bool HeadlessRenderer::Run(const HEADLESS_OPTIONS& options)
+{
+	CameraPath cameraPath;
+	if ((options.cameraPath.empty() == false) && (cameraPath.Load(options.cameraPath) == false))
+	{
+		return(false);
+	}
+
+	return(Run(options, cameraPath));
+}
+
+/***********************************************************
+ *  Run()
+ *
+ *  This method is used for rendering the requested number
+ *  of frames into the offscreen framebuffer along a camera
+ *  path that is already loaded, as the benchmark does with
+ *  the path it loads or generates for its scene.  The
+ *  camera is moved from the first key of the path on the
+ *  first frame to its last key on the last frame.  The
+ *  textures are all loaded before the first frame so every
+ *  frame shows the finished scene.  Frames are read back and
+ *  written while the following frames render, and the
+ *  timing includes writing the last of them.
+ ***********************************************************/
+bool HeadlessRenderer::Run(const HEADLESS_OPTIONS& options, const CameraPath& cameraPath)
+{
+	if (options.outputDirectory.empty() == false)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(options.outputDirectory, error);
+	}
+
+	if (CreateFramebuffer(options.width, options.height) == false)
+	{
+		return(false);
+	}
+
+	m_pViewManager->SetViewSize(m_width, m_height);
+	m_pSceneManager->FinishTextureLoads();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, m_width, m_height);
+
+	bool bWriteFrames = (options.outputDirectory.empty() == false);
+	if (bWriteFrames == true)
+	{
+		m_readback.Start(m_width, m_height, options.format);
+	}
+
+	int prepareViewScope = -1;
+	int renderSceneScope = -1;
+	int readbackScope = -1;
+	if (m_pProfiler != NULL)
+	{
+		prepareViewScope = m_pProfiler->RegisterScope("PrepareSceneView");
+		renderSceneScope = m_pProfiler->RegisterScope("RenderScene");
+		readbackScope = m_pProfiler->RegisterScope("Frame Readback");
+	}
+
+	bool bSuccess = true;
+	m_frameTimes.clear();
+	m_frameTimes.reserve(options.frameCount);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (int frame = 0; frame < options.frameCount; frame++)
+	{
+		std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+		if (m_pProfiler != NULL)
+		{
+			m_pProfiler->BeginFrame();
+		}
+		GLRecorder::BeginFrame();
+
+		if (cameraPath.IsEmpty() == false)
+		{
+			glm::vec3 position;
+			glm::vec3 front;
+			float pathPosition = 0.0f;
+			if (options.frameCount > 1)
+			{
+				pathPosition = (float)frame / (float)(options.frameCount - 1);
+			}
+			cameraPath.Sample(pathPosition, position, front);
+			m_pViewManager->SetCameraPose(position, front);
+		}
+
+		// Enable z-depth
+		GLStateCache::Enable(GL_DEPTH_TEST);
+
+		// Clear the frame and z buffers
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		GLRecorder::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// convert from 3D object space to 2D view
+		{
+			ProfileScope scope(m_pProfiler, prepareViewScope);
+			m_pViewManager->PrepareSceneView();
+			m_pSceneManager->SetCameraView(
+				m_pViewManager->GetViewMatrix(),
+				m_pViewManager->GetProjectionMatrix(),
+				m_pViewManager->GetViewPosition());
+		}
+
+		// render the 3D scene into the offscreen framebuffer
+		{
+			ProfileScope scope(m_pProfiler, renderSceneScope);
+			m_pSceneManager->RenderScene();
+		}
+
+		if (bWriteFrames == true)
+		{
+			ProfileScope scope(m_pProfiler, readbackScope);
+			char filename[32];
+			snprintf(filename, sizeof(filename), "frame_%05d%s", frame, ImageEncoder::GetExtension(options.format));
+			m_readback.ReadFrame((std::filesystem::path(options.outputDirectory) / filename).string());
+		}
+
+		if (m_pProfiler != NULL)
+		{
+			m_pProfiler->EndFrame();
+		}
+
+		m_frameTimes.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+	}
+
+	// wait for the last frame so it is included in the timing
+	if (bWriteFrames == true)
+	{
+		bSuccess = m_readback.Stop();
+	}
+	glFinish();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	m_runTime = seconds;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	DestroyFramebuffer();
+
+	if (seconds > 0.0)
+	{
+		std::cout << "Rendered " << options.frameCount << " frames in " << seconds << " seconds, " <<
+			(options.frameCount / seconds) << " frames/second" << std::endl;
+	}
+
+	return(bSuccess);
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// headlessrenderer.h
+// ============
+// render batches of frames into an offscreen framebuffer
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CameraPath.h"
+#include "FrameReadback.h"
+#include "SceneManager.h"
+#include "ViewManager.h"
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  HeadlessRenderer
+ *
+ *  This class renders a number of frames of the 3D scene
+ *  into an offscreen framebuffer instead of the display
+ *  window, optionally moving the camera along a camera path,
+ *  and writes every frame to an image file through an
+ *  asynchronous frame readback.  It is used for
+ *  thumbnails and regression frames on machines without a
+ *  display, including software OpenGL implementations.
+ ***********************************************************/
+class HeadlessRenderer
+{
+public:
+	// constructor
+	HeadlessRenderer(ViewManager* pViewManager, SceneManager* pSceneManager, FrameProfiler* pProfiler = NULL);
+	// destructor
+	~HeadlessRenderer();
+
+	// default size of the rendered frames
+	static const int DEFAULT_WIDTH = 1250;
+	static const int DEFAULT_HEIGHT = 800;
+
+	struct HEADLESS_OPTIONS
+	{
+		int frameCount = 1;
+		int width = DEFAULT_WIDTH;
+		int height = DEFAULT_HEIGHT;
+		// camera path file, or empty to keep the default camera
+		std::string cameraPath;
+		// directory for the frame images, or empty to only
+		// measure the rendering speed
+		std::string outputDirectory;
+		ImageEncoder::IMAGE_FORMAT format = ImageEncoder::FORMAT_PNG;
+	};
+
+	// render the frames and report the frame rate
+	bool Run(const HEADLESS_OPTIONS& options);
+	// render the frames along a camera path already in memory,
+	// ignoring the camera path file of the options
+	bool Run(const HEADLESS_OPTIONS& options, const CameraPath& cameraPath);
+	// CPU time spent submitting each frame of the last run,
+	// in milliseconds
+	const std::vector<float>& GetFrameTimes() const { return(m_frameTimes); }
+	// total time of the last run, including waiting for the
+	// GPU and the frame images, in seconds
+	double GetRunTime() const { return(m_runTime); }
+
+private:
+	// pointer to the view manager object
+	ViewManager* m_pViewManager;
+	// pointer to the scene manager object
+	SceneManager* m_pSceneManager;
+	// profiler timing the frames, or NULL
+	FrameProfiler* m_pProfiler;
+	// offscreen framebuffer and its attachments
+	GLuint m_framebuffer;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+	int m_width;
+	int m_height;
+	// copies the frames back and writes them on encoder threads
+	FrameReadback m_readback;
+	// timing of the last run
+	std::vector<float> m_frameTimes;
+	double m_runTime;
+
+	// create the offscreen framebuffer
+	bool CreateFramebuffer(int width, int height);
+	// free the offscreen framebuffer
+	void DestroyFramebuffer();
+};
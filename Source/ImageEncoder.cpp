@@ -0,0 +1,429 @@
+///////////////////////////////////////////////////////////////////////////////
+// imageencoder.cpp
+// ============
+// encode rendered frames into PNG and PPM image files
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ImageEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// bytes per pixel read back from OpenGL and written out
+	const int SOURCE_CHANNELS = 4;
+	const int IMAGE_CHANNELS = 3;
+
+	// deflate window and match limits
+	const int WINDOW_SIZE = 32768;
+	const int MIN_MATCH = 3;
+	const int MAX_MATCH = 258;
+	const int HASH_BITS = 15;
+
+	// deflate length and distance codes, starting at symbol 257
+	// and distance code 0
+	const uint16_t LENGTH_BASE[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const uint8_t LENGTH_EXTRA[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const uint16_t DISTANCE_BASE[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const uint8_t DISTANCE_EXTRA[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	/***********************************************************
+	 *  BitWriter
+	 *
+	 *  Appends values to a byte stream least significant bit
+	 *  first, as deflate stores them.
+	 ***********************************************************/
+	struct BitWriter
+	{
+		std::vector<unsigned char>& bytes;
+		uint32_t buffer = 0;
+		int count = 0;
+
+		BitWriter(std::vector<unsigned char>& output) : bytes(output) {}
+
+		void Write(uint32_t value, int bits)
+		{
+			buffer |= value << count;
+			count += bits;
+			while (count >= 8)
+			{
+				bytes.push_back((unsigned char)(buffer & 0xFF));
+				buffer >>= 8;
+				count -= 8;
+			}
+		}
+
+		// Huffman codes are stored most significant bit first
+		void WriteCode(uint32_t code, int bits)
+		{
+			uint32_t reversed = 0;
+			for (int i = 0; i < bits; i++)
+			{
+				reversed = (reversed << 1) | ((code >> i) & 1);
+			}
+			Write(reversed, bits);
+		}
+
+		void Flush()
+		{
+			if (count > 0)
+			{
+				bytes.push_back((unsigned char)(buffer & 0xFF));
+			}
+			buffer = 0;
+			count = 0;
+		}
+	};
+
+	// write a literal or length symbol with the fixed Huffman codes
+	void WriteSymbol(BitWriter& writer, int symbol)
+	{
+		if (symbol < 144)
+		{
+			writer.WriteCode(0x30 + symbol, 8);
+		}
+		else if (symbol < 256)
+		{
+			writer.WriteCode(0x190 + symbol - 144, 9);
+		}
+		else if (symbol < 280)
+		{
+			writer.WriteCode(symbol - 256, 7);
+		}
+		else
+		{
+			writer.WriteCode(0xC0 + symbol - 280, 8);
+		}
+	}
+
+	// write a match as its length and distance codes
+	void WriteMatch(BitWriter& writer, int length, int distance)
+	{
+		int code = 28;
+		while (LENGTH_BASE[code] > length)
+		{
+			code--;
+		}
+		WriteSymbol(writer, 257 + code);
+		writer.Write(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+		code = 29;
+		while (DISTANCE_BASE[code] > distance)
+		{
+			code--;
+		}
+		writer.WriteCode(code, 5);
+		writer.Write(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+	}
+
+	std::array<uint32_t, 256> BuildCrcTable()
+	{
+		std::array<uint32_t, 256> table;
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+			}
+			table[i] = value;
+		}
+		return(table);
+	}
+
+	uint32_t Crc32(uint32_t crc, const unsigned char* data, size_t size)
+	{
+		// built once, on first use by any encoder thread
+		static const std::array<uint32_t, 256> table = BuildCrcTable();
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++)
+		{
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		}
+		return(~crc);
+	}
+
+	uint32_t Adler32(const unsigned char* data, size_t size)
+	{
+		uint32_t a = 1;
+		uint32_t b = 0;
+		while (size > 0)
+		{
+			// sums stay below 2^32 for 5552 bytes between reductions
+			size_t block = (size < 5552) ? size : 5552;
+			for (size_t i = 0; i < block; i++)
+			{
+				a += data[i];
+				b += a;
+			}
+			a %= 65521;
+			b %= 65521;
+			data += block;
+			size -= block;
+		}
+		return((b << 16) | a);
+	}
+
+	// hash of the three bytes starting a possible match
+	uint32_t Hash(const unsigned char* bytes)
+	{
+		uint32_t value = ((uint32_t)bytes[0] << 16) | ((uint32_t)bytes[1] << 8) | bytes[2];
+		return((value * 2654435761u) >> (32 - HASH_BITS));
+	}
+
+	void AppendBigEndian(std::vector<unsigned char>& bytes, uint32_t value)
+	{
+		bytes.push_back((unsigned char)(value >> 24));
+		bytes.push_back((unsigned char)(value >> 16));
+		bytes.push_back((unsigned char)(value >> 8));
+		bytes.push_back((unsigned char)value);
+	}
+}
+
+/***********************************************************
+ *  Encode()
+ *
+ *  This method is used for encoding RGBA pixels, bottom row
+ *  first, into the bytes of an image file in the passed in
+ *  format.
+ ***********************************************************/
+void ImageEncoder::Encode(
+	IMAGE_FORMAT format,
+	const unsigned char* pixels,
+	int width,
+	int height,
+	std::vector<unsigned char>& image)
+{
+	image.clear();
+	if (format == FORMAT_PNG)
+	{
+		EncodePNG(pixels, width, height, image);
+	}
+	else
+	{
+		EncodePPM(pixels, width, height, image);
+	}
+}
+
+/***********************************************************
+ *  WriteFile()
+ *
+ *  This method is used for writing the bytes of an encoded
+ *  image to a file.
+ ***********************************************************/
+bool ImageEncoder::WriteFile(const std::string& filename, const std::vector<unsigned char>& image)
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "Could not write image:" << filename << std::endl;
+		return(false);
+	}
+
+	file.write((const char*)image.data(), image.size());
+	return(file.good());
+}
+
+/***********************************************************
+ *  GetExtension()
+ *
+ *  This method is used for getting the file extension of an
+ *  image format.
+ ***********************************************************/
+const char* ImageEncoder::GetExtension(IMAGE_FORMAT format)
+{
+	return((format == FORMAT_PNG) ? ".png" : ".ppm");
+}
+
+/***********************************************************
+ *  EncodePPM()
+ *
+ *  This method is used for encoding the pixels as a binary
+ *  PPM image.
+ ***********************************************************/
+void ImageEncoder::EncodePPM(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& image)
+{
+	char header[64];
+	int headerSize = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", width, height);
+	image.reserve(headerSize + (size_t)width * height * IMAGE_CHANNELS);
+	image.insert(image.end(), header, header + headerSize);
+
+	for (int row = height - 1; row >= 0; row--)
+	{
+		const unsigned char* source = pixels + (size_t)row * width * SOURCE_CHANNELS;
+		for (int x = 0; x < width; x++)
+		{
+			image.push_back(source[0]);
+			image.push_back(source[1]);
+			image.push_back(source[2]);
+			source += SOURCE_CHANNELS;
+		}
+	}
+}
+
+/***********************************************************
+ *  EncodePNG()
+ *
+ *  This method is used for encoding the pixels as an RGB PNG
+ *  image.  Every row uses the Up filter, storing its
+ *  difference from the row above, which leaves long runs of
+ *  zeros on the smooth surfaces of rendered frames for the
+ *  compressor to find.
+ ***********************************************************/
+void ImageEncoder::EncodePNG(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& image)
+{
+	const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	image.insert(image.end(), SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+
+	// 8-bit RGB, default compression and filtering, no interlace
+	std::vector<unsigned char> header;
+	AppendBigEndian(header, (uint32_t)width);
+	AppendBigEndian(header, (uint32_t)height);
+	header.push_back(8);
+	header.push_back(2);
+	header.push_back(0);
+	header.push_back(0);
+	header.push_back(0);
+	AddChunk(image, "IHDR", header.data(), (uint32_t)header.size());
+
+	// filtered rows, top row first
+	size_t rowSize = (size_t)width * IMAGE_CHANNELS;
+	std::vector<unsigned char> filtered((rowSize + 1) * height);
+	unsigned char* output = filtered.data();
+	for (int y = 0; y < height; y++)
+	{
+		const unsigned char* source = pixels + (size_t)(height - 1 - y) * width * SOURCE_CHANNELS;
+		const unsigned char* above = source + (size_t)width * SOURCE_CHANNELS;
+
+		*output++ = (y == 0) ? 0 : 2;
+		for (int x = 0; x < width; x++)
+		{
+			for (int channel = 0; channel < IMAGE_CHANNELS; channel++)
+			{
+				unsigned char value = source[channel];
+				if (y > 0)
+				{
+					value = (unsigned char)(value - above[channel]);
+				}
+				*output++ = value;
+			}
+			source += SOURCE_CHANNELS;
+			above += SOURCE_CHANNELS;
+		}
+	}
+
+	std::vector<unsigned char> stream;
+	Deflate(filtered, stream);
+	AddChunk(image, "IDAT", stream.data(), (uint32_t)stream.size());
+	AddChunk(image, "IEND", NULL, 0);
+}
+
+/***********************************************************
+ *  Deflate()
+ *
+ *  This method is used for compressing data into a zlib
+ *  stream made of one block using the fixed Huffman codes.
+ *  Matches are found through a hash of the next three bytes
+ *  that remembers only the latest position of each hash,
+ *  trading some compression for a single lookup per byte.
+ ***********************************************************/
+void ImageEncoder::Deflate(const std::vector<unsigned char>& data, std::vector<unsigned char>& stream)
+{
+	stream.clear();
+	stream.reserve(data.size() / 4 + 64);
+
+	// zlib header for a 32K window and default compression
+	stream.push_back(0x78);
+	stream.push_back(0x9C);
+
+	BitWriter writer(stream);
+	// final block, fixed Huffman codes
+	writer.Write(1, 1);
+	writer.Write(1, 2);
+
+	std::vector<int> head((size_t)1 << HASH_BITS, -1);
+	const unsigned char* bytes = data.data();
+	int size = (int)data.size();
+	int position = 0;
+
+	while (position < size)
+	{
+		int length = 0;
+		int distance = 0;
+
+		if (position + MIN_MATCH <= size)
+		{
+			int candidate = head[Hash(bytes + position)];
+			head[Hash(bytes + position)] = position;
+			if ((candidate >= 0) && (position - candidate <= WINDOW_SIZE))
+			{
+				int limit = std::min(MAX_MATCH, size - position);
+				while ((length < limit) && (bytes[candidate + length] == bytes[position + length]))
+				{
+					length++;
+				}
+				distance = position - candidate;
+			}
+		}
+
+		if (length >= MIN_MATCH)
+		{
+			WriteMatch(writer, length, distance);
+
+			// remember the positions inside the match as well
+			int end = position + length;
+			for (position++; (position < end) && (position + MIN_MATCH <= size); position++)
+			{
+				head[Hash(bytes + position)] = position;
+			}
+			position = end;
+		}
+		else
+		{
+			WriteSymbol(writer, bytes[position]);
+			position++;
+		}
+	}
+
+	// end of block
+	WriteSymbol(writer, 256);
+	writer.Flush();
+
+	AppendBigEndian(stream, Adler32(bytes, data.size()));
+}
+
+/***********************************************************
+ *  AddChunk()
+ *
+ *  This method is used for appending a PNG chunk made of its
+ *  length, type, data and checksum.
+ ***********************************************************/
+void ImageEncoder::AddChunk(std::vector<unsigned char>& image, const char* type, const unsigned char* data, uint32_t size)
+{
+	AppendBigEndian(image, size);
+	size_t typeOffset = image.size();
+	image.insert(image.end(), type, type + 4);
+	if (size > 0)
+	{
+		image.insert(image.end(), data, data + size);
+	}
+	AppendBigEndian(image, Crc32(0, image.data() + typeOffset, size + 4));
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// imageencoder.h
+// ============
+// encode rendered frames into PNG and PPM image files
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  ImageEncoder
+ *
+ *  This class encodes 8-bit RGBA pixels, as read back from
+ *  OpenGL with the bottom row first, into RGB image files
+ *  with the top row first.  PNG images are compressed with
+ *  the fixed Huffman codes of deflate, which needs no code
+ *  tables in the file and keeps the encoder small and fast;
+ *  PPM images are the raw pixels behind a text header.
+ ***********************************************************/
+class ImageEncoder
+{
+public:
+	enum IMAGE_FORMAT
+	{
+		FORMAT_PNG,
+		FORMAT_PPM
+	};
+
+	// encode the pixels into the bytes of an image file
+	static void Encode(
+		IMAGE_FORMAT format,
+		const unsigned char* pixels,
+		int width,
+		int height,
+		std::vector<unsigned char>& image);
+	// write the bytes of an image file to disk
+	static bool WriteFile(const std::string& filename, const std::vector<unsigned char>& image);
+	// file extension of the format, including the dot
+	static const char* GetExtension(IMAGE_FORMAT format);
+
+private:
+	static void EncodePNG(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& image);
+	static void EncodePPM(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& image);
+	// compress data into a zlib stream
+	static void Deflate(const std::vector<unsigned char>& data, std::vector<unsigned char>& stream);
+	// append a PNG chunk with its length and checksum
+	static void AddChunk(std::vector<unsigned char>& image, const char* type, const unsigned char* data, uint32_t size);
+};
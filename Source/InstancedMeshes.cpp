@@ -0,0 +1,371 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedmeshes.cpp
+// ============
+// draw many copies of the basic 3D shapes with one draw call
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "InstancedMeshes.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// declaration of the vertex layout
+namespace
+{
+	// vertex shader attribute locations of the shape vertices
+	const GLuint POSITION_LOCATION = 0;
+	const GLuint NORMAL_LOCATION = 1;
+	const GLuint TEXCOORD_LOCATION = 2;
+}
+
+/***********************************************************
+ *  InstancedMeshes()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+InstancedMeshes::InstancedMeshes()
+{
+	for (int i = 0; i < MESH_COUNT; i++)
+	{
+		for (int level = 0; level < DETAIL_LEVELS; level++)
+		{
+			m_meshes[i][level].firstIndex = 0;
+			m_meshes[i][level].nIndices = 0;
+		}
+		m_detailLevelCounts[i] = 0;
+	}
+	m_vao = 0;
+	m_vbos[0] = 0;
+	m_vbos[1] = 0;
+	m_instanceBuffer = 0;
+	m_instanceBufferSize = 0;
+	m_indirectBuffer = 0;
+	m_indirectBufferSize = 0;
+	m_bLoaded = false;
+	m_bMultiDrawSupported = false;
+}
+
+/***********************************************************
+ *  ~InstancedMeshes()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+InstancedMeshes::~InstancedMeshes()
+{
+	DestroyMeshes();
+}
+
+/***********************************************************
+ *  LoadMeshes()
+ *
+ *  This method is used for generating every basic shape and
+ *  appending it to the shared vertex and index buffers, so
+ *  that switching between shapes needs no other vertex
+ *  array.  The round shapes are appended once per level of
+ *  detail, halving the segments from one level to the next,
+ *  while the flat shapes only have the one level.  The
+ *  indices are stored already offset to the first vertex of
+ *  their shape, so no base vertex is needed to draw them.
+ ***********************************************************/
+void InstancedMeshes::LoadMeshes(int segments)
+{
+	if (m_bLoaded == true)
+	{
+		return;
+	}
+
+	std::vector<float> vertices;
+	std::vector<uint32_t> indices;
+	ShapeGeometry::MESH_DATA data;
+	for (int i = 0; i < MESH_COUNT; i++)
+	{
+		m_detailLevelCounts[i] = (ShapeGeometry::IsRound((MESH_TYPE)i) == true) ? DETAIL_LEVELS : 1;
+		for (int level = 0; level < m_detailLevelCounts[i]; level++)
+		{
+			ShapeGeometry::Generate((MESH_TYPE)i, segments >> level, data);
+
+			uint32_t firstVertex = (uint32_t)(vertices.size() / ShapeGeometry::FLOATS_PER_VERTEX);
+			m_meshes[i][level].firstIndex = (GLuint)indices.size();
+			m_meshes[i][level].nIndices = (GLsizei)data.indices.size();
+
+			vertices.insert(vertices.end(), data.vertices.begin(), data.vertices.end());
+			for (size_t index = 0; index < data.indices.size(); index++)
+			{
+				indices.push_back(firstVertex + data.indices[index]);
+			}
+		}
+	}
+
+	glGenBuffers(1, &m_instanceBuffer);
+	CreateVertexArray(vertices, indices);
+
+	// the per-instance attributes of a queued draw start at its
+	// base instance, which needs the base instance extension too
+	m_bMultiDrawSupported = (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance);
+	if (m_bMultiDrawSupported == true)
+	{
+		glGenBuffers(1, &m_indirectBuffer);
+	}
+
+	m_bLoaded = true;
+}
+
+/***********************************************************
+ *  CreateVertexArray()
+ *
+ *  This method is used for creating the vertex array shared
+ *  by all the shapes, with the shape vertices in the first
+ *  three attributes and the per-instance data in the
+ *  following ones.
+ ***********************************************************/
+void InstancedMeshes::CreateVertexArray(const std::vector<float>& vertices, const std::vector<uint32_t>& indices)
+{
+	GLsizei stride = sizeof(float) * ShapeGeometry::FLOATS_PER_VERTEX;
+
+	glGenVertexArrays(1, &m_vao);
+	GLStateCache::BindVertexArray(m_vao);
+
+	// shape vertices and indices
+	glGenBuffers(2, m_vbos);
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_vbos[0]);
+	GLRecorder::BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vbos[1]);
+	GLRecorder::BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+
+	glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	glEnableVertexAttribArray(POSITION_LOCATION);
+	glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 3));
+	glEnableVertexAttribArray(NORMAL_LOCATION);
+	glVertexAttribPointer(TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 6));
+	glEnableVertexAttribArray(TEXCOORD_LOCATION);
+
+	// per-instance model matrix, one column per attribute location
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+	for (GLuint column = 0; column < 4; column++)
+	{
+		GLuint location = INSTANCE_MODEL_LOCATION + column;
+		glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(INSTANCE_DATA),
+			(void*)(offsetof(INSTANCE_DATA, model) + sizeof(glm::vec4) * column));
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+
+	// per-instance material index
+	glVertexAttribIPointer(INSTANCE_MATERIAL_LOCATION, 1, GL_INT, sizeof(INSTANCE_DATA),
+		(void*)offsetof(INSTANCE_DATA, materialIndex));
+	glEnableVertexAttribArray(INSTANCE_MATERIAL_LOCATION);
+	glVertexAttribDivisor(INSTANCE_MATERIAL_LOCATION, 1);
+
+	GLStateCache::BindVertexArray(0);
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  DestroyMeshes()
+ *
+ *  This method is used for freeing the vertex array and the
+ *  buffers of all the shapes.
+ ***********************************************************/
+void InstancedMeshes::DestroyMeshes()
+{
+	if (m_bLoaded == false)
+	{
+		return;
+	}
+
+	for (int i = 0; i < MESH_COUNT; i++)
+	{
+		for (int level = 0; level < DETAIL_LEVELS; level++)
+		{
+			m_meshes[i][level].firstIndex = 0;
+			m_meshes[i][level].nIndices = 0;
+		}
+		m_detailLevelCounts[i] = 0;
+	}
+	GLStateCache::DeleteVertexArrays(1, &m_vao);
+	GLStateCache::DeleteBuffers(2, m_vbos);
+	GLStateCache::DeleteBuffers(1, &m_instanceBuffer);
+	if (m_indirectBuffer != 0)
+	{
+		GLStateCache::DeleteBuffers(1, &m_indirectBuffer);
+	}
+	m_vao = 0;
+	m_instanceBuffer = 0;
+	m_instanceBufferSize = 0;
+	m_indirectBuffer = 0;
+	m_indirectBufferSize = 0;
+	m_drawCommands.clear();
+	m_instanceData.clear();
+	m_bLoaded = false;
+	m_bMultiDrawSupported = false;
+}
+
+/***********************************************************
+ *  GetMeshRange()
+ *
+ *  This method is used for getting the indices of a shape
+ *  at a level of detail.  Levels of detail the mesh does
+ *  not have are drawn with its least detailed one.
+ ***********************************************************/
+const InstancedMeshes::MESH_RANGE& InstancedMeshes::GetMeshRange(MESH_TYPE mesh, int detailLevel) const
+{
+	return(m_meshes[mesh][std::min(std::max(detailLevel, 0), m_detailLevelCounts[mesh] - 1)]);
+}
+
+/***********************************************************
+ *  AddInstances()
+ *
+ *  This method is used for appending the transforms and
+ *  material indices of instances to the staging memory.
+ ***********************************************************/
+void InstancedMeshes::AddInstances(const glm::mat4* transforms, const int* materialIndices, int count)
+{
+	size_t first = m_instanceData.size();
+	m_instanceData.resize(first + count);
+	for (int i = 0; i < count; i++)
+	{
+		m_instanceData[first + i].model = transforms[i];
+		m_instanceData[first + i].materialIndex = (NULL != materialIndices) ? materialIndices[i] : 0;
+	}
+}
+
+/***********************************************************
+ *  UploadBuffer()
+ *
+ *  This method is used for replacing the contents of a
+ *  buffer written every frame.  The buffer is grown with
+ *  room to spare when the data does not fit, and the
+ *  previous contents are orphaned so the driver does not
+ *  wait for earlier draws that are still reading them.
+ ***********************************************************/
+void InstancedMeshes::UploadBuffer(GLenum target, GLuint buffer, GLsizeiptr& bufferSize, GLsizeiptr size, const void* data)
+{
+	GLStateCache::BindBuffer(target, buffer);
+	if (size > bufferSize)
+	{
+		bufferSize = size * 2;
+	}
+	GLRecorder::BufferData(target, bufferSize, NULL, GL_STREAM_DRAW);
+	GLRecorder::BufferSubData(target, 0, size, data);
+}
+
+/***********************************************************
+ *  DrawInstanced()
+ *
+ *  This method is used for uploading the transforms and
+ *  material indices of all the instances and drawing them
+ *  with a single instanced draw call.
+ ***********************************************************/
+void InstancedMeshes::DrawInstanced(
+	MESH_TYPE mesh,
+	int detailLevel,
+	const glm::mat4* transforms,
+	const int* materialIndices,
+	int count)
+{
+	if ((m_bLoaded == false) || (count <= 0) || (mesh < 0) || (mesh >= MESH_COUNT))
+	{
+		return;
+	}
+
+	m_instanceData.clear();
+	AddInstances(transforms, materialIndices, count);
+	UploadBuffer(GL_ARRAY_BUFFER, m_instanceBuffer, m_instanceBufferSize,
+		sizeof(INSTANCE_DATA) * count, m_instanceData.data());
+	m_instanceData.clear();
+
+	// the instance buffer and vertex array are left bound, so
+	// the state cache can skip binding them again for the next
+	// instanced draw
+	const MESH_RANGE& range = GetMeshRange(mesh, detailLevel);
+	GLStateCache::BindVertexArray(m_vao);
+	GLRecorder::DrawElementsInstanced(GL_TRIANGLES, range.nIndices, GL_UNSIGNED_INT,
+		(void*)(sizeof(uint32_t) * range.firstIndex), count);
+}
+
+/***********************************************************
+ *  QueueDraw()
+ *
+ *  This method is used for queueing the instances of a mesh
+ *  as one draw command.  The instances of all the queued
+ *  draws are kept one after another, and each command
+ *  starts at its first instance through its base instance.
+ ***********************************************************/
+void InstancedMeshes::QueueDraw(
+	MESH_TYPE mesh,
+	int detailLevel,
+	const glm::mat4* transforms,
+	const int* materialIndices,
+	int count)
+{
+	if ((m_bLoaded == false) || (count <= 0) || (mesh < 0) || (mesh >= MESH_COUNT))
+	{
+		return;
+	}
+
+	const MESH_RANGE& range = GetMeshRange(mesh, detailLevel);
+	DRAW_COMMAND command;
+	command.count = (GLuint)range.nIndices;
+	command.instanceCount = (GLuint)count;
+	command.firstIndex = range.firstIndex;
+	command.baseVertex = 0;
+	command.baseInstance = (GLuint)m_instanceData.size();
+	m_drawCommands.push_back(command);
+
+	AddInstances(transforms, materialIndices, count);
+}
+
+/***********************************************************
+ *  SubmitQueuedDraws()
+ *
+ *  This method is used for uploading the instances and the
+ *  commands of all the queued draws, and drawing them with
+ *  one multi-draw indirect call.  Without multi-draw
+ *  support every command is drawn on its own, with its
+ *  instances uploaded just before it.  The queued draws
+ *  share the uniforms set when they are submitted, so they
+ *  must only differ by shape and per-instance data.
+ ***********************************************************/
+int InstancedMeshes::SubmitQueuedDraws()
+{
+	int drawCount = (int)m_drawCommands.size();
+	if (drawCount == 0)
+	{
+		return(0);
+	}
+
+	if (m_bMultiDrawSupported == false)
+	{
+		GLStateCache::BindVertexArray(m_vao);
+		for (int i = 0; i < drawCount; i++)
+		{
+			const DRAW_COMMAND& command = m_drawCommands[i];
+			UploadBuffer(GL_ARRAY_BUFFER, m_instanceBuffer, m_instanceBufferSize,
+				sizeof(INSTANCE_DATA) * command.instanceCount, &m_instanceData[command.baseInstance]);
+			GLRecorder::DrawElementsInstanced(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+				(void*)(sizeof(uint32_t) * command.firstIndex), command.instanceCount);
+		}
+
+		m_drawCommands.clear();
+		m_instanceData.clear();
+		return(drawCount);
+	}
+
+	UploadBuffer(GL_ARRAY_BUFFER, m_instanceBuffer, m_instanceBufferSize,
+		sizeof(INSTANCE_DATA) * m_instanceData.size(), m_instanceData.data());
+	UploadBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer, m_indirectBufferSize,
+		sizeof(DRAW_COMMAND) * m_drawCommands.size(), m_drawCommands.data());
+
+	GLStateCache::BindVertexArray(m_vao);
+	GLRecorder::MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)0, drawCount,
+		sizeof(DRAW_COMMAND), (GLsizei)m_instanceData.size());
+
+	m_drawCommands.clear();
+	m_instanceData.clear();
+	return(drawCount);
+}
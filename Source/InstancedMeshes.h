@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedmeshes.h
+// ============
+// draw many copies of the basic 3D shapes with one draw call
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RenderQueue.h"
+#include "ShapeGeometry.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  InstancedMeshes
+ *
+ *  This class keeps every basic shape in one shared vertex
+ *  and index buffer, read through a single vertex array with
+ *  an extra per-instance buffer holding a model matrix and a
+ *  material index for every copy, so that any number of
+ *  copies of a shape can be submitted with a single
+ *  instanced draw call.  The round shapes are loaded at
+ *  several levels of detail, each one with half the
+ *  segments of the previous one, for copies drawn small.
+ *
+ *  Where multi-draw indirect is supported, the instanced
+ *  draws of different shapes can also be queued and then
+ *  submitted together, the draw commands being written into
+ *  an indirect buffer and issued with one call.
+ ***********************************************************/
+class InstancedMeshes
+{
+public:
+	// constructor
+	InstancedMeshes();
+	// destructor
+	~InstancedMeshes();
+
+	// vertex shader attribute locations of the instance data -
+	// the model matrix takes four consecutive locations
+	static const GLuint INSTANCE_MODEL_LOCATION = 3;
+	static const GLuint INSTANCE_MATERIAL_LOCATION = 7;
+	// levels of detail of the round shapes, the first being the
+	// most detailed
+	static const int DETAIL_LEVELS = 3;
+
+	struct INSTANCE_DATA
+	{
+		glm::mat4 model;
+		GLint materialIndex;
+		GLint padding[3];
+	};
+
+	// generate the basic shapes and create their vertex arrays,
+	// with the passed in segments at the most detailed level
+	void LoadMeshes(int segments = ShapeGeometry::DEFAULT_SEGMENTS);
+	// free the created vertex arrays and buffers
+	void DestroyMeshes();
+	// true once the meshes have been loaded
+	bool IsLoaded() const { return(m_bLoaded); }
+	// number of levels of detail loaded for a mesh
+	int GetDetailLevelCount(MESH_TYPE mesh) const { return(m_detailLevelCounts[mesh]); }
+
+	// draw all the passed in instances of a mesh with one call,
+	// at one of its levels of detail - any queued draws must be
+	// submitted first
+	void DrawInstanced(
+		MESH_TYPE mesh,
+		int detailLevel,
+		const glm::mat4* transforms,
+		const int* materialIndices,
+		int count);
+
+	// true if queued draws can be submitted with one call
+	bool IsMultiDrawSupported() const { return(m_bMultiDrawSupported); }
+	// queue all the passed in instances of a mesh as one draw of
+	// the next submission
+	void QueueDraw(
+		MESH_TYPE mesh,
+		int detailLevel,
+		const glm::mat4* transforms,
+		const int* materialIndices,
+		int count);
+	// number of draws queued since the last submission
+	int GetQueuedDrawCount() const { return((int)m_drawCommands.size()); }
+	// draw everything queued with one multi-draw indirect call,
+	// or one draw per command without multi-draw support,
+	// returning the number of draws submitted
+	int SubmitQueuedDraws();
+
+private:
+	// part of the shared buffers holding one shape
+	struct MESH_RANGE
+	{
+		GLuint firstIndex;
+		GLsizei nIndices;
+	};
+
+	// layout of the commands read from the indirect buffer
+	struct DRAW_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// indices of the basic shapes at each level of detail
+	MESH_RANGE m_meshes[MESH_COUNT][DETAIL_LEVELS];
+	// levels of detail loaded for each shape
+	int m_detailLevelCounts[MESH_COUNT];
+	// vertex array reading every shape
+	GLuint m_vao;
+	// shared vertex and index buffers
+	GLuint m_vbos[2];
+	// per-instance buffer
+	GLuint m_instanceBuffer;
+	// allocated size of the per-instance buffer in bytes
+	GLsizeiptr m_instanceBufferSize;
+	// buffer of the queued draw commands
+	GLuint m_indirectBuffer;
+	// allocated size of the indirect buffer in bytes
+	GLsizeiptr m_indirectBufferSize;
+	// staging memory for the per-instance data
+	std::vector<INSTANCE_DATA> m_instanceData;
+	// draws queued since the last submission
+	std::vector<DRAW_COMMAND> m_drawCommands;
+	// true once the meshes have been loaded
+	bool m_bLoaded;
+	// true if the context has multi-draw indirect with base
+	// instances
+	bool m_bMultiDrawSupported;
+
+	// create the shared vertex array from all the shapes
+	void CreateVertexArray(const std::vector<float>& vertices, const std::vector<uint32_t>& indices);
+	// shape range of a mesh, clamped to its loaded levels
+	const MESH_RANGE& GetMeshRange(MESH_TYPE mesh, int detailLevel) const;
+	// append the instances of a draw to the staging memory
+	void AddInstances(const glm::mat4* transforms, const int* materialIndices, int count);
+	// upload a buffer, growing it when needed
+	void UploadBuffer(GLenum target, GLuint buffer, GLsizeiptr& bufferSize, GLsizeiptr size, const void* data);
+};
@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.cpp
+// ============
+// split per-object work across a pool of work-stealing threads
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// declaration of the global variables and defines
+namespace
+{
+	// job system and queue of the worker running on this thread,
+	// so that loops started inside a job use the worker's queue
+	thread_local const JobSystem* g_pWorkerSystem = NULL;
+	thread_local int g_workerQueue = -1;
+}
+
+/***********************************************************
+ *  JobSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+JobSystem::JobSystem()
+{
+	m_queues = NULL;
+	m_queueCount = 0;
+	m_queuedRanges = 0;
+	m_bStopping = false;
+}
+
+/***********************************************************
+ *  ~JobSystem()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for starting the worker threads and
+ *  creating their queues.  By default one worker is started
+ *  for every processor core except the one running the
+ *  render loop, and with no workers every loop runs on the
+ *  calling thread.
+ ***********************************************************/
+void JobSystem::Start(int workerCount)
+{
+	if (NULL != m_queues)
+	{
+		return;
+	}
+
+	if (workerCount < 0)
+	{
+		workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+	}
+
+	m_queueCount = workerCount + 1;
+	m_queues = new JOB_QUEUE[m_queueCount];
+	m_queuedRanges = 0;
+
+	m_bStopping = false;
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+	}
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for stopping the worker threads.
+ ***********************************************************/
+void JobSystem::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_rangesReady.notify_all();
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+
+	delete[] m_queues;
+	m_queues = NULL;
+	m_queueCount = 0;
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for running a job over a range of
+ *  indices on all the threads.  Each queue gets a contiguous
+ *  block of the ranges, so neighbouring objects are usually
+ *  handled by the same thread, and the calling thread runs
+ *  and steals ranges until every one of them is done.  Small
+ *  loops, and loops without workers, run directly on the
+ *  calling thread.
+ ***********************************************************/
+void JobSystem::ParallelFor(int count, int grainSize, const RANGE_JOB& job)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	grainSize = std::max(grainSize, 1);
+	int rangeCount = (count + grainSize - 1) / grainSize;
+	if ((m_workers.size() == 0) || (rangeCount == 1))
+	{
+		job(0, count);
+		return;
+	}
+
+	JOB_GROUP group;
+	group.pJob = &job;
+	group.remaining = rangeCount;
+
+	// count the ranges before queueing them, so a worker that
+	// sees an empty queue does not go back to sleep
+	m_queuedRanges += rangeCount;
+	for (int queue = 0; queue < m_queueCount; queue++)
+	{
+		int firstRange = rangeCount * queue / m_queueCount;
+		int lastRange = rangeCount * (queue + 1) / m_queueCount;
+		if (firstRange == lastRange)
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(m_queues[queue].mutex);
+		for (int range = firstRange; range < lastRange; range++)
+		{
+			JOB_RANGE jobRange;
+			jobRange.pGroup = &group;
+			jobRange.first = range * grainSize;
+			jobRange.last = std::min(jobRange.first + grainSize, count);
+			m_queues[queue].ranges.push_back(jobRange);
+		}
+	}
+	// a worker between checking the count and waiting holds the
+	// mutex, so taking it here keeps the wake-up from being lost
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+	}
+	m_rangesReady.notify_all();
+
+	// the calling thread uses the last queue, or its own one
+	// when it is a worker running a job
+	int queueIndex = (g_pWorkerSystem == this) ? g_workerQueue : (m_queueCount - 1);
+	while (group.remaining.load(std::memory_order_acquire) > 0)
+	{
+		if (RunRange(queueIndex) == false)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+/***********************************************************
+ *  RunRange()
+ *
+ *  This method is used for running the most recently queued
+ *  range of a queue, or else the oldest range of another
+ *  queue, which is the one least likely to be in the cache
+ *  of the thread owning it.
+ ***********************************************************/
+bool JobSystem::RunRange(int queueIndex)
+{
+	JOB_RANGE jobRange;
+	bool bFound = false;
+
+	for (int i = 0; (i < m_queueCount) && (bFound == false); i++)
+	{
+		JOB_QUEUE& queue = m_queues[(queueIndex + i) % m_queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.ranges.size() == 0)
+		{
+			continue;
+		}
+
+		if (i == 0)
+		{
+			jobRange = queue.ranges.back();
+			queue.ranges.pop_back();
+		}
+		else
+		{
+			jobRange = queue.ranges.front();
+			queue.ranges.pop_front();
+		}
+		bFound = true;
+	}
+
+	if (bFound == false)
+	{
+		return(false);
+	}
+
+	m_queuedRanges--;
+	(*jobRange.pGroup->pJob)(jobRange.first, jobRange.last);
+	// the group lives on the stack of the thread waiting for it,
+	// so it must not be touched after this
+	jobRange.pGroup->remaining.fetch_sub(1, std::memory_order_release);
+	return(true);
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is used for running queued ranges on a
+ *  worker thread, sleeping while there are none.
+ ***********************************************************/
+void JobSystem::WorkerLoop(int queueIndex)
+{
+	g_pWorkerSystem = this;
+	g_workerQueue = queueIndex;
+
+	while (true)
+	{
+		if (RunRange(queueIndex) == true)
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_rangesReady.wait(lock, [this]
+			{
+				return((m_bStopping == true) || (m_queuedRanges.load() > 0));
+			});
+		if (m_bStopping == true)
+		{
+			return;
+		}
+	}
+}
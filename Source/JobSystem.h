@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.h
+// ============
+// split per-object work across a pool of work-stealing threads
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  JobSystem
+ *
+ *  This class runs loops over many objects, such as the
+ *  transforms, bounds and sort keys of the draw items, on a
+ *  pool of worker threads.  A loop is split into ranges that
+ *  are spread over one queue per thread; a thread that runs
+ *  out of ranges steals from the other queues.  The calling
+ *  thread works on the loop too and returns once every range
+ *  is done, so the results can be used right away.  Jobs
+ *  must not make OpenGL calls, which stay on the thread
+ *  owning the context.
+ ***********************************************************/
+class JobSystem
+{
+public:
+	// constructor
+	JobSystem();
+	// destructor
+	~JobSystem();
+
+	// called with the first and one past the last index of a range
+	typedef std::function<void(int first, int last)> RANGE_JOB;
+
+	// start the worker threads - by default one for every
+	// processor core except the one calling ParallelFor()
+	void Start(int workerCount = -1);
+	// stop the worker threads
+	void Stop();
+	// threads working on a loop, including the calling thread
+	int GetThreadCount() const { return((int)m_workers.size() + 1); }
+
+	// run the job over the indices from 0 to count, in ranges
+	// of up to grainSize indices, and wait for all of them
+	void ParallelFor(int count, int grainSize, const RANGE_JOB& job);
+
+private:
+	struct JOB_GROUP
+	{
+		const RANGE_JOB* pJob;
+		std::atomic<int> remaining;
+	};
+
+	struct JOB_RANGE
+	{
+		JOB_GROUP* pGroup;
+		int first;
+		int last;
+	};
+
+	struct JOB_QUEUE
+	{
+		std::mutex mutex;
+		std::deque<JOB_RANGE> ranges;
+	};
+
+	// worker threads running the ranges
+	std::vector<std::thread> m_workers;
+	// one queue per worker, then one for the calling threads
+	JOB_QUEUE* m_queues;
+	int m_queueCount;
+	// ranges queued and not yet taken by a thread
+	std::atomic<int> m_queuedRanges;
+	// guards the sleeping workers
+	std::mutex m_mutex;
+	// wakes the workers when ranges are queued
+	std::condition_variable m_rangesReady;
+	// set when the workers need to exit
+	bool m_bStopping;
+
+	// loop run by each worker thread
+	void WorkerLoop(int queueIndex);
+	// run a range from the passed in queue, or one stolen from
+	// another queue, returning false if none was found
+	bool RunRange(int queueIndex);
+};
@@ -1,5 +1,7 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // command line option names
+#include <string>           // command line option values
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -13,6 +15,11 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "UniformCache.h"
+#include "HeadlessRenderer.h"
+#include "FrameProfiler.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
 
 // Namespace for declaring global variables
 namespace
@@ -27,14 +34,22 @@ namespace
 	SceneManager* g_SceneManager = nullptr;
 	// shader manager object for dynamic interaction with the shader code
 	ShaderManager* g_ShaderManager = nullptr;
+	// uniform cache object for resolving shader uniform locations once
+	UniformCache* g_UniformCache = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+	// frame profiler object for timing the phases of the loop, when enabled
+	FrameProfiler* g_Profiler = nullptr;
+
+	// trace events captured by the frame profiler
+	const size_t PROFILER_TRACE_EVENTS = 1000000;
 }
 
 // Function declarations - all functions that are called manually
 // need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
-bool InitializeGLEW();
+bool ParseCommandLine(int argc, char* argv[], bool& bHeadless, bool& bOnDemand, HeadlessRenderer::HEADLESS_OPTIONS& options, std::string& traceFile, std::string& recordFile);
+bool InitializeGLFW(bool bHeadless);
+bool InitializeGLEW(bool bHeadless);
 
 
 /***********************************************************
@@ -45,8 +60,25 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// --headless renders a batch of frames offscreen instead of
+	// opening the interactive window
+	bool bHeadless = false;
+	// --on-demand only draws a frame when the view or the scene
+	// changed, sleeping until the next event otherwise
+	bool bOnDemand = false;
+	HeadlessRenderer::HEADLESS_OPTIONS headlessOptions;
+	// --profile times the loop and writes a trace when closing
+	std::string traceFile;
+	// --record writes the OpenGL commands of every frame to a
+	// command log for the GLLogStats tool
+	std::string recordFile;
+	if (ParseCommandLine(argc, argv, bHeadless, bOnDemand, headlessOptions, traceFile, recordFile) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
 	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
+	if (InitializeGLFW(bHeadless) == false)
 	{
 		return(EXIT_FAILURE);
 	}
@@ -59,51 +91,155 @@ int main(int argc, char* argv[])
 
 	// try to create the main display window
 	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+	if (g_Window == NULL)
+	{
+		return(EXIT_FAILURE);
+	}
 
 	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
+	if (InitializeGLEW(bHeadless) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// record from here on, so the program bind and the uploads
+	// made while preparing the scene come before the first frame
+	// of the log
+	if ((recordFile.empty() == false) && (GLRecorder::Start(recordFile) == false))
 	{
 		return(EXIT_FAILURE);
 	}
 
 	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"../../Utilities/shaders/vertexShader.glsl",
-		"../../Utilities/shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
+	GLuint programID = g_ShaderManager->LoadShaders(
+		"Shaders/vertexShader.glsl",
+		"Shaders/fragmentShader.glsl");
+	GLStateCache::UseProgram(programID);
+
+	// create the uniform cache used by the scene manager
+	g_UniformCache = new UniformCache();
 
 	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager = new SceneManager(g_ShaderManager, g_UniformCache);
+	// resolve the locations of all the registered uniforms once
+	g_UniformCache->Initialize();
 	g_SceneManager->PrepareScene();
 
+	// time the phases of the loop when profiling
+	int toggleProjectionScope = -1;
+	int prepareViewScope = -1;
+	int renderSceneScope = -1;
+	int swapBuffersScope = -1;
+	if (traceFile.empty() == false)
+	{
+		g_Profiler = new FrameProfiler();
+		g_Profiler->Start(true);
+		g_Profiler->StartTrace(PROFILER_TRACE_EVENTS);
+		g_SceneManager->SetProfiler(g_Profiler);
+		toggleProjectionScope = g_Profiler->RegisterScope("ToggleProjectionMode");
+		prepareViewScope = g_Profiler->RegisterScope("PrepareSceneView");
+		renderSceneScope = g_Profiler->RegisterScope("RenderScene");
+		swapBuffersScope = g_Profiler->RegisterScope("glfwSwapBuffers");
+	}
+
+	// render the requested frames offscreen, skipping the
+	// interactive loop below
+	int exitCode = EXIT_SUCCESS;
+	if (bHeadless == true)
+	{
+		HeadlessRenderer headlessRenderer(g_ViewManager, g_SceneManager, g_Profiler);
+		if (headlessRenderer.Run(headlessOptions) == false)
+		{
+			exitCode = EXIT_FAILURE;
+		}
+	}
+
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
+	while ((bHeadless == false) && !glfwWindowShouldClose(g_Window))
 	{
+		// when drawing on demand and nothing changed, the last
+		// presented frame stays on the screen while the loop sleeps
+		// until GLFW receives an event
+		if ((bOnDemand == true) &&
+			(g_ViewManager->IsViewChanged() == false) &&
+			(g_SceneManager->IsSceneChanged() == false))
+		{
+			glfwWaitEvents();
+			g_ViewManager->ResetFrameTime();
+			continue;
+		}
+		g_ViewManager->ClearViewChanged();
+
+		if (NULL != g_Profiler)
+		{
+			g_Profiler->BeginFrame();
+		}
+		GLRecorder::BeginFrame();
+
 		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
+		GLStateCache::Enable(GL_DEPTH_TEST);
 
 		// Clear the frame and z buffers
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		GLRecorder::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// Toggle between perspective and orthographic views
-		g_ViewManager->ToggleProjectionMode();
+		{
+			ProfileScope scope(g_Profiler, toggleProjectionScope);
+			g_ViewManager->ToggleProjectionMode();
+		}
 
 		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
+		{
+			ProfileScope scope(g_Profiler, prepareViewScope);
+			g_ViewManager->PrepareSceneView();
+			g_SceneManager->SetCameraView(
+				g_ViewManager->GetViewMatrix(),
+				g_ViewManager->GetProjectionMatrix(),
+				g_ViewManager->GetViewPosition());
+		}
 
 		// refresh the 3D scene
-		g_SceneManager->RenderScene();
+		{
+			ProfileScope scope(g_Profiler, renderSceneScope);
+			g_SceneManager->RenderScene();
+		}
 
 
 		// Flips the the back buffer with the front buffer every frame.
-		glfwSwapBuffers(g_Window);
+		{
+			ProfileScope scope(g_Profiler, swapBuffersScope);
+			glfwSwapBuffers(g_Window);
+		}
+
+		if (NULL != g_Profiler)
+		{
+			g_Profiler->EndFrame();
+		}
 
 		// query the latest GLFW events
 		glfwPollEvents();
 	}
 
+	// report the profile and write the trace while the OpenGL
+	// context still exists to read the last queries
+	if (NULL != g_Profiler)
+	{
+		g_Profiler->Stop();
+		g_Profiler->Report(std::cout);
+		g_Profiler->WriteTrace(traceFile);
+		g_SceneManager->SetProfiler(NULL);
+		delete g_Profiler;
+		g_Profiler = NULL;
+	}
+
+	// write out the rest of the command log
+	if ((GLRecorder::IsRecording() == true) && (GLRecorder::Stop() == false))
+	{
+		exitCode = EXIT_FAILURE;
+	}
+
 	// clear the allocated manager objects from memory
 	if (NULL != g_SceneManager)
 	{
@@ -115,14 +251,124 @@ int main(int argc, char* argv[])
 		delete g_ViewManager;
 		g_ViewManager = NULL;
 	}
+	if (NULL != g_UniformCache)
+	{
+		delete g_UniformCache;
+		g_UniformCache = NULL;
+	}
 	if (NULL != g_ShaderManager)
 	{
 		delete g_ShaderManager;
 		g_ShaderManager = NULL;
 	}
 
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
+	// Terminates the program
+	exit(exitCode); 
+}
+
+/***********************************************************
+ *	ParseCommandLine()
+ *
+ *  This function is used to read the command line options:
+ *
+ *  --headless            render offscreen without a window
+ *  --on-demand           only redraw the window when the view
+ *                        or the scene changed
+ *  --frames <count>      number of frames to render
+ *  --camera-path <file>  camera path followed over the frames
+ *  --output <directory>  write every frame as an image
+ *  --format <png|ppm>    image format of the written frames
+ *  --width <pixels>      width of the rendered frames
+ *  --height <pixels>     height of the rendered frames
+ *  --profile <file>      time the frames and write a Chrome
+ *                        trace of them to the file
+ *  --record <file>       write the OpenGL commands of the
+ *                        frames to a command log
+ ***********************************************************/
+bool ParseCommandLine(int argc, char* argv[], bool& bHeadless, bool& bOnDemand, HeadlessRenderer::HEADLESS_OPTIONS& options, std::string& traceFile, std::string& recordFile)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* option = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (strcmp(option, "--headless") == 0)
+		{
+			bHeadless = true;
+			continue;
+		}
+		if (strcmp(option, "--on-demand") == 0)
+		{
+			bOnDemand = true;
+			continue;
+		}
+
+		if (value == NULL)
+		{
+			std::cerr << "Unknown option or missing value: " << option << std::endl;
+			std::cerr << "Usage: " << argv[0] << " [--headless] [--on-demand] [--frames <count>] [--camera-path <file>] [--output <directory>] [--format <png|ppm>] [--width <pixels>] [--height <pixels>] [--profile <trace file>] [--record <log file>]" << std::endl;
+			return(false);
+		}
+
+		if (strcmp(option, "--frames") == 0)
+		{
+			options.frameCount = atoi(value);
+		}
+		else if (strcmp(option, "--camera-path") == 0)
+		{
+			options.cameraPath = value;
+		}
+		else if (strcmp(option, "--output") == 0)
+		{
+			options.outputDirectory = value;
+		}
+		else if (strcmp(option, "--format") == 0)
+		{
+			if (strcmp(value, "png") == 0)
+			{
+				options.format = ImageEncoder::FORMAT_PNG;
+			}
+			else if (strcmp(value, "ppm") == 0)
+			{
+				options.format = ImageEncoder::FORMAT_PPM;
+			}
+			else
+			{
+				std::cerr << "Unknown image format: " << value << std::endl;
+				return(false);
+			}
+		}
+		else if (strcmp(option, "--width") == 0)
+		{
+			options.width = atoi(value);
+		}
+		else if (strcmp(option, "--height") == 0)
+		{
+			options.height = atoi(value);
+		}
+		else if (strcmp(option, "--profile") == 0)
+		{
+			traceFile = value;
+		}
+		else if (strcmp(option, "--record") == 0)
+		{
+			recordFile = value;
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << option << std::endl;
+			return(false);
+		}
+		i++;
+	}
+
+	if ((options.frameCount <= 0) || (options.width <= 0) || (options.height <= 0))
+	{
+		std::cerr << "The frame count, width and height must be positive" << std::endl;
+		return(false);
+	}
+
+	return(true);
 }
 
 /***********************************************************
@@ -130,11 +376,23 @@ int main(int argc, char* argv[])
  * 
  *  This function is used to initialize the GLFW library.   
  ***********************************************************/
-bool InitializeGLFW()
+bool InitializeGLFW(bool bHeadless)
 {
 	// GLFW: initialize and configure library
 	// --------------------------------------
-	glfwInit();
+#ifdef GLFW_PLATFORM_NULL
+	// without a display, GLFW 3.4 can run on its null platform
+	// with an OSMesa (software) context
+	if (bHeadless == true)
+	{
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	}
+#endif
+	if (glfwInit() == GLFW_FALSE)
+	{
+		std::cerr << "Failed to initialize GLFW" << std::endl;
+		return(false);
+	}
 
 #ifdef __APPLE__
 	// set the version of OpenGL and profile to use
@@ -147,6 +405,20 @@ bool InitializeGLFW()
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif
+
+	if (bHeadless == true)
+	{
+		// the window is only used for its context
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifndef __APPLE__
+		// software implementations such as llvmpipe stop at 4.5,
+		// which is all the shaders need
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+#endif
+#ifdef GLFW_PLATFORM_NULL
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+	}
 	// GLFW: end -------------------------------
 
 	return(true);
@@ -157,7 +429,7 @@ bool InitializeGLFW()
  *
  *  This function is used to initialize the GLEW library.
  ***********************************************************/
-bool InitializeGLEW()
+bool InitializeGLEW(bool bHeadless)
 {
 	// GLEW: initialize
 	// -----------------------------------------
@@ -165,6 +437,14 @@ bool InitializeGLEW()
 
 	// try to initialize the GLEW library
 	GLEWInitResult = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+	// an OSMesa context has no GLX display, but the functions
+	// have still been loaded
+	if ((bHeadless == true) && (GLEW_ERROR_NO_GLX_DISPLAY == GLEWInitResult))
+	{
+		GLEWInitResult = GLEW_OK;
+	}
+#endif
 	if (GLEW_OK != GLEWInitResult)
 	{
 		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
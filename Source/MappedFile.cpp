@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// mappedfile.cpp
+// ============
+// map whole files into memory for reading
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/***********************************************************
+ *  MappedFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+MappedFile::MappedFile()
+{
+	m_view = NULL;
+	m_size = 0;
+}
+
+/***********************************************************
+ *  ~MappedFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for mapping a whole file.  Empty
+ *  files cannot be mapped and return false.
+ ***********************************************************/
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+	m_view = Map(path, m_size);
+	if (NULL == m_view)
+	{
+		m_size = 0;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for releasing the mapped file.
+ ***********************************************************/
+void MappedFile::Close()
+{
+	if (NULL != m_view)
+	{
+		Unmap(m_view, m_size);
+		m_view = NULL;
+		m_size = 0;
+	}
+}
+
+/***********************************************************
+ *  Map()
+ *
+ *  This method is used for mapping a whole file into memory
+ *  for reading.  NULL is returned when the file cannot be
+ *  opened or is empty.
+ ***********************************************************/
+void* MappedFile::Map(const std::string& path, size_t& size)
+{
+	size = 0;
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return(NULL);
+	}
+
+	LARGE_INTEGER fileSize;
+	void* view = NULL;
+	if ((GetFileSizeEx(file, &fileSize) != 0) && (fileSize.QuadPart > 0))
+	{
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping != NULL)
+		{
+			view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		size = (size_t)fileSize.QuadPart;
+	}
+	CloseHandle(file);
+
+	return(view);
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return(NULL);
+	}
+
+	struct stat fileStat;
+	void* view = NULL;
+	if ((fstat(file, &fileStat) == 0) && (fileStat.st_size > 0))
+	{
+		view = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (view == MAP_FAILED)
+		{
+			view = NULL;
+		}
+		size = (size_t)fileStat.st_size;
+	}
+	close(file);
+
+	return(view);
+#endif
+}
+
+/***********************************************************
+ *  Unmap()
+ *
+ *  This method is used for releasing a file mapped with
+ *  Map().
+ ***********************************************************/
+void MappedFile::Unmap(void* view, size_t size)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(view);
+#else
+	munmap(view, size);
+#endif
+}
+
+/***********************************************************
+ *  GetFileStamp()
+ *
+ *  This method is used for getting the size and the last
+ *  modification time of a file.
+ ***********************************************************/
+bool MappedFile::GetFileStamp(const std::string& path, uint64_t& size, int64_t& modifiedTime)
+{
+	std::error_code error;
+
+	size = (uint64_t)std::filesystem::file_size(path, error);
+	if (error)
+	{
+		return(false);
+	}
+
+	std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+	if (error)
+	{
+		return(false);
+	}
+	modifiedTime = (int64_t)writeTime.time_since_epoch().count();
+
+	return(true);
+}
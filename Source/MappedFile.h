@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+// mappedfile.h
+// ============
+// map whole files into memory for reading
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/***********************************************************
+ *  MappedFile
+ *
+ *  This class maps a whole file into memory for reading,
+ *  so its contents can be used in place without copying
+ *  them into allocated memory.  The mapping is released
+ *  when the file is closed or the object is destroyed.
+ ***********************************************************/
+class MappedFile
+{
+public:
+	// constructor
+	MappedFile();
+	// destructor
+	~MappedFile();
+
+	// map a whole file, closing any file mapped before
+	bool Open(const std::string& path);
+	// release the mapping
+	void Close();
+
+	// true while a file is mapped
+	bool IsOpen() const { return(NULL != m_view); }
+	// mapped contents of the file
+	const unsigned char* GetData() const { return((const unsigned char*)m_view); }
+	// size of the file in bytes
+	size_t GetSize() const { return(m_size); }
+
+	// map and release files without a MappedFile object
+	static void* Map(const std::string& path, size_t& size);
+	static void Unmap(void* view, size_t size);
+	// size and last modification time of a file, used to
+	// tell when a file derived from it is out of date
+	static bool GetFileStamp(const std::string& path, uint64_t& size, int64_t& modifiedTime);
+
+private:
+	void* m_view;
+	size_t m_size;
+
+	// mappings are released once
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+};
@@ -0,0 +1,474 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionbuffer.cpp
+// ============
+// rasterize large occluders on the CPU and test bounds against their depth
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+// SSE is part of every x64 target and of x86 targets built
+// with SSE2 code generation
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define OCCLUSION_BUFFER_SSE
+#include <xmmintrin.h>
+#endif
+
+// declaration of the global variables and defines
+namespace
+{
+	// depth of the pixels nothing was drawn into
+	const float CLEAR_DEPTH = 1.0f;
+	// a box is tested against the coarsest level where its
+	// screen rectangle is narrower than this many texels
+	const int TEST_TEXELS = 4;
+
+	// corners of the box faces, wound counterclockwise seen
+	// from outside - bit 0 of a corner picks the x of the max
+	// corner of the box, bit 1 the y and bit 2 the z
+	const int BOX_TRIANGLES[36] =
+	{
+		2, 0, 4,  2, 4, 6,
+		5, 1, 3,  5, 3, 7,
+		4, 0, 1,  4, 1, 5,
+		3, 2, 6,  3, 6, 7,
+		1, 0, 2,  1, 2, 3,
+		6, 4, 5,  6, 5, 7
+	};
+
+	/***********************************************************
+	 *  ClipDistance()
+	 *
+	 *  Distance of a clip space vertex in front of the near
+	 *  plane, negative behind it.
+	 ***********************************************************/
+	float ClipDistance(const glm::vec4& clip)
+	{
+		return(clip.z + clip.w);
+	}
+
+	/***********************************************************
+	 *  ClipEdge()
+	 *
+	 *  Point where an edge crosses the near plane.
+	 ***********************************************************/
+	glm::vec4 ClipEdge(const glm::vec4& inside, const glm::vec4& outside)
+	{
+		float insideDistance = ClipDistance(inside);
+		float t = insideDistance / (insideDistance - ClipDistance(outside));
+		return(inside + (outside - inside) * t);
+	}
+}
+
+/***********************************************************
+ *  OcclusionBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+OcclusionBuffer::OcclusionBuffer()
+{
+	m_width = 0;
+	m_height = 0;
+	m_viewProjection = glm::mat4(1.0f);
+	m_triangleCount = 0;
+	m_bSimdEnabled = true;
+	SetSize(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+}
+
+/***********************************************************
+ *  ~OcclusionBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+OcclusionBuffer::~OcclusionBuffer()
+{
+}
+
+/***********************************************************
+ *  SetSize()
+ *
+ *  This method is used for changing the resolution of the
+ *  depth buffer and of the coarser levels built from it,
+ *  each level half the size of the previous one down to a
+ *  single texel.  The width is a multiple of four so rows
+ *  can be rasterized four pixels at a time.
+ ***********************************************************/
+void OcclusionBuffer::SetSize(int width, int height)
+{
+	m_width = (std::max(width, 1) + 3) & ~3;
+	m_height = std::max(height, 1);
+
+	m_levels.clear();
+	int levelWidth = m_width;
+	int levelHeight = m_height;
+	while (true)
+	{
+		DEPTH_LEVEL level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		level.depth.assign((size_t)levelWidth * levelHeight, CLEAR_DEPTH);
+		m_levels.push_back(level);
+
+		if ((levelWidth == 1) && (levelHeight == 1))
+		{
+			break;
+		}
+		levelWidth = (levelWidth + 1) / 2;
+		levelHeight = (levelHeight + 1) / 2;
+	}
+}
+
+/***********************************************************
+ *  Begin()
+ *
+ *  This method is used for clearing the depth buffer before
+ *  rasterizing the occluders seen by a new camera.
+ ***********************************************************/
+void OcclusionBuffer::Begin(const glm::mat4& viewProjection)
+{
+	m_viewProjection = viewProjection;
+	m_triangleCount = 0;
+	std::fill(m_levels[0].depth.begin(), m_levels[0].depth.end(), CLEAR_DEPTH);
+}
+
+/***********************************************************
+ *  DrawBox()
+ *
+ *  This method is used for rasterizing the twelve triangles
+ *  of a transformed box.  Only the faces turned towards the
+ *  camera are kept, so a box with no thickness, such as a
+ *  plane, is drawn once from either side.
+ ***********************************************************/
+void OcclusionBuffer::DrawBox(const BOUNDING_BOX& localBox, const glm::mat4& transform)
+{
+	glm::mat4 modelViewProjection = m_viewProjection * transform;
+	glm::vec4 corners[8];
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 corner(
+			(i & 1) ? localBox.max.x : localBox.min.x,
+			(i & 2) ? localBox.max.y : localBox.min.y,
+			(i & 4) ? localBox.max.z : localBox.min.z,
+			1.0f);
+		corners[i] = modelViewProjection * corner;
+	}
+
+	// mirrored transforms turn the faces inside out
+	bool bMirrored = (glm::determinant(glm::mat3(transform)) < 0.0f);
+	for (int i = 0; i < 36; i += 3)
+	{
+		const glm::vec4& a = corners[BOX_TRIANGLES[i]];
+		const glm::vec4& b = corners[BOX_TRIANGLES[i + (bMirrored ? 2 : 1)]];
+		const glm::vec4& c = corners[BOX_TRIANGLES[i + (bMirrored ? 1 : 2)]];
+		DrawTriangle(a, b, c);
+	}
+}
+
+/***********************************************************
+ *  DrawTriangle()
+ *
+ *  This method is used for clipping a clip space triangle
+ *  against the near plane, which leaves nothing, the whole
+ *  triangle, or a polygon of up to four corners that is
+ *  split into two triangles, and rasterizing the rest.
+ *  Large occluders such as the floor usually reach behind
+ *  the camera, so they cannot simply be dropped.
+ ***********************************************************/
+void OcclusionBuffer::DrawTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+	const glm::vec4* vertices[3] = { &a, &b, &c };
+	glm::vec4 polygon[4];
+	int cornerCount = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		const glm::vec4& current = *vertices[i];
+		const glm::vec4& next = *vertices[(i + 1) % 3];
+		bool bCurrentInside = (ClipDistance(current) >= 0.0f);
+		bool bNextInside = (ClipDistance(next) >= 0.0f);
+
+		if (bCurrentInside == true)
+		{
+			polygon[cornerCount++] = current;
+		}
+		if (bCurrentInside != bNextInside)
+		{
+			polygon[cornerCount++] = (bCurrentInside == true) ? ClipEdge(current, next) : ClipEdge(next, current);
+		}
+	}
+
+	if (cornerCount < 3)
+	{
+		return;
+	}
+
+	SCREEN_VERTEX screen[4];
+	for (int i = 0; i < cornerCount; i++)
+	{
+		screen[i] = ToScreen(polygon[i]);
+	}
+	for (int i = 2; i < cornerCount; i++)
+	{
+		RasterizeTriangle(screen[0], screen[i - 1], screen[i]);
+	}
+}
+
+/***********************************************************
+ *  ToScreen()
+ *
+ *  This method is used for converting a clip space vertex
+ *  to pixels, with y pointing up like the OpenGL window
+ *  coordinates so the winding is the same.
+ ***********************************************************/
+OcclusionBuffer::SCREEN_VERTEX OcclusionBuffer::ToScreen(const glm::vec4& clip) const
+{
+	// vertices on the near plane of an orthographic camera
+	// still have a w of one, but keep away from zero anyway
+	float inverseW = 1.0f / std::max(clip.w, 1e-6f);
+
+	SCREEN_VERTEX vertex;
+	vertex.x = (clip.x * inverseW * 0.5f + 0.5f) * (float)m_width;
+	vertex.y = (clip.y * inverseW * 0.5f + 0.5f) * (float)m_height;
+	vertex.z = clip.z * inverseW;
+	return(vertex);
+}
+
+/***********************************************************
+ *  RasterizeTriangle()
+ *
+ *  This method is used for keeping the nearest depth of a
+ *  screen triangle at every pixel whose center it covers.
+ *  The three edge functions and the depth are planes over
+ *  the screen, evaluated four pixels at a time with SSE,
+ *  or one at a time with the same operations, so both ways
+ *  give the same depths.  Back facing triangles are
+ *  skipped.
+ ***********************************************************/
+void OcclusionBuffer::RasterizeTriangle(const SCREEN_VERTEX& v0, const SCREEN_VERTEX& v1, const SCREEN_VERTEX& v2)
+{
+	float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+	if (area <= 0.0f)
+	{
+		return;
+	}
+
+	// pixels whose centers are inside the bounds of the triangle
+	int minX = std::max((int)std::ceil(std::min(v0.x, std::min(v1.x, v2.x)) - 0.5f), 0);
+	int maxX = std::min((int)std::floor(std::max(v0.x, std::max(v1.x, v2.x)) - 0.5f), m_width - 1);
+	int minY = std::max((int)std::ceil(std::min(v0.y, std::min(v1.y, v2.y)) - 0.5f), 0);
+	int maxY = std::min((int)std::floor(std::max(v0.y, std::max(v1.y, v2.y)) - 0.5f), m_height - 1);
+	if ((minX > maxX) || (minY > maxY))
+	{
+		return;
+	}
+	m_triangleCount++;
+
+	// edge functions, positive inside the triangle - edge i
+	// is the one opposite vertex i.  The constant is taken from
+	// the same end of an edge whichever way it runs, so the two
+	// triangles sharing an edge compute exactly opposite values
+	// and no pixel center on the edge falls between them
+	const SCREEN_VERTEX* vertices[3] = { &v0, &v1, &v2 };
+	float edgeX[3];
+	float edgeY[3];
+	float edgeConstant[3];
+	for (int i = 0; i < 3; i++)
+	{
+		const SCREEN_VERTEX& from = *vertices[(i + 1) % 3];
+		const SCREEN_VERTEX& to = *vertices[(i + 2) % 3];
+		bool bFromFirst = (from.x < to.x) || ((from.x == to.x) && (from.y <= to.y));
+		const SCREEN_VERTEX& anchor = (bFromFirst == true) ? from : to;
+		edgeX[i] = from.y - to.y;
+		edgeY[i] = to.x - from.x;
+		edgeConstant[i] = -(edgeX[i] * anchor.x + edgeY[i] * anchor.y);
+	}
+
+	// depth plane through the three vertices
+	float depthX = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+	float depthY = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+	float depthConstant = v0.z - depthX * v0.x - depthY * v0.y;
+
+	std::vector<float>& depth = m_levels[0].depth;
+
+	// rows start and end on a multiple of four pixels, which
+	// the width also is, so every group of four is inside the row
+	int startX = minX & ~3;
+	int endX = maxX | 3;
+
+	for (int y = minY; y <= maxY; y++)
+	{
+		// the planes are evaluated at every pixel from the part
+		// that is constant along the row, rather than stepped,
+		// since stepping would not keep shared edges opposite
+		float centerY = (float)y + 0.5f;
+		float* row = &depth[(size_t)y * m_width];
+		float rowEdges[3];
+		for (int i = 0; i < 3; i++)
+		{
+			rowEdges[i] = edgeY[i] * centerY + edgeConstant[i];
+		}
+		float rowDepth = depthY * centerY + depthConstant;
+
+#ifdef OCCLUSION_BUFFER_SSE
+		if (m_bSimdEnabled == true)
+		{
+			__m128 centerX = _mm_add_ps(_mm_set1_ps((float)startX + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+			__m128 step = _mm_set1_ps(4.0f);
+			__m128 zero = _mm_setzero_ps();
+
+			for (int x = startX; x <= maxX; x += 4)
+			{
+				__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeX[0]), centerX), _mm_set1_ps(rowEdges[0])), zero);
+				for (int i = 1; i < 3; i++)
+				{
+					inside = _mm_and_ps(inside,
+						_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeX[i]), centerX), _mm_set1_ps(rowEdges[i])), zero));
+				}
+				if (_mm_movemask_ps(inside) != 0)
+				{
+					__m128 pixelDepth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthX), centerX), _mm_set1_ps(rowDepth));
+					__m128 previous = _mm_loadu_ps(row + x);
+					__m128 nearest = _mm_min_ps(previous, pixelDepth);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+				}
+
+				centerX = _mm_add_ps(centerX, step);
+			}
+			continue;
+		}
+#endif
+
+		for (int x = startX; x <= endX; x++)
+		{
+			float centerX = (float)x + 0.5f;
+			if ((edgeX[0] * centerX + rowEdges[0] >= 0.0f) &&
+				(edgeX[1] * centerX + rowEdges[1] >= 0.0f) &&
+				(edgeX[2] * centerX + rowEdges[2] >= 0.0f))
+			{
+				// the same choice as _mm_min_ps(previous, depth)
+				float pixelDepth = depthX * centerX + rowDepth;
+				float previous = row[x];
+				row[x] = (previous < pixelDepth) ? previous : pixelDepth;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  Finish()
+ *
+ *  This method is used for building each coarser level of
+ *  the depth buffer from the previous one, every texel
+ *  keeping the farthest of the up to four texels it covers,
+ *  so a box nearer than a coarse texel is nearer than every
+ *  pixel under it.
+ ***********************************************************/
+void OcclusionBuffer::Finish()
+{
+	for (size_t level = 1; level < m_levels.size(); level++)
+	{
+		const DEPTH_LEVEL& source = m_levels[level - 1];
+		DEPTH_LEVEL& target = m_levels[level];
+
+		for (int y = 0; y < target.height; y++)
+		{
+			const float* row0 = &source.depth[(size_t)(y * 2) * source.width];
+			const float* row1 = &source.depth[(size_t)std::min(y * 2 + 1, source.height - 1) * source.width];
+			float* targetRow = &target.depth[(size_t)y * target.width];
+
+			for (int x = 0; x < target.width; x++)
+			{
+				int x0 = x * 2;
+				int x1 = std::min(x0 + 1, source.width - 1);
+				targetRow[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  IsBoxVisible()
+ *
+ *  This method is used for testing a world space box against
+ *  the depth levels.  The nearest depth of the corners is
+ *  compared with the texels under the screen rectangle of
+ *  the box, on the coarsest level where the rectangle spans
+ *  only a few texels.  Boxes reaching in front of the near
+ *  plane are always visible, since their rectangle is not
+ *  known.
+ ***********************************************************/
+bool OcclusionBuffer::IsBoxVisible(const BOUNDING_BOX& box) const
+{
+	float minX = 0.0f;
+	float maxX = 0.0f;
+	float minY = 0.0f;
+	float maxY = 0.0f;
+	float minDepth = 0.0f;
+
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 corner(
+			(i & 1) ? box.max.x : box.min.x,
+			(i & 2) ? box.max.y : box.min.y,
+			(i & 4) ? box.max.z : box.min.z,
+			1.0f);
+		glm::vec4 clip = m_viewProjection * corner;
+		if (ClipDistance(clip) <= 0.0f)
+		{
+			return(true);
+		}
+
+		SCREEN_VERTEX screen = ToScreen(clip);
+		if (i == 0)
+		{
+			minX = maxX = screen.x;
+			minY = maxY = screen.y;
+			minDepth = screen.z;
+		}
+		else
+		{
+			minX = std::min(minX, screen.x);
+			maxX = std::max(maxX, screen.x);
+			minY = std::min(minY, screen.y);
+			maxY = std::max(maxY, screen.y);
+			minDepth = std::min(minDepth, screen.z);
+		}
+	}
+
+	// boxes off the screen are left to the frustum test
+	int left = std::max((int)std::floor(minX), 0);
+	int right = std::min((int)std::floor(maxX), m_width - 1);
+	int bottom = std::max((int)std::floor(minY), 0);
+	int top = std::min((int)std::floor(maxY), m_height - 1);
+	if ((left > right) || (bottom > top))
+	{
+		return(true);
+	}
+
+	int levelIndex = 0;
+	int span = std::max(right - left, top - bottom);
+	while (((span >> levelIndex) >= TEST_TEXELS) && (levelIndex + 1 < (int)m_levels.size()))
+	{
+		levelIndex++;
+	}
+
+	const DEPTH_LEVEL& level = m_levels[levelIndex];
+	for (int y = bottom >> levelIndex; y <= (top >> levelIndex); y++)
+	{
+		const float* row = &level.depth[(size_t)y * level.width];
+		for (int x = left >> levelIndex; x <= (right >> levelIndex); x++)
+		{
+			if (row[x] >= minDepth)
+			{
+				return(true);
+			}
+		}
+	}
+
+	return(false);
+}
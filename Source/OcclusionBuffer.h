@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionbuffer.h
+// ============
+// rasterize large occluders on the CPU and test bounds against their depth
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "BoundingVolumes.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  OcclusionBuffer
+ *
+ *  This class keeps a low resolution depth buffer in memory.
+ *  The faces of a few large boxes and planes are rasterized
+ *  into it on the CPU, four pixels at a time with SSE when
+ *  it is available, and a hierarchy of coarser levels is
+ *  then built, each texel holding the farthest depth of the
+ *  texels it covers.  A bounding box is hidden when its
+ *  nearest depth is behind every texel under its screen
+ *  rectangle, so most boxes are tested against only a few
+ *  texels.  Nothing here uses OpenGL, so the buffer can be
+ *  filled and tested without a GPU.
+ ***********************************************************/
+class OcclusionBuffer
+{
+public:
+	// constructor
+	OcclusionBuffer();
+	// destructor
+	~OcclusionBuffer();
+
+	// default resolution of the depth buffer
+	static const int DEFAULT_WIDTH = 256;
+	static const int DEFAULT_HEIGHT = 144;
+
+	// change the resolution of the depth buffer - the width is
+	// rounded up to a multiple of four pixels
+	void SetSize(int width, int height);
+	int GetWidth() const { return(m_width); }
+	int GetHeight() const { return(m_height); }
+
+	// clear the depth buffer for a new projection * view matrix
+	void Begin(const glm::mat4& viewProjection);
+	// rasterize the faces of a local space box after a
+	// transformation - planes are boxes with no thickness
+	void DrawBox(const BOUNDING_BOX& localBox, const glm::mat4& transform);
+	// build the coarser depth levels from the rasterized faces
+	void Finish();
+
+	// false if a world space box is completely hidden behind
+	// the rasterized faces
+	bool IsBoxVisible(const BOUNDING_BOX& box) const;
+
+	// rasterize four pixels at a time with SSE when it is
+	// available, or one at a time with the same results
+	void SetSimdEnabled(bool bEnabled) { m_bSimdEnabled = bEnabled; }
+	bool IsSimdEnabled() const { return(m_bSimdEnabled); }
+
+	// normalized device depth of a pixel, 1 where nothing was drawn
+	float GetDepth(int x, int y) const { return(m_levels[0].depth[y * m_width + x]); }
+	// triangles rasterized since Begin()
+	int GetTriangleCount() const { return(m_triangleCount); }
+
+private:
+	struct DEPTH_LEVEL
+	{
+		int width;
+		int height;
+		std::vector<float> depth;
+	};
+
+	// screen position in pixels and normalized device depth
+	struct SCREEN_VERTEX
+	{
+		float x;
+		float y;
+		float z;
+	};
+
+	int m_width;
+	int m_height;
+	// depth levels, the full resolution buffer first
+	std::vector<DEPTH_LEVEL> m_levels;
+	glm::mat4 m_viewProjection;
+	int m_triangleCount;
+	bool m_bSimdEnabled;
+
+	// clip a clip space triangle against the near plane and
+	// rasterize what is left of it
+	void DrawTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+	// screen position of a clip space vertex in front of the camera
+	SCREEN_VERTEX ToScreen(const glm::vec4& clip) const;
+	// keep the nearest depth of a front facing screen triangle
+	void RasterizeTriangle(const SCREEN_VERTEX& v0, const SCREEN_VERTEX& v1, const SCREEN_VERTEX& v2);
+};
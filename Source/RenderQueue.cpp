@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.cpp
+// ============
+// retained list of draw items submitted in state-sorted order
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// declaration of the sort key layout
+namespace
+{
+	// bit 63 separates opaque items from transparent items
+	const int KEY_TRANSPARENT_SHIFT = 63;
+	// opaque items: shader, texture, mesh, level of detail, material,
+	// then front-to-back depth - items sharing a mesh, its level of
+	// detail and a texture end up next to each other
+	const int OPAQUE_SHADER_SHIFT = 56;
+	const int OPAQUE_TEXTURE_SHIFT = 40;
+	const int OPAQUE_MESH_SHIFT = 36;
+	const int OPAQUE_DETAIL_SHIFT = 34;
+	const int OPAQUE_MATERIAL_SHIFT = 18;
+	// transparent items: back-to-front depth first, then the state
+	const int TRANSPARENT_DEPTH_SHIFT = 39;
+	const int TRANSPARENT_SHADER_SHIFT = 32;
+	const int TRANSPARENT_TEXTURE_SHIFT = 16;
+
+	const uint64_t SHADER_MASK = 0x7F;
+	const uint64_t MESH_MASK = 0xF;
+	const uint64_t DETAIL_MASK = 0x3;
+	const uint64_t STATE_MASK = 0xFFFF;
+	const uint64_t OPAQUE_DEPTH_MASK = 0x3FFFF;
+	const uint64_t TRANSPARENT_DEPTH_MASK = 0xFFFFFF;
+
+	// items whose sort keys are built by one job range
+	const int SORT_KEYS_PER_JOB = 1024;
+	// fewest items worth sorting on several threads
+	const int PARALLEL_SORT_ITEMS = 8192;
+}
+
+/***********************************************************
+ *  RenderQueue()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RenderQueue::RenderQueue()
+{
+}
+
+/***********************************************************
+ *  ~RenderQueue()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+RenderQueue::~RenderQueue()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  AddItem()
+ *
+ *  This method is used for adding a draw item to the queue.
+ *  The returned index can be used to update the item later.
+ ***********************************************************/
+int RenderQueue::AddItem(const DRAW_ITEM& item)
+{
+	m_items.push_back(item);
+	return((int)m_items.size() - 1);
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for a number of draw
+ *  items, so adding them does not reallocate.
+ ***********************************************************/
+void RenderQueue::Reserve(int count)
+{
+	m_items.reserve(count);
+	m_sortEntries.reserve(count);
+	m_sortedItems.reserve(count);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the draw items.
+ ***********************************************************/
+void RenderQueue::Clear()
+{
+	m_items.clear();
+	m_sortEntries.clear();
+	m_mergedEntries.clear();
+	m_sortedItems.clear();
+}
+
+/***********************************************************
+ *  MakeSortKey()
+ *
+ *  This method is used for packing the render state and the
+ *  quantized depth of an item into a single 64-bit key.
+ *  Texture and material IDs are offset by one so that the
+ *  "none" value of -1 sorts first.
+ ***********************************************************/
+uint64_t RenderQueue::MakeSortKey(const DRAW_ITEM& item, float normalizedDepth)
+{
+	uint64_t shader = (uint64_t)item.shaderID & SHADER_MASK;
+	uint64_t texture = (uint64_t)(item.textureSlot + 1) & STATE_MASK;
+	uint64_t mesh = (uint64_t)item.mesh & MESH_MASK;
+	uint64_t detail = (uint64_t)item.detailLevel & DETAIL_MASK;
+	uint64_t material = (uint64_t)(item.materialID + 1) & STATE_MASK;
+	float depth = glm::clamp(normalizedDepth, 0.0f, 1.0f);
+	uint64_t key = 0;
+
+	if (item.bTransparent == false)
+	{
+		key = (shader << OPAQUE_SHADER_SHIFT) |
+			(texture << OPAQUE_TEXTURE_SHIFT) |
+			(mesh << OPAQUE_MESH_SHIFT) |
+			(detail << OPAQUE_DETAIL_SHIFT) |
+			(material << OPAQUE_MATERIAL_SHIFT) |
+			(uint64_t)(depth * (float)OPAQUE_DEPTH_MASK);
+	}
+	else
+	{
+		// farther items get smaller keys so they are drawn first
+		uint64_t inverseDepth = TRANSPARENT_DEPTH_MASK - (uint64_t)(depth * (float)TRANSPARENT_DEPTH_MASK);
+
+		key = ((uint64_t)1 << KEY_TRANSPARENT_SHIFT) |
+			(inverseDepth << TRANSPARENT_DEPTH_SHIFT) |
+			(shader << TRANSPARENT_SHADER_SHIFT) |
+			(texture << TRANSPARENT_TEXTURE_SHIFT) |
+			material;
+	}
+
+	return(key);
+}
+
+/***********************************************************
+ *  Sort()
+ *
+ *  This method is used for ordering the draw items for the
+ *  current camera position.  The depth of an item is the
+ *  distance from the camera to its origin, normalized by
+ *  the distance of the far clipping plane.  When item
+ *  indices are passed in, only those items are ordered and
+ *  the others are left out of the submission order.
+ ***********************************************************/
+void RenderQueue::Sort(const glm::vec3& viewPosition, float farPlane, JobSystem* pJobSystem)
+{
+	SortItems(viewPosition, farPlane, NULL, (int)m_items.size(), pJobSystem);
+}
+
+void RenderQueue::Sort(const glm::vec3& viewPosition, float farPlane, const std::vector<int>& itemIndices, JobSystem* pJobSystem)
+{
+	SortItems(viewPosition, farPlane, itemIndices.data(), (int)itemIndices.size(), pJobSystem);
+}
+
+/***********************************************************
+ *  SortItems()
+ *
+ *  This method is used for building the sort keys of the
+ *  passed in items and ordering them.  Every entry is
+ *  written by one job range only, so the keys can be built
+ *  on any number of threads.
+ ***********************************************************/
+void RenderQueue::SortItems(const glm::vec3& viewPosition, float farPlane, const int* itemIndices, int count, JobSystem* pJobSystem)
+{
+	m_sortEntries.resize(count);
+	m_sortedItems.resize(count);
+
+	JobSystem::RANGE_JOB buildKeys = [this, &viewPosition, farPlane, itemIndices](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				int index = (NULL != itemIndices) ? itemIndices[i] : i;
+				const DRAW_ITEM& item = m_items[index];
+				glm::vec3 origin = glm::vec3(item.transform[3]);
+				float depth = glm::length(origin - viewPosition) / farPlane;
+
+				m_sortEntries[i].key = MakeSortKey(item, depth);
+				m_sortEntries[i].index = index;
+			}
+		};
+	if (NULL != pJobSystem)
+	{
+		pJobSystem->ParallelFor(count, SORT_KEYS_PER_JOB, buildKeys);
+	}
+	else
+	{
+		buildKeys(0, count);
+	}
+
+	SortEntries(pJobSystem);
+
+	for (size_t i = 0; i < m_sortEntries.size(); i++)
+	{
+		m_sortedItems[i] = m_sortEntries[i].index;
+	}
+}
+
+/***********************************************************
+ *  SortEntries()
+ *
+ *  This method is used for ordering the sort entries by key,
+ *  then by item index.  Large queues are split into one
+ *  block per thread, the blocks are sorted in parallel and
+ *  then merged in pairs, each round of merges also running
+ *  in parallel.  Since no two entries compare equal, the
+ *  order is the same as with a single sort.
+ ***********************************************************/
+void RenderQueue::SortEntries(JobSystem* pJobSystem)
+{
+	auto entryLess = [](const SORT_ENTRY& a, const SORT_ENTRY& b)
+		{
+			if (a.key != b.key)
+			{
+				return(a.key < b.key);
+			}
+			return(a.index < b.index);
+		};
+
+	int count = (int)m_sortEntries.size();
+	if ((NULL == pJobSystem) ||
+		(pJobSystem->GetThreadCount() == 1) ||
+		(count < PARALLEL_SORT_ITEMS))
+	{
+		std::sort(m_sortEntries.begin(), m_sortEntries.end(), entryLess);
+		return;
+	}
+
+	// first entry of each block, followed by the entry count
+	int blockCount = pJobSystem->GetThreadCount();
+	std::vector<int> blockStarts(blockCount + 1);
+	for (int block = 0; block <= blockCount; block++)
+	{
+		blockStarts[block] = (int)((int64_t)count * block / blockCount);
+	}
+
+	pJobSystem->ParallelFor(blockCount, 1,
+		[this, &blockStarts, &entryLess](int first, int last)
+		{
+			for (int block = first; block < last; block++)
+			{
+				std::sort(m_sortEntries.begin() + blockStarts[block],
+					m_sortEntries.begin() + blockStarts[block + 1], entryLess);
+			}
+		});
+
+	// merge neighbouring runs of sorted blocks into the other
+	// array, doubling the length of the runs every round
+	m_mergedEntries.resize(count);
+	for (int runBlocks = 1; runBlocks < blockCount; runBlocks *= 2)
+	{
+		int pairCount = (blockCount + runBlocks * 2 - 1) / (runBlocks * 2);
+		pJobSystem->ParallelFor(pairCount, 1,
+			[this, &blockStarts, &entryLess, runBlocks, blockCount](int first, int last)
+			{
+				for (int pair = first; pair < last; pair++)
+				{
+					int firstBlock = pair * runBlocks * 2;
+					int start = blockStarts[firstBlock];
+					int middle = blockStarts[std::min(firstBlock + runBlocks, blockCount)];
+					int end = blockStarts[std::min(firstBlock + runBlocks * 2, blockCount)];
+					std::merge(
+						m_sortEntries.begin() + start, m_sortEntries.begin() + middle,
+						m_sortEntries.begin() + middle, m_sortEntries.begin() + end,
+						m_mergedEntries.begin() + start, entryLess);
+				}
+			});
+		m_sortEntries.swap(m_mergedEntries);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.h
+// ============
+// retained list of draw items submitted in state-sorted order
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "JobSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// basic shape meshes that a draw item can reference
+enum MESH_TYPE
+{
+	MESH_PLANE = 0,
+	MESH_BOX,
+	MESH_CYLINDER,
+	MESH_TAPERED_CYLINDER,
+	MESH_CONE,
+	MESH_SPHERE,
+	MESH_TORUS,
+	MESH_PRISM,
+	MESH_PYRAMID4,
+	MESH_COUNT
+};
+
+/***********************************************************
+ *  RenderQueue
+ *
+ *  This class holds the draw items of the 3D scene between
+ *  frames.  Each frame the items are ordered by a packed
+ *  64-bit sort key so that opaque items are grouped by
+ *  shader, texture and material, and transparent items are
+ *  drawn afterwards from back to front.
+ ***********************************************************/
+class RenderQueue
+{
+public:
+	// constructor
+	RenderQueue();
+	// destructor
+	~RenderQueue();
+
+	struct DRAW_ITEM
+	{
+		MESH_TYPE mesh;
+		int shaderID;
+		int materialID;
+		int textureSlot;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		glm::mat4 transform;
+		bool bTransparent;
+		// level of detail of the mesh, 0 being the most detailed,
+		// picked from the projected size of the item every frame
+		int detailLevel;
+		// true for items that are not expected to move, which can
+		// be baked into merged vertex buffers
+		bool bStatic;
+	};
+
+	// add an item to the queue and return its index
+	int AddItem(const DRAW_ITEM& item);
+	// access a previously added item
+	DRAW_ITEM& GetItem(int index) { return(m_items[index]); }
+	const DRAW_ITEM& GetItem(int index) const { return(m_items[index]); }
+	// number of items in the queue
+	int GetItemCount() const { return((int)m_items.size()); }
+	// make room for a number of items
+	void Reserve(int count);
+	// remove all the items from the queue
+	void Clear();
+
+	// order the items for the passed in camera position, building
+	// the keys and sorting on the threads of the job system when
+	// one is passed in
+	void Sort(const glm::vec3& viewPosition, float farPlane, JobSystem* pJobSystem = NULL);
+	// order only the passed in items, such as the visible ones
+	void Sort(const glm::vec3& viewPosition, float farPlane, const std::vector<int>& itemIndices, JobSystem* pJobSystem = NULL);
+	// item indices in submission order after sorting
+	const std::vector<int>& GetSortedItems() const { return(m_sortedItems); }
+
+	// build the sort key for an item at the passed in depth
+	static uint64_t MakeSortKey(const DRAW_ITEM& item, float normalizedDepth);
+
+private:
+	struct SORT_ENTRY
+	{
+		uint64_t key;
+		int index;
+	};
+
+	// retained draw items
+	std::vector<DRAW_ITEM> m_items;
+	// sort keys rebuilt every frame
+	std::vector<SORT_ENTRY> m_sortEntries;
+	// sorted blocks of entries merged by a threaded sort
+	std::vector<SORT_ENTRY> m_mergedEntries;
+	// item indices in submission order
+	std::vector<int> m_sortedItems;
+
+	// order the items at the passed in indices, or all the
+	// items when no indices are passed in
+	void SortItems(const glm::vec3& viewPosition, float farPlane, const int* itemIndices, int count, JobSystem* pJobSystem);
+	// sort the entries in blocks on the threads of the job
+	// system, then merge the sorted blocks
+	void SortEntries(JobSystem* pJobSystem);
+};
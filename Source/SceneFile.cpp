@@ -0,0 +1,657 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// read scene descriptions from text and memory-mapped binary files
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+// declaration of the binary scene file layout
+namespace
+{
+	// "SCN1" - identifies a binary scene file
+	const uint32_t SCENE_MAGIC = 0x314E4353;
+	// bumped whenever the layout of the records changes
+	const uint32_t SCENE_VERSION = 2;
+	// extension added to a text scene file for its binary form
+	const char* BINARY_EXTENSION = "bin";
+
+	// the records follow the header in this order, then the
+	// string table, which starts with an empty string
+	struct SCENE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceSize;
+		int64_t sourceModifiedTime;
+		uint32_t textureCount;
+		uint32_t materialCount;
+		uint32_t lightCount;
+		uint32_t nodeCount;
+		uint32_t stringSize;
+		uint32_t reserved;
+	};
+
+	// the records are used in place, so their layout must not
+	// depend on the compiler
+	static_assert(sizeof(SCENE_HEADER) == 48, "scene header layout");
+	static_assert(sizeof(SceneFile::SCENE_TEXTURE) == 8, "scene texture layout");
+	static_assert(sizeof(SceneFile::SCENE_MATERIAL) == 52, "scene material layout");
+	static_assert(sizeof(SceneFile::SCENE_LIGHT) == 56, "scene light layout");
+	static_assert(sizeof(SceneFile::SCENE_NODE) == 68, "scene node layout");
+
+	// mesh names used in text scene files
+	const char* MESH_NAMES[MESH_COUNT] =
+	{
+		"plane",
+		"box",
+		"cylinder",
+		"taperedcylinder",
+		"cone",
+		"sphere",
+		"torus",
+		"prism",
+		"pyramid4"
+	};
+
+	/***********************************************************
+	 *  TEXT_LINE
+	 *
+	 *  Splits one line of a text scene file into tokens.  The
+	 *  tokens point into the file contents, which end with a
+	 *  terminating zero, so numbers are read in place.
+	 ***********************************************************/
+	struct TEXT_LINE
+	{
+		const char* cursor;
+		const char* end;
+
+		bool ReadToken(std::string_view& token)
+		{
+			while ((cursor < end) && ((*cursor == ' ') || (*cursor == '\t') || (*cursor == '\r')))
+			{
+				cursor++;
+			}
+			if ((cursor >= end) || (*cursor == '#'))
+			{
+				return(false);
+			}
+
+			const char* start = cursor;
+			while ((cursor < end) && (*cursor != ' ') && (*cursor != '\t') && (*cursor != '\r') && (*cursor != '#'))
+			{
+				cursor++;
+			}
+			token = std::string_view(start, cursor - start);
+
+			return(true);
+		}
+
+		bool ReadFloat(float& value)
+		{
+			std::string_view token;
+			if (ReadToken(token) == false)
+			{
+				return(false);
+			}
+
+			char* numberEnd = NULL;
+			value = strtof(token.data(), &numberEnd);
+
+			return(numberEnd == token.data() + token.size());
+		}
+
+		bool ReadVec3(glm::vec3& value)
+		{
+			return((ReadFloat(value.x) == true) && (ReadFloat(value.y) == true) && (ReadFloat(value.z) == true));
+		}
+
+		bool IsEmpty()
+		{
+			std::string_view token;
+			return(ReadToken(token) == false);
+		}
+	};
+
+	/***********************************************************
+	 *  STRING_TABLE
+	 *
+	 *  Collects the strings of a text scene file, storing each
+	 *  distinct string once.
+	 ***********************************************************/
+	struct STRING_TABLE
+	{
+		std::string data;
+		std::unordered_map<std::string_view, uint32_t> offsets;
+
+		STRING_TABLE()
+		{
+			// offset 0 is the empty string, used for -
+			data.push_back('\0');
+		}
+
+		uint32_t Add(std::string_view text)
+		{
+			if ((text.empty() == true) || (text == "-"))
+			{
+				return(0);
+			}
+
+			std::unordered_map<std::string_view, uint32_t>::iterator found = offsets.find(text);
+			if (found != offsets.end())
+			{
+				return(found->second);
+			}
+
+			uint32_t offset = (uint32_t)data.size();
+			data.append(text.data(), text.size());
+			data.push_back('\0');
+			offsets[text] = offset;
+
+			return(offset);
+		}
+	};
+
+	/***********************************************************
+	 *  AppendRecords()
+	 *
+	 *  Append an array of records to binary scene data.
+	 ***********************************************************/
+	template<typename T>
+	void AppendRecords(std::vector<unsigned char>& image, const std::vector<T>& records)
+	{
+		const unsigned char* bytes = (const unsigned char*)records.data();
+		image.insert(image.end(), bytes, bytes + records.size() * sizeof(T));
+	}
+}
+
+/***********************************************************
+ *  SceneFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneFile::SceneFile()
+{
+	m_textures = NULL;
+	m_textureCount = 0;
+	m_materials = NULL;
+	m_materialCount = 0;
+	m_lights = NULL;
+	m_lightCount = 0;
+	m_nodes = NULL;
+	m_nodeCount = 0;
+	m_objectCount = 0;
+	m_strings = NULL;
+}
+
+/***********************************************************
+ *  ~SceneFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneFile::~SceneFile()
+{
+	Close();
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for opening a scene file.  A binary
+ *  file is mapped and used in place.  A text file is read
+ *  from its binary form when that was compiled from the
+ *  current text, otherwise it is compiled again and the
+ *  binary form is rewritten for the next run.
+ ***********************************************************/
+bool SceneFile::Open(const std::string& filename)
+{
+	uint64_t sourceSize = 0;
+	int64_t sourceModifiedTime = 0;
+
+	Close();
+
+	// binary files opened directly have no text to compare with
+	std::string extension = std::filesystem::path(filename).extension().string();
+	if (extension == std::string(".scene") + BINARY_EXTENSION)
+	{
+		if ((m_file.Open(filename) == false) ||
+			(Attach(m_file.GetData(), m_file.GetSize(), sourceSize, sourceModifiedTime) == false))
+		{
+			std::cout << "Could not read scene file:" << filename << std::endl;
+			Close();
+			return(false);
+		}
+		return(true);
+	}
+
+	uint64_t textSize = 0;
+	int64_t textModifiedTime = 0;
+	if (MappedFile::GetFileStamp(filename, textSize, textModifiedTime) == false)
+	{
+		return(false);
+	}
+
+	std::string binaryFile = filename + BINARY_EXTENSION;
+	if ((m_file.Open(binaryFile) == true) &&
+		(Attach(m_file.GetData(), m_file.GetSize(), sourceSize, sourceModifiedTime) == true) &&
+		(sourceSize == textSize) &&
+		(sourceModifiedTime == textModifiedTime))
+	{
+		return(true);
+	}
+	Close();
+
+	if (Parse(filename, m_image) == false)
+	{
+		Close();
+		return(false);
+	}
+
+	// stamp the compiled data with the text it came from
+	SCENE_HEADER header;
+	memcpy(&header, m_image.data(), sizeof(header));
+	header.sourceSize = textSize;
+	header.sourceModifiedTime = textModifiedTime;
+	memcpy(m_image.data(), &header, sizeof(header));
+
+	// the scene can still be loaded if the binary file cannot be written
+	WriteImage(binaryFile, m_image);
+
+	return(Attach(m_image.data(), m_image.size(), sourceSize, sourceModifiedTime));
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for releasing the mapped file or the
+ *  compiled scene data.
+ ***********************************************************/
+void SceneFile::Close()
+{
+	m_file.Close();
+	m_image.clear();
+	m_image.shrink_to_fit();
+
+	m_textures = NULL;
+	m_textureCount = 0;
+	m_materials = NULL;
+	m_materialCount = 0;
+	m_lights = NULL;
+	m_lightCount = 0;
+	m_nodes = NULL;
+	m_nodeCount = 0;
+	m_objectCount = 0;
+	m_strings = NULL;
+}
+
+/***********************************************************
+ *  Compile()
+ *
+ *  This method is used for compiling a text scene file into
+ *  a binary scene file, for shipping scenes without their
+ *  text form.
+ ***********************************************************/
+bool SceneFile::Compile(const std::string& textFile, const std::string& binaryFile)
+{
+	std::vector<unsigned char> image;
+	if (Parse(textFile, image) == false)
+	{
+		return(false);
+	}
+
+	return(WriteImage(binaryFile, image));
+}
+
+/***********************************************************
+ *  Attach()
+ *
+ *  This method is used for checking binary scene data and
+ *  pointing the records into it.  Every offset and index is
+ *  checked once here, so the records can be used afterwards
+ *  without any further checks.
+ ***********************************************************/
+bool SceneFile::Attach(const unsigned char* data, size_t size, uint64_t& sourceSize, int64_t& sourceModifiedTime)
+{
+	if ((NULL == data) || (size < sizeof(SCENE_HEADER)))
+	{
+		return(false);
+	}
+
+	SCENE_HEADER header;
+	memcpy(&header, data, sizeof(header));
+	if ((header.magic != SCENE_MAGIC) || (header.version != SCENE_VERSION) || (header.stringSize == 0))
+	{
+		return(false);
+	}
+
+	uint64_t texturesOffset = sizeof(SCENE_HEADER);
+	uint64_t materialsOffset = texturesOffset + (uint64_t)header.textureCount * sizeof(SCENE_TEXTURE);
+	uint64_t lightsOffset = materialsOffset + (uint64_t)header.materialCount * sizeof(SCENE_MATERIAL);
+	uint64_t nodesOffset = lightsOffset + (uint64_t)header.lightCount * sizeof(SCENE_LIGHT);
+	uint64_t stringsOffset = nodesOffset + (uint64_t)header.nodeCount * sizeof(SCENE_NODE);
+	if ((stringsOffset + header.stringSize != (uint64_t)size) ||
+		(data[size - 1] != '\0'))
+	{
+		return(false);
+	}
+
+	const SCENE_TEXTURE* textures = (const SCENE_TEXTURE*)(data + texturesOffset);
+	const SCENE_MATERIAL* materials = (const SCENE_MATERIAL*)(data + materialsOffset);
+	const SCENE_NODE* nodes = (const SCENE_NODE*)(data + nodesOffset);
+	uint32_t stringSize = header.stringSize;
+
+	for (uint32_t i = 0; i < header.textureCount; i++)
+	{
+		if ((textures[i].tag >= stringSize) || (textures[i].path >= stringSize))
+		{
+			return(false);
+		}
+	}
+	for (uint32_t i = 0; i < header.materialCount; i++)
+	{
+		if (materials[i].tag >= stringSize)
+		{
+			return(false);
+		}
+	}
+
+	uint32_t objectCount = 0;
+	for (uint32_t i = 0; i < header.nodeCount; i++)
+	{
+		const SCENE_NODE& node = nodes[i];
+		if ((node.name >= stringSize) ||
+			(node.texture >= stringSize) ||
+			(node.material >= stringSize) ||
+			(node.parent < NO_PARENT) || (node.parent >= (int32_t)i) ||
+			(node.mesh < NO_MESH) || (node.mesh >= MESH_COUNT))
+		{
+			return(false);
+		}
+		if (node.mesh != NO_MESH)
+		{
+			objectCount++;
+		}
+	}
+
+	m_textures = textures;
+	m_textureCount = header.textureCount;
+	m_materials = materials;
+	m_materialCount = header.materialCount;
+	m_lights = (const SCENE_LIGHT*)(data + lightsOffset);
+	m_lightCount = header.lightCount;
+	m_nodes = nodes;
+	m_nodeCount = header.nodeCount;
+	m_objectCount = objectCount;
+	m_strings = (const char*)(data + stringsOffset);
+
+	sourceSize = header.sourceSize;
+	sourceModifiedTime = header.sourceModifiedTime;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Parse()
+ *
+ *  This method is used for compiling a text scene file into
+ *  binary scene data.  The first error found is reported
+ *  with its line number and nothing is compiled.
+ ***********************************************************/
+bool SceneFile::Parse(const std::string& textFile, std::vector<unsigned char>& image)
+{
+	std::ifstream file(textFile, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not open scene file:" << textFile << std::endl;
+		return(false);
+	}
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::string text = contents.str();
+
+	std::vector<SCENE_TEXTURE> textures;
+	std::vector<SCENE_MATERIAL> materials;
+	std::vector<SCENE_LIGHT> lights;
+	std::vector<SCENE_NODE> nodes;
+	STRING_TABLE strings;
+	std::unordered_map<std::string_view, int32_t> nodeNames;
+
+	const char* cursor = text.c_str();
+	const char* textEnd = cursor + text.size();
+	int lineNumber = 0;
+
+	while (cursor < textEnd)
+	{
+		const char* lineEnd = (const char*)memchr(cursor, '\n', textEnd - cursor);
+		if (NULL == lineEnd)
+		{
+			lineEnd = textEnd;
+		}
+		lineNumber++;
+
+		TEXT_LINE line;
+		line.cursor = cursor;
+		line.end = lineEnd;
+		cursor = lineEnd + 1;
+
+		std::string_view keyword;
+		if (line.ReadToken(keyword) == false)
+		{
+			continue;
+		}
+
+		bool bValid = false;
+		if (keyword == "texture")
+		{
+			std::string_view tag;
+			std::string_view path;
+			if ((line.ReadToken(tag) == true) && (line.ReadToken(path) == true))
+			{
+				SCENE_TEXTURE texture;
+				texture.tag = strings.Add(tag);
+				texture.path = strings.Add(path);
+				textures.push_back(texture);
+				bValid = line.IsEmpty();
+			}
+		}
+		else if (keyword == "material")
+		{
+			std::string_view tag;
+			SCENE_MATERIAL material;
+			material.flags = 0;
+			if ((line.ReadToken(tag) == true) &&
+				(line.ReadVec3(material.ambientColor) == true) &&
+				(line.ReadFloat(material.ambientStrength) == true) &&
+				(line.ReadVec3(material.diffuseColor) == true) &&
+				(line.ReadVec3(material.specularColor) == true) &&
+				(line.ReadFloat(material.shininess) == true))
+			{
+				material.tag = strings.Add(tag);
+
+				std::string_view option;
+				bValid = true;
+				if (line.ReadToken(option) == true)
+				{
+					material.flags |= MATERIAL_TRANSPARENT;
+					bValid = (option == "transparent") && (line.IsEmpty() == true);
+				}
+				materials.push_back(material);
+			}
+		}
+		else if (keyword == "light")
+		{
+			SCENE_LIGHT light;
+			if ((line.ReadVec3(light.position) == true) &&
+				(line.ReadVec3(light.ambientColor) == true) &&
+				(line.ReadVec3(light.diffuseColor) == true) &&
+				(line.ReadVec3(light.specularColor) == true) &&
+				(line.ReadFloat(light.focalStrength) == true) &&
+				(line.ReadFloat(light.specularIntensity) == true))
+			{
+				lights.push_back(light);
+				bValid = line.IsEmpty();
+			}
+		}
+		else if ((keyword == "node") || (keyword == "object"))
+		{
+			std::string_view name;
+			std::string_view parent;
+			std::string_view mesh;
+			std::string_view texture;
+			std::string_view material;
+			SCENE_NODE node;
+			node.mesh = NO_MESH;
+			node.uvScale = glm::vec2(1.0f, 1.0f);
+			node.flags = 0;
+
+			bValid = (line.ReadToken(name) == true) && (line.ReadToken(parent) == true);
+			if ((bValid == true) && (keyword == "object"))
+			{
+				bValid = (line.ReadToken(mesh) == true) &&
+					(line.ReadToken(texture) == true) &&
+					(line.ReadToken(material) == true);
+				for (int i = 0; (i < MESH_COUNT) && (bValid == true); i++)
+				{
+					if (mesh == MESH_NAMES[i])
+					{
+						node.mesh = i;
+					}
+				}
+				bValid = (bValid == true) && (node.mesh != NO_MESH);
+			}
+			bValid = (bValid == true) &&
+				(line.ReadVec3(node.scale) == true) &&
+				(line.ReadVec3(node.rotation) == true) &&
+				(line.ReadVec3(node.position) == true);
+
+			// the texture scale and the static option of objects are
+			// optional
+			if ((bValid == true) && (keyword == "object"))
+			{
+				const char* optionStart = line.cursor;
+				if (line.ReadFloat(node.uvScale.x) == true)
+				{
+					bValid = line.ReadFloat(node.uvScale.y);
+				}
+				else
+				{
+					line.cursor = optionStart;
+				}
+
+				std::string_view option;
+				if ((bValid == true) && (line.ReadToken(option) == true))
+				{
+					node.flags |= NODE_STATIC;
+					bValid = (option == "static");
+				}
+			}
+			bValid = (bValid == true) && (line.IsEmpty() == true);
+
+			// parents must be defined before their children
+			node.parent = NO_PARENT;
+			if ((bValid == true) && (parent != "-"))
+			{
+				std::unordered_map<std::string_view, int32_t>::iterator found = nodeNames.find(parent);
+				if (found == nodeNames.end())
+				{
+					std::cout << "Scene file " << textFile << " line " << lineNumber << ": unknown parent " << parent << std::endl;
+					return(false);
+				}
+				node.parent = found->second;
+			}
+
+			if (bValid == true)
+			{
+				node.name = strings.Add(name);
+				node.texture = strings.Add(texture);
+				node.material = strings.Add(material);
+				if (name != "-")
+				{
+					nodeNames[name] = (int32_t)nodes.size();
+				}
+				nodes.push_back(node);
+			}
+		}
+
+		if (bValid == false)
+		{
+			std::cout << "Scene file " << textFile << " line " << lineNumber << ": could not read " << keyword << std::endl;
+			return(false);
+		}
+	}
+
+	SCENE_HEADER header;
+	memset(&header, 0, sizeof(header));
+	header.magic = SCENE_MAGIC;
+	header.version = SCENE_VERSION;
+	header.textureCount = (uint32_t)textures.size();
+	header.materialCount = (uint32_t)materials.size();
+	header.lightCount = (uint32_t)lights.size();
+	header.nodeCount = (uint32_t)nodes.size();
+	header.stringSize = (uint32_t)strings.data.size();
+
+	image.clear();
+	image.reserve(sizeof(header) +
+		textures.size() * sizeof(SCENE_TEXTURE) +
+		materials.size() * sizeof(SCENE_MATERIAL) +
+		lights.size() * sizeof(SCENE_LIGHT) +
+		nodes.size() * sizeof(SCENE_NODE) +
+		strings.data.size());
+	image.insert(image.end(), (const unsigned char*)&header, (const unsigned char*)&header + sizeof(header));
+	AppendRecords(image, textures);
+	AppendRecords(image, materials);
+	AppendRecords(image, lights);
+	AppendRecords(image, nodes);
+	image.insert(image.end(), strings.data.begin(), strings.data.end());
+
+	return(true);
+}
+
+/***********************************************************
+ *  WriteImage()
+ *
+ *  This method is used for writing binary scene data to a
+ *  file, through a temporary file so a partially written
+ *  scene is never mapped by another run.
+ ***********************************************************/
+bool SceneFile::WriteImage(const std::string& binaryFile, const std::vector<unsigned char>& image)
+{
+	std::string tempFile = binaryFile + ".tmp";
+	{
+		std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return(false);
+		}
+
+		file.write((const char*)image.data(), image.size());
+		if (!file)
+		{
+			return(false);
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempFile, binaryFile, error);
+	if (error)
+	{
+		std::cout << "Could not write scene file:" << binaryFile << std::endl;
+		std::filesystem::remove(tempFile, error);
+		return(false);
+	}
+
+	return(true);
+}
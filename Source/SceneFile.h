@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// read scene descriptions from text and memory-mapped binary files
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MappedFile.h"
+#include "RenderQueue.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneFile
+ *
+ *  This class reads the textures, materials, lights and
+ *  objects of a 3D scene from a scene file.  Scenes are
+ *  written as text (.scene) and compiled into a binary form
+ *  (.scenebin) made of fixed-size records and one string
+ *  table, which is memory-mapped and used in place.  A text
+ *  file is compiled the first time it is opened, and again
+ *  whenever it changes; a binary file can also be opened on
+ *  its own when the text file is not shipped.
+ *
+ *  Text lines, with # starting a comment:
+ *
+ *  texture <tag> <path>
+ *  material <tag> <ambient r g b> <ambient strength>
+ *     <diffuse r g b> <specular r g b> <shininess> [transparent]
+ *  light <position x y z> <ambient r g b> <diffuse r g b>
+ *     <specular r g b> <focal strength> <specular intensity>
+ *  node <name> <parent> <scale x y z> <rotation x y z>
+ *     <position x y z>
+ *  object <name> <parent> <mesh> <texture> <material>
+ *     <scale x y z> <rotation x y z> <position x y z> [<uv u v>]
+ *     [static]
+ *
+ *  A parent is the name of an earlier node or object, and
+ *  - stands for no parent, name, texture or material.
+ *  Static objects never move, so they are merged into the
+ *  static batches of the scene.
+ ***********************************************************/
+class SceneFile
+{
+public:
+	// constructor
+	SceneFile();
+	// destructor
+	~SceneFile();
+
+	// parent of root nodes, and mesh of nodes without one
+	static const int32_t NO_PARENT = -1;
+	static const int32_t NO_MESH = -1;
+	// material flags
+	static const uint32_t MATERIAL_TRANSPARENT = 1;
+	// node flags
+	static const uint32_t NODE_STATIC = 1;
+
+	// records as they are laid out in the binary file - the
+	// strings are offsets into the string table
+	struct SCENE_TEXTURE
+	{
+		uint32_t tag;
+		uint32_t path;
+	};
+
+	struct SCENE_MATERIAL
+	{
+		uint32_t tag;
+		uint32_t flags;
+		glm::vec3 ambientColor;
+		float ambientStrength;
+		glm::vec3 diffuseColor;
+		float shininess;
+		glm::vec3 specularColor;
+	};
+
+	struct SCENE_LIGHT
+	{
+		glm::vec3 position;
+		float focalStrength;
+		glm::vec3 ambientColor;
+		float specularIntensity;
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+	};
+
+	// transform values are relative to the parent node, which
+	// always comes earlier in the file
+	struct SCENE_NODE
+	{
+		uint32_t name;
+		int32_t parent;
+		int32_t mesh;
+		uint32_t texture;
+		uint32_t material;
+		glm::vec3 scale;
+		glm::vec3 rotation;
+		glm::vec3 position;
+		glm::vec2 uvScale;
+		uint32_t flags;
+	};
+
+	// open a text or binary scene file
+	bool Open(const std::string& filename);
+	// release the scene data
+	void Close();
+	// compile a text scene file into a binary scene file
+	static bool Compile(const std::string& textFile, const std::string& binaryFile);
+
+	// scene records
+	int GetTextureCount() const { return((int)m_textureCount); }
+	const SCENE_TEXTURE& GetTexture(int index) const { return(m_textures[index]); }
+	int GetMaterialCount() const { return((int)m_materialCount); }
+	const SCENE_MATERIAL& GetMaterial(int index) const { return(m_materials[index]); }
+	int GetLightCount() const { return((int)m_lightCount); }
+	const SCENE_LIGHT& GetLight(int index) const { return(m_lights[index]); }
+	int GetNodeCount() const { return((int)m_nodeCount); }
+	const SCENE_NODE& GetNode(int index) const { return(m_nodes[index]); }
+	// number of nodes that have a mesh
+	int GetObjectCount() const { return((int)m_objectCount); }
+	// string stored at an offset of the string table
+	const char* GetString(uint32_t offset) const { return(m_strings + offset); }
+
+private:
+	// mapped binary file
+	MappedFile m_file;
+	// compiled text file, when it is not read from the binary file
+	std::vector<unsigned char> m_image;
+	// records inside the mapped file or the compiled image
+	const SCENE_TEXTURE* m_textures;
+	uint32_t m_textureCount;
+	const SCENE_MATERIAL* m_materials;
+	uint32_t m_materialCount;
+	const SCENE_LIGHT* m_lights;
+	uint32_t m_lightCount;
+	const SCENE_NODE* m_nodes;
+	uint32_t m_nodeCount;
+	uint32_t m_objectCount;
+	const char* m_strings;
+
+	// check the binary scene data and point the records into it,
+	// returning the source stamp it was compiled from
+	bool Attach(const unsigned char* data, size_t size, uint64_t& sourceSize, int64_t& sourceModifiedTime);
+	// compile a text scene file into binary scene data
+	static bool Parse(const std::string& textFile, std::vector<unsigned char>& image);
+	// write binary scene data to a file
+	static bool WriteImage(const std::string& binaryFile, const std::vector<unsigned char>& image);
+};
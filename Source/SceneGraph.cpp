@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegraph.cpp
+// ============
+// parent/child hierarchy of the scene objects and their world matrices
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneGraph.h"
+
+#include <algorithm>
+
+/***********************************************************
+ *  SceneGraph()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneGraph::SceneGraph()
+{
+}
+
+/***********************************************************
+ *  ~SceneGraph()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneGraph::~SceneGraph()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  AddNode()
+ *
+ *  This method is used for adding a node under an existing
+ *  parent, or as a root node when the parent is -1.  The
+ *  world matrix of the new node is computed by the next
+ *  update.  -1 is returned when the parent does not exist.
+ ***********************************************************/
+int SceneGraph::AddNode(int parent, const glm::mat4& localTransform)
+{
+	if ((parent < -1) || (parent >= GetNodeCount()))
+	{
+		return(-1);
+	}
+
+	int node = GetNodeCount();
+
+	m_parents.push_back(parent);
+	m_firstChildren.push_back(-1);
+	m_nextSiblings.push_back(-1);
+	m_items.push_back(-1);
+	m_localTransforms.push_back(localTransform);
+	m_worldTransforms.push_back(localTransform);
+	m_bDirty.push_back(true);
+	m_dirtyNodes.push_back(node);
+
+	// link the node in front of the children of its parent
+	if (parent >= 0)
+	{
+		m_nextSiblings[node] = m_firstChildren[parent];
+		m_firstChildren[parent] = node;
+	}
+
+	return(node);
+}
+
+/***********************************************************
+ *  SetLocalTransform()
+ *
+ *  This method is used for moving a node relative to its
+ *  parent.  The node and its subtree are recomputed by the
+ *  next update.
+ ***********************************************************/
+void SceneGraph::SetLocalTransform(int node, const glm::mat4& localTransform)
+{
+	if ((node < 0) || (node >= GetNodeCount()))
+	{
+		return;
+	}
+
+	m_localTransforms[node] = localTransform;
+
+	if (m_bDirty[node] == false)
+	{
+		m_bDirty[node] = true;
+		m_dirtyNodes.push_back(node);
+	}
+}
+
+/***********************************************************
+ *  SetItem()
+ *
+ *  This method is used for attaching a draw item to a node,
+ *  so the item follows the world matrix of the node.
+ ***********************************************************/
+void SceneGraph::SetItem(int node, int item)
+{
+	if ((node < 0) || (node >= GetNodeCount()))
+	{
+		return;
+	}
+
+	m_items[node] = item;
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for a number of
+ *  nodes, so adding them does not reallocate.
+ ***********************************************************/
+void SceneGraph::Reserve(int count)
+{
+	m_parents.reserve(count);
+	m_firstChildren.reserve(count);
+	m_nextSiblings.reserve(count);
+	m_items.reserve(count);
+	m_localTransforms.reserve(count);
+	m_worldTransforms.reserve(count);
+	m_dirtyNodes.reserve(count);
+	m_bDirty.reserve(count);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the nodes.
+ ***********************************************************/
+void SceneGraph::Clear()
+{
+	m_parents.clear();
+	m_firstChildren.clear();
+	m_nextSiblings.clear();
+	m_items.clear();
+	m_localTransforms.clear();
+	m_worldTransforms.clear();
+	m_dirtyNodes.clear();
+	m_bDirty.clear();
+	m_walkStack.clear();
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for recomputing the world matrices
+ *  of the nodes moved since the last update, along with
+ *  their subtrees.  The dirty nodes are visited in index
+ *  order, so an ancestor is always visited before its
+ *  descendants and a subtree is never computed twice.
+ ***********************************************************/
+void SceneGraph::Update(std::vector<int>& changedNodes)
+{
+	changedNodes.clear();
+
+	std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end());
+
+	for (size_t i = 0; i < m_dirtyNodes.size(); i++)
+	{
+		// nodes below an already updated ancestor are clean
+		if (m_bDirty[m_dirtyNodes[i]] == true)
+		{
+			UpdateSubtree(m_dirtyNodes[i], changedNodes);
+		}
+	}
+
+	m_dirtyNodes.clear();
+}
+
+/***********************************************************
+ *  UpdateSubtree()
+ *
+ *  This method is used for recomputing the world matrix of
+ *  a node from the world matrix of its parent, and then the
+ *  world matrices of all the nodes below it.
+ ***********************************************************/
+void SceneGraph::UpdateSubtree(int node, std::vector<int>& changedNodes)
+{
+	m_walkStack.clear();
+	m_walkStack.push_back(node);
+
+	while (m_walkStack.empty() == false)
+	{
+		int current = m_walkStack.back();
+		m_walkStack.pop_back();
+
+		int parent = m_parents[current];
+		if (parent >= 0)
+		{
+			m_worldTransforms[current] = m_worldTransforms[parent] * m_localTransforms[current];
+		}
+		else
+		{
+			m_worldTransforms[current] = m_localTransforms[current];
+		}
+		m_bDirty[current] = false;
+		changedNodes.push_back(current);
+
+		for (int child = m_firstChildren[current]; child >= 0; child = m_nextSiblings[child])
+		{
+			m_walkStack.push_back(child);
+		}
+	}
+}
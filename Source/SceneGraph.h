@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegraph.h
+// ============
+// parent/child hierarchy of the scene objects and their world matrices
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  SceneGraph
+ *
+ *  This class links the scene objects into a hierarchy of
+ *  nodes, each with a transform local to its parent.  The
+ *  nodes are kept in flat arrays, and a parent is always
+ *  added before its children so its index is lower.  Moving
+ *  a node flags it as dirty, and the next update recomputes
+ *  the world matrices of the dirty nodes and their subtrees
+ *  only.
+ ***********************************************************/
+class SceneGraph
+{
+public:
+	// constructor
+	SceneGraph();
+	// destructor
+	~SceneGraph();
+
+	// add a node under the parent, or a root node when the
+	// parent is -1, and return its index
+	int AddNode(int parent, const glm::mat4& localTransform);
+	// change the transform of a node relative to its parent
+	void SetLocalTransform(int node, const glm::mat4& localTransform);
+	// draw item positioned by a node
+	void SetItem(int node, int item);
+	// make room for a number of nodes
+	void Reserve(int count);
+	// remove all the nodes
+	void Clear();
+
+	// recompute the world matrices of the dirty subtrees and
+	// list the nodes whose world matrices changed
+	void Update(std::vector<int>& changedNodes);
+	// true when nodes moved since the last update
+	bool IsDirty() const { return(m_dirtyNodes.size() > 0); }
+
+	// number of nodes
+	int GetNodeCount() const { return((int)m_parents.size()); }
+	// parent of a node, or -1 for a root node
+	int GetParent(int node) const { return(m_parents[node]); }
+	// draw item positioned by a node, or -1
+	int GetItem(int node) const { return(m_items[node]); }
+	// transform of a node relative to its parent
+	const glm::mat4& GetLocalTransform(int node) const { return(m_localTransforms[node]); }
+	// world matrix computed by the last update
+	const glm::mat4& GetWorldTransform(int node) const { return(m_worldTransforms[node]); }
+
+private:
+	// hierarchy links, -1 when there is none
+	std::vector<int> m_parents;
+	std::vector<int> m_firstChildren;
+	std::vector<int> m_nextSiblings;
+	// draw item of each node, or -1
+	std::vector<int> m_items;
+	// transforms relative to the parents, and to the world
+	std::vector<glm::mat4> m_localTransforms;
+	std::vector<glm::mat4> m_worldTransforms;
+	// nodes moved since the last update
+	std::vector<int> m_dirtyNodes;
+	// true for the nodes waiting for the next update
+	std::vector<bool> m_bDirty;
+	// nodes left to visit while walking a subtree
+	std::vector<int> m_walkStack;
+
+	// recompute the world matrices of a node and its subtree
+	void UpdateSubtree(int node, std::vector<int>& changedNodes);
+};
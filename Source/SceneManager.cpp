@@ -8,6 +8,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SceneManager.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -16,14 +18,54 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <thread>
+
 // declaration of global variables
 namespace
 {
 	const char* g_ModelName = "model";
 	const char* g_ColorValueName = "objectColor";
 	const char* g_TextureValueName = "objectTexture";
+	const char* g_TextureLayerName = "objectTextureLayer";
 	const char* g_UseTextureName = "bUseTexture";
 	const char* g_UseLightingName = "bUseLighting";
+	const char* g_UVScaleName = "UVscale";
+	const char* g_UseInstancingName = "bUseInstancing";
+	const char* g_MaterialIndexName = "materialIndex";
+
+	// distance of the far clipping plane used for depth sorting
+	const float SCENE_FAR_PLANE = 100.0f;
+	// number of background loaded textures uploaded per frame
+	const int TEXTURE_UPLOADS_PER_FRAME = 2;
+	// neutral grey shown for a texture that is not loaded yet
+	const glm::vec4 TEXTURE_PENDING_COLOR = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
+	// scene description loaded by PrepareScene() - the scene
+	// defined in code below is used when it cannot be loaded
+	const char* SCENE_FILENAME = "Scenes/desk.scene";
+	// texture tiling of the scene objects - the floor originally set
+	// this and every object drawn after it kept the same tiling
+	const glm::vec2 SCENE_UV_SCALE = glm::vec2(5.0f, 5.0f);
+	// draw items moved or bounded by one job range
+	const int ITEM_UPDATES_PER_JOB = 512;
+	// projected bounding sphere diameters, as a fraction of the
+	// view height, below which the round meshes use their next
+	// less detailed level
+	const float DETAIL_LEVEL_SIZES[InstancedMeshes::DETAIL_LEVELS - 1] = { 0.1f, 0.03f };
+	// fraction the projected size must move past a level size
+	// before the level changes, so items close to it do not pop
+	// between two levels from one frame to the next
+	const float DETAIL_LEVEL_HYSTERESIS = 0.2f;
+	// closest distance used for the projected size of an item
+	const float DETAIL_MIN_DISTANCE = 0.1f;
+	// smallest projected bounding sphere diameter, as a fraction
+	// of the view height, of a box or plane rasterized as an occluder
+	const float OCCLUDER_MIN_SIZE = 0.1f;
+	// largest number of occluders rasterized per frame
+	const size_t MAX_OCCLUDERS = 32;
 }
 
 /***********************************************************
@@ -31,10 +73,110 @@ namespace
  *
  *  The constructor for the class
  ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
+SceneManager::SceneManager(ShaderManager *pShaderManager, UniformCache* pUniformCache)
 {
 	m_pShaderManager = pShaderManager;
+	m_pUniformCache = pUniformCache;
 	m_basicMeshes = new ShapeMeshes();
+	m_instancedMeshes = new InstancedMeshes();
+	m_textureLoader = new TextureLoader();
+	m_bInstancingSupported = false;
+	m_bMultiDrawEnabled = true;
+	m_lightCount = 0;
+	m_bMaterialsChanged = false;
+	m_bSceneChanged = true;
+	m_bStaticBatchesChanged = false;
+	m_bOcclusionCulling = true;
+	m_bOccludersDrawn = false;
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_viewPosition = glm::vec3(0.0f);
+	m_pProfiler = NULL;
+	m_profileScopes = PROFILE_SCOPES();
+	m_renderStats = RENDER_STATS();
+
+	// the transforms, bounds and sort keys are computed on every
+	// processor core, while OpenGL is only called from this thread
+	m_jobSystem.Start();
+
+	RegisterUniforms();
+}
+
+/***********************************************************
+ *  SetProfiler()
+ *
+ *  This method is used for registering the phases of the
+ *  scene rendering with a profiler, along with one scope
+ *  per mesh type timing every draw of that mesh.
+ ***********************************************************/
+void SceneManager::SetProfiler(FrameProfiler* pProfiler)
+{
+	const char* const DRAW_MESH_NAMES[MESH_COUNT] =
+	{
+		"Draw Plane",
+		"Draw Box",
+		"Draw Cylinder",
+		"Draw Tapered Cylinder",
+		"Draw Cone",
+		"Draw Sphere",
+		"Draw Torus",
+		"Draw Prism",
+		"Draw Pyramid4"
+	};
+
+	m_pProfiler = pProfiler;
+	if (NULL == m_pProfiler)
+	{
+		return;
+	}
+
+	m_profileScopes.textureUploads = m_pProfiler->RegisterScope("Texture Uploads");
+	m_profileScopes.sceneGraph = m_pProfiler->RegisterScope("Scene Graph");
+	m_profileScopes.culling = m_pProfiler->RegisterScope("Culling");
+	m_profileScopes.occlusion = m_pProfiler->RegisterScope("Occlusion");
+	m_profileScopes.sorting = m_pProfiler->RegisterScope("Sorting");
+	m_profileScopes.drawing = m_pProfiler->RegisterScope("Drawing");
+	for (int i = 0; i < MESH_COUNT; i++)
+	{
+		m_profileScopes.drawMesh[i] = m_pProfiler->RegisterScope(DRAW_MESH_NAMES[i]);
+	}
+}
+
+/***********************************************************
+ *  SetWorkerThreads()
+ *
+ *  This method is used for restarting the job system with
+ *  the passed in number of worker threads - with none, the
+ *  scene is updated on the rendering thread alone.
+ ***********************************************************/
+void SceneManager::SetWorkerThreads(int workerCount)
+{
+	m_jobSystem.Stop();
+	m_jobSystem.Start(workerCount);
+}
+
+/***********************************************************
+ *  ResetRenderStats()
+ *
+ *  This method is used for restarting the rendering
+ *  counters, such as before the frames of a benchmark.
+ ***********************************************************/
+void SceneManager::ResetRenderStats()
+{
+	m_renderStats = RENDER_STATS();
+}
+
+/***********************************************************
+ *  IsSceneChanged()
+ *
+ *  This method is used for checking whether the next frame
+ *  would differ from the last rendered one, because objects,
+ *  materials or lights changed or because textures are
+ *  still being loaded.
+ ***********************************************************/
+bool SceneManager::IsSceneChanged()
+{
+	return((m_bSceneChanged == true) || (m_textureLoader->IsBusy() == true));
 }
 
 /***********************************************************
@@ -46,326 +188,1322 @@ SceneManager::~SceneManager()
 {
 	// clear the allocated memory
 	m_pShaderManager = NULL;
+	m_pUniformCache = NULL;
 	delete m_basicMeshes;
 	m_basicMeshes = NULL;
+	delete m_instancedMeshes;
+	m_instancedMeshes = NULL;
 
 	// destroy the created OpenGL textures
 	DestroyGLTextures();
+	delete m_textureLoader;
+	m_textureLoader = NULL;
+	m_staticBatches.Clear();
+	m_jobSystem.Stop();
+}
+
+/***********************************************************
+ *  RegisterUniforms()
+ *
+ *  This method is used for registering every uniform name
+ *  used by the scene with the uniform cache, so that the
+ *  locations are only resolved once instead of on every
+ *  draw call.
+ ***********************************************************/
+void SceneManager::RegisterUniforms()
+{
+	if (NULL == m_pUniformCache)
+	{
+		return;
+	}
+
+	m_uniforms.model = m_pUniformCache->Register<glm::mat4>(g_ModelName);
+	m_uniforms.objectColor = m_pUniformCache->Register<glm::vec4>(g_ColorValueName);
+	m_uniforms.objectTexture = m_pUniformCache->Register<int>(g_TextureValueName);
+	m_uniforms.objectTextureLayer = m_pUniformCache->Register<int>(g_TextureLayerName);
+	m_uniforms.bUseTexture = m_pUniformCache->Register<bool>(g_UseTextureName);
+	m_uniforms.bUseLighting = m_pUniformCache->Register<bool>(g_UseLightingName);
+	m_uniforms.UVscale = m_pUniformCache->Register<glm::vec2>(g_UVScaleName);
+
+	m_uniforms.bUseInstancing = m_pUniformCache->Register<bool>(g_UseInstancingName);
+	m_uniforms.materialIndex = m_pUniformCache->Register<int>(g_MaterialIndexName);
+}
+
+/***********************************************************
+ *  ReserveTextureSlot()
+ *
+ *  This method is used for getting the texture slot of the
+ *  passed in tag, adding an empty slot for a new tag.  The
+ *  interned tag ID is also the texture slot index.
+ ***********************************************************/
+int SceneManager::ReserveTextureSlot(std::string_view tag)
+{
+	int textureSlot = m_textureTags.Intern(tag);
+	if (textureSlot >= (int)m_textureIDs.size())
+	{
+		m_textureIDs.resize(textureSlot + 1);
+		m_textureIDs[textureSlot].tag = tag;
+	}
+
+	return(textureSlot);
 }
 
 /***********************************************************
- *  CreateGLTexture()
+ *  BindGLTextures()
  *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
+ *  This method is used for allocating the texture arrays
+ *  for the layers reserved so far and binding them to
+ *  OpenGL texture units, one unit for every texture size.
  ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+void SceneManager::BindGLTextures()
 {
+	m_textureArrays.BindArrays();
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	m_textureArrays.DestroyArrays();
+	for (size_t i = 0; i < m_textureIDs.size(); i++)
+	{
+		m_textureIDs[i].layer = TextureArrays::TEXTURE_LAYER();
+		m_textureIDs[i].bLoaded = false;
+	}
+}
+
+/***********************************************************
+ *  LoadGLTextureAsync()
+ *
+ *  This method is used for reserving the next texture slot
+ *  for the passed in tag, reserving a texture array layer
+ *  for the size read from the image header, and queueing
+ *  the image file to be decoded in the background.  Objects
+ *  using the slot are drawn in plain grey until
+ *  UpdateTextureLoads() uploads the image into the layer.
+ ***********************************************************/
+bool SceneManager::LoadGLTextureAsync(const char* filename, std::string_view tag)
+{
+	int textureSlot = ReserveTextureSlot(tag);
+
 	int width = 0;
 	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
+	GLenum internalFormat = 0;
+	int levels = 0;
+	if (TextureLoader::ReadImageFormat(filename, width, height, internalFormat, levels) == false)
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return(false);
+	}
+
+	// a reloaded texture moved to a new layer is not drawn until
+	// the new layer is filled
+	TextureArrays::TEXTURE_LAYER& layer = m_textureIDs[textureSlot].layer;
+	int previousArray = layer.arrayIndex;
+	int previousLayer = layer.layer;
+	bool bReserved = m_textureArrays.ReserveLayer(width, height, internalFormat, levels, layer);
+	if ((layer.arrayIndex != previousArray) || (layer.layer != previousLayer))
+	{
+		m_textureIDs[textureSlot].bLoaded = false;
+	}
+	if (bReserved == false)
+	{
+		return(false);
+	}
+
+	m_textureLoader->QueueLoad(filename, textureSlot, layer);
+
+	return(true);
+}
+
+/***********************************************************
+ *  UpdateTextureLoads()
+ *
+ *  This method is used for uploading the textures decoded
+ *  in the background into the texture array layers of
+ *  their slots.
+ ***********************************************************/
+void SceneManager::UpdateTextureLoads()
+{
+	std::vector<TextureLoader::LOADED_TEXTURE> loaded;
+	m_textureLoader->ProcessUploads(TEXTURE_UPLOADS_PER_FRAME, m_textureArrays, loaded);
+
+	for (size_t i = 0; i < loaded.size(); i++)
+	{
+		m_textureIDs[loaded[i].slot].bLoaded = true;
+	}
+}
+
+/***********************************************************
+ *  FinishTextureLoads()
+ *
+ *  This method is used for waiting until every queued
+ *  texture has been decoded and put into its slot, instead
+ *  of letting the textures appear over the first frames.
+ ***********************************************************/
+void SceneManager::FinishTextureLoads()
+{
+	while (m_textureLoader->IsBusy() == true)
+	{
+		UpdateTextureLoads();
+		std::this_thread::yield();
+	}
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(std::string_view tag)
+{
+	int textureSlot = m_textureTags.Find(tag);
+	if (textureSlot >= (int)m_textureIDs.size())
+	{
+		return(-1);
+	}
+
+	return(textureSlot);
+}
+
+/***********************************************************
+ *  FindMaterialID()
+ *
+ *  This method is used for getting the index of a material
+ *  in the defined materials list by its tag.
+ ***********************************************************/
+int SceneManager::FindMaterialID(std::string_view tag)
+{
+	int materialID = m_materialTags.Find(tag);
+	if (materialID >= (int)m_objectMaterials.size())
+	{
+		return(-1);
+	}
+
+	return(materialID);
+}
+
+/***********************************************************
+ *  AddObjectMaterial()
+ *
+ *  This method is used for adding a material to the defined
+ *  materials list.  A material defined with an existing tag
+ *  replaces the earlier definition.
+ ***********************************************************/
+int SceneManager::AddObjectMaterial(const OBJECT_MATERIAL& material)
+{
+	int materialID = m_materialTags.Intern(material.tag);
+	if (materialID < (int)m_objectMaterials.size())
+	{
+		m_objectMaterials[materialID] = material;
+	}
+	else
+	{
+		m_objectMaterials.push_back(material);
+	}
+	m_bMaterialsChanged = true;
+	m_bSceneChanged = true;
+
+	return(materialID);
+}
+
+/***********************************************************
+ *  ComposeTransform()
+ *
+ *  This method is used for composing a model matrix from
+ *  the passed in transformation values.
+ ***********************************************************/
+glm::mat4 SceneManager::ComposeTransform(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 modelView;
+	glm::mat4 scale;
+	glm::mat4 rotationX;
+	glm::mat4 rotationY;
+	glm::mat4 rotationZ;
+	glm::mat4 translation;
+
+	// set the scale value in the transform buffer
+	scale = glm::scale(scaleXYZ);
+	// set the rotation values in the transform buffer
+	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+	// set the translation value in the transform buffer
+	translation = glm::translate(positionXYZ);
+
+	modelView = translation * rotationX * rotationY * rotationZ * scale;
+
+	return(modelView);
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform buffer
+ *  using the passed in transformation values.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	SetModelMatrix(ComposeTransform(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ));
+}
+
+/***********************************************************
+ *  SetModelMatrix()
+ *
+ *  This method is used for setting an already composed
+ *  model matrix into the shader.
+ ***********************************************************/
+void SceneManager::SetModelMatrix(const glm::mat4& modelMatrix)
+{
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->Set(m_uniforms.model, modelMatrix);
+	}
+}
+
+/***********************************************************
+ *  SetShaderLight()
+ *
+ *  This method is used for setting the values of one of the
+ *  scene light sources into the light block.  The changes
+ *  are uploaded together when the next frame is rendered,
+ *  so lights can be moved every frame for the cost of one
+ *  buffer update.
+ ***********************************************************/
+void SceneManager::SetShaderLight(
+	int lightIndex,
+	glm::vec3 position,
+	glm::vec3 ambientColor,
+	glm::vec3 diffuseColor,
+	glm::vec3 specularColor,
+	float focalStrength,
+	float specularIntensity)
+{
+	if ((lightIndex < 0) || (lightIndex >= MAX_LIGHTS))
+	{
+		return;
+	}
+
+	LIGHT_DATA light;
+	light.position = position;
+	light.focalStrength = focalStrength;
+	light.ambientColor = ambientColor;
+	light.specularIntensity = specularIntensity;
+	light.diffuseColor = diffuseColor;
+	light.padding0 = 0.0f;
+	light.specularColor = specularColor;
+	light.padding1 = 0.0f;
+	m_lightBuffer.Write(offsetof(LIGHT_BLOCK, lightSources) + lightIndex * sizeof(LIGHT_DATA), light);
+
+	// the shader only loops over the lights that were set
+	if (lightIndex >= m_lightCount)
+	{
+		m_lightCount = lightIndex + 1;
+		m_lightBuffer.Write(offsetof(LIGHT_BLOCK, numLights), (GLint)m_lightCount);
+	}
+	m_bSceneChanged = true;
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->Set(m_uniforms.bUseTexture, false);
+		m_pUniformCache->Set(m_uniforms.objectColor, currentColor);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in slot into the shader, by
+ *  selecting the texture array unit and the layer holding
+ *  the texture.  A texture that is still loading is shown
+ *  in plain grey.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	std::string_view textureTag)
+{
+	SetShaderTexture(FindTextureSlot(textureTag));
+}
+
+void SceneManager::SetShaderTexture(
+	int textureSlot)
+{
+	if ((textureSlot < 0) || (textureSlot >= (int)m_textureIDs.size()) ||
+		(m_textureIDs[textureSlot].bLoaded == false))
+	{
+		SetShaderColor(TEXTURE_PENDING_COLOR.r, TEXTURE_PENDING_COLOR.g, TEXTURE_PENDING_COLOR.b, TEXTURE_PENDING_COLOR.a);
+		return;
+	}
+
+	if (NULL != m_pUniformCache)
+	{
+		const TextureArrays::TEXTURE_LAYER& layer = m_textureIDs[textureSlot].layer;
+		m_pUniformCache->Set(m_uniforms.bUseTexture, true);
+		m_pUniformCache->Set(m_uniforms.objectTexture, layer.arrayIndex);
+		m_pUniformCache->Set(m_uniforms.objectTextureLayer, layer.layer);
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->Set(m_uniforms.UVscale, glm::vec2(u, v));
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for selecting the material in the
+ *  shader material buffer that the next draw command uses.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	std::string_view materialTag)
+{
+	SetShaderMaterial(FindMaterialID(materialTag));
+}
+
+void SceneManager::SetShaderMaterial(
+	int materialID)
+{
+	if ((materialID < 0) || (materialID >= (int)m_objectMaterials.size()) || (NULL == m_pUniformCache))
+	{
+		return;
+	}
+
+	m_pUniformCache->Set(m_uniforms.materialIndex, materialID);
+}
+
+/***********************************************************
+ *  UploadMaterials()
+ *
+ *  This method is used for writing every defined material
+ *  into the shader material buffer, indexed by material ID.
+ *  The buffer is reallocated when materials were added, and
+ *  otherwise only the changed materials are uploaded.
+ ***********************************************************/
+void SceneManager::UploadMaterials()
+{
+	size_t size = std::max(m_objectMaterials.size(), (size_t)1) * sizeof(MATERIAL_DATA);
+	if (m_materialBuffer.GetSize() != size)
+	{
+		m_materialBuffer.Create(MATERIAL_BUFFER_BINDING, size, GL_SHADER_STORAGE_BUFFER);
+	}
+
+	for (size_t i = 0; i < m_objectMaterials.size(); i++)
+	{
+		const OBJECT_MATERIAL& material = m_objectMaterials[i];
+
+		MATERIAL_DATA data;
+		data.ambientColor = material.ambientColor;
+		data.ambientStrength = material.ambientStrength;
+		data.diffuseColor = material.diffuseColor;
+		data.shininess = material.shininess;
+		data.specularColor = material.specularColor;
+		data.padding = 0.0f;
+		m_materialBuffer.Write(i * sizeof(MATERIAL_DATA), data);
+	}
+	m_materialBuffer.Flush();
+
+	m_bMaterialsChanged = false;
+}
+
+/***********************************************************
+ *  AddDrawItem()
+ *
+ *  This method is used for adding a mesh to the retained
+ *  render queue with the passed in transform, texture and
+ *  material.  The returned index identifies the draw item.
+ ***********************************************************/
+int SceneManager::AddDrawItem(
+	MESH_TYPE mesh,
+	const glm::mat4& transform,
+	std::string_view textureTag,
+	std::string_view materialTag,
+	glm::vec2 uvScale)
+{
+	RenderQueue::DRAW_ITEM item;
+
+	item.mesh = mesh;
+	item.shaderID = 0;
+	item.materialID = FindMaterialID(materialTag);
+	item.textureSlot = FindTextureSlot(textureTag);
+	item.color = glm::vec4(1.0f);
+	item.uvScale = uvScale;
+	item.transform = transform;
+	item.bTransparent = false;
+	item.detailLevel = 0;
+	item.bStatic = false;
+	if (item.materialID >= 0)
+	{
+		item.bTransparent = m_objectMaterials[item.materialID].bTransparent;
+	}
+	m_bSceneChanged = true;
+
+	return(m_renderQueue.AddItem(item));
+}
+
+/***********************************************************
+ *  AddDrawItem()
+ *
+ *  This method is used for adding a mesh to the retained
+ *  render queue, positioned by a scene graph node.  The
+ *  model matrix of the draw item follows the world matrix
+ *  of the node.
+ ***********************************************************/
+int SceneManager::AddDrawItem(
+	MESH_TYPE mesh,
+	int node,
+	std::string_view textureTag,
+	std::string_view materialTag,
+	glm::vec2 uvScale)
+{
+	int itemIndex = AddDrawItem(mesh, glm::mat4(1.0f), textureTag, materialTag, uvScale);
+	m_sceneGraph.SetItem(node, itemIndex);
+
+	return(itemIndex);
+}
+
+/***********************************************************
+ *  AddDrawItem()
+ *
+ *  This method is used for adding a mesh to the retained
+ *  render queue on a root scene graph node, with its
+ *  transformation values kept in the transform batch.
+ ***********************************************************/
+int SceneManager::AddDrawItem(
+	MESH_TYPE mesh,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ,
+	std::string_view textureTag,
+	std::string_view materialTag,
+	glm::vec2 uvScale)
+{
+	int node = AddSceneNode(
+		-1,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	return(AddDrawItem(mesh, node, textureTag, materialTag, uvScale));
+}
+
+/***********************************************************
+ *  AddSceneNode()
+ *
+ *  This method is used for adding a scene graph node under
+ *  a parent node, or as a root node when the parent is -1.
+ *  The transformation values are relative to the parent and
+ *  are kept in the transform batch, so the node can be moved
+ *  with new values later.
+ ***********************************************************/
+int SceneManager::AddSceneNode(
+	int parentNode,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	int node = AddSceneNode(parentNode, glm::mat4(1.0f));
+	if (node < 0)
+	{
+		return(-1);
+	}
+
+	AddNodeTransform(node, scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+
+	return(node);
+}
+
+int SceneManager::AddSceneNode(int parentNode, const glm::mat4& localTransform)
+{
+	int node = m_sceneGraph.AddNode(parentNode, localTransform);
+	if (node >= 0)
+	{
+		m_nodeTransformIndices.resize(m_sceneGraph.GetNodeCount(), -1);
+		m_bSceneChanged = true;
+	}
+
+	return(node);
+}
+
+/***********************************************************
+ *  ReserveSceneObjects()
+ *
+ *  This method is used for making room for a number of
+ *  scene graph nodes and draw items before they are added.
+ ***********************************************************/
+void SceneManager::ReserveSceneObjects(int nodeCount, int itemCount)
+{
+	int totalNodes = m_sceneGraph.GetNodeCount() + nodeCount;
+	int totalItems = m_renderQueue.GetItemCount() + itemCount;
+
+	m_sceneGraph.Reserve(totalNodes);
+	m_nodeTransforms.Reserve(m_nodeTransforms.GetCount() + nodeCount);
+	m_transformNodes.reserve(m_transformNodes.size() + nodeCount);
+	m_nodeTransformIndices.reserve(totalNodes);
+	m_changedNodes.reserve(totalNodes);
+	m_changedBounds.reserve(totalNodes);
+	m_renderQueue.Reserve(totalItems);
+	m_visibleItems.reserve(totalItems);
+}
+
+/***********************************************************
+ *  UpdateSceneGraph()
+ *
+ *  This method is used for computing the batched transforms
+ *  in one pass when any of them changed, then the world
+ *  matrices of the moved subtrees of the scene graph, and
+ *  for moving the draw items of the nodes that changed.
+ ***********************************************************/
+void SceneManager::UpdateSceneGraph()
+{
+	if (m_nodeTransforms.IsDirty() == true)
+	{
+		m_nodeTransforms.Compute(&m_jobSystem);
+
+		const std::vector<int>& changes = m_nodeTransforms.GetComputedChanges();
+		for (size_t i = 0; i < changes.size(); i++)
+		{
+			const glm::mat4& transform = m_nodeTransforms.GetMatrix(changes[i]);
+			m_sceneGraph.SetLocalTransform(m_transformNodes[changes[i]], transform);
+		}
+	}
+
+	if (m_sceneGraph.IsDirty() == false)
+	{
+		return;
+	}
+
+	m_sceneGraph.Update(m_changedNodes);
+
+	// every changed node moves its own draw item, so the items and
+	// their bounds are updated on the job threads, then the boxes
+	// are handed to the hierarchy on this thread
+	m_changedBounds.resize(m_changedNodes.size());
+	m_jobSystem.ParallelFor((int)m_changedNodes.size(), ITEM_UPDATES_PER_JOB,
+		[this](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				int itemIndex = m_sceneGraph.GetItem(m_changedNodes[i]);
+				if (itemIndex >= 0)
+				{
+					RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(itemIndex);
+					item.transform = m_sceneGraph.GetWorldTransform(m_changedNodes[i]);
+					m_changedBounds[i] = GetItemBounds(item);
+				}
+			}
+		});
+
+	for (size_t i = 0; i < m_changedNodes.size(); i++)
+	{
+		int itemIndex = m_sceneGraph.GetItem(m_changedNodes[i]);
+		if (itemIndex >= 0)
 		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
+			m_sceneBounds.SetItemBox(itemIndex, m_changedBounds[i]);
+			if (m_renderQueue.GetItem(itemIndex).bStatic == true)
+			{
+				m_bStaticBatchesChanged = true;
+			}
 		}
+	}
+}
+
+/***********************************************************
+ *  ComputeMeshBounds()
+ *
+ *  This method is used for computing the local space bounds
+ *  of every basic shape mesh from its generated vertices.
+ ***********************************************************/
+void SceneManager::ComputeMeshBounds()
+{
+	for (int i = 0; i < MESH_COUNT; i++)
+	{
+		ShapeGeometry::MESH_DATA data;
+		ShapeGeometry::Generate((MESH_TYPE)i, ShapeGeometry::DEFAULT_SEGMENTS, data);
+
+		m_meshBounds[i].min = data.boundsMin;
+		m_meshBounds[i].max = data.boundsMax;
+	}
+}
 
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
+/***********************************************************
+ *  GetItemBounds()
+ *
+ *  This method is used for getting the world space bounds
+ *  of a draw item from its mesh bounds and transform.
+ ***********************************************************/
+BOUNDING_BOX SceneManager::GetItemBounds(const RenderQueue::DRAW_ITEM& item)
+{
+	return(BoundingVolumeHierarchy::TransformBox(m_meshBounds[item.mesh], item.transform));
+}
 
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+/***********************************************************
+ *  BuildSceneBounds()
+ *
+ *  This method is used for building the bounding volume
+ *  hierarchy over all the draw items in the render queue.
+ ***********************************************************/
+void SceneManager::BuildSceneBounds()
+{
+	std::vector<BOUNDING_BOX> itemBounds(m_renderQueue.GetItemCount());
+	m_jobSystem.ParallelFor(m_renderQueue.GetItemCount(), ITEM_UPDATES_PER_JOB,
+		[this, &itemBounds](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				itemBounds[i] = GetItemBounds(m_renderQueue.GetItem(i));
+			}
+		});
+
+	m_sceneBounds.Build(itemBounds);
+}
+
+/***********************************************************
+ *  ClearScene()
+ *
+ *  This method is used for removing every draw item and
+ *  scene graph node, so another scene can be built with the
+ *  loaded textures, materials and lights.
+ ***********************************************************/
+void SceneManager::ClearScene()
+{
+	m_renderQueue.Clear();
+	m_sceneGraph.Clear();
+	m_nodeTransforms.Clear();
+	m_transformNodes.clear();
+	m_nodeTransformIndices.clear();
+	m_changedNodes.clear();
+	m_visibleItems.clear();
+	BuildSceneBounds();
+	m_staticBatches.Clear();
+	m_bStaticBatchesChanged = false;
+	m_bSceneChanged = true;
+}
 
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
+/***********************************************************
+ *  SetItemTransform()
+ *
+ *  This method is used for moving a draw item.  Its bounding
+ *  volume is refit before the next frame is culled, without
+ *  rebuilding the hierarchy.  Draw items positioned by a
+ *  scene graph node are moved by the node.
+ ***********************************************************/
+void SceneManager::SetItemTransform(int itemIndex, const glm::mat4& transform)
+{
+	if ((itemIndex < 0) || (itemIndex >= m_renderQueue.GetItemCount()))
+	{
+		return;
+	}
 
-		return true;
+	RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(itemIndex);
+	item.transform = transform;
+	m_sceneBounds.SetItemBox(itemIndex, GetItemBounds(item));
+	if (item.bStatic == true)
+	{
+		m_bStaticBatchesChanged = true;
 	}
+	m_bSceneChanged = true;
+}
 
-	std::cout << "Could not load image:" << filename << std::endl;
+/***********************************************************
+ *  SetItemStatic()
+ *
+ *  This method is used for flagging a draw item as never
+ *  moving.  The static batches are baked again before the
+ *  next frame, which also happens whenever a static item is
+ *  moved anyway, so static items should really stay put.
+ ***********************************************************/
+void SceneManager::SetItemStatic(int itemIndex, bool bStatic)
+{
+	if ((itemIndex < 0) || (itemIndex >= m_renderQueue.GetItemCount()))
+	{
+		return;
+	}
 
-	// Error loading the image
-	return false;
+	RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(itemIndex);
+	if (item.bStatic != bStatic)
+	{
+		item.bStatic = bStatic;
+		m_bStaticBatchesChanged = true;
+		m_bSceneChanged = true;
+	}
 }
 
 /***********************************************************
- *  BindGLTextures()
+ *  BakeStaticGeometry()
  *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
+ *  This method is used for merging the meshes of all the
+ *  static draw items into the static batches, replacing
+ *  any batches baked before.
  ***********************************************************/
-void SceneManager::BindGLTextures()
+void SceneManager::BakeStaticGeometry()
 {
-	for (int i = 0; i < m_loadedTextures; i++)
+	m_staticBatches.Clear();
+	for (int i = 0; i < m_renderQueue.GetItemCount(); i++)
 	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+		const RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(i);
+		if (IsItemBaked(item) == true)
+		{
+			m_staticBatches.AddItem(item);
+		}
 	}
+	m_staticBatches.Upload();
+	m_bStaticBatchesChanged = false;
 }
 
 /***********************************************************
- *  DestroyGLTextures()
+ *  IsItemBaked()
  *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
+ *  This method is used for checking whether a draw item is
+ *  drawn by the static batches instead of on its own.
  ***********************************************************/
-void SceneManager::DestroyGLTextures()
+bool SceneManager::IsItemBaked(const RenderQueue::DRAW_ITEM& item) const
+{
+	return((item.bStatic == true) && (StaticBatches::CanBake(item) == true));
+}
+
+/***********************************************************
+ *  DrawStaticBatches()
+ *
+ *  This method is used for drawing every static batch that
+ *  is at least partly inside the view frustum and not
+ *  hidden behind the occluders, each with
+ *  one draw call.  The merged vertices are already in world
+ *  space, so the model matrix is the identity.
+ ***********************************************************/
+void SceneManager::DrawStaticBatches()
+{
+	if (m_staticBatches.GetBatchCount() == 0)
+	{
+		return;
+	}
+
+	SetModelMatrix(glm::mat4(1.0f));
+	for (int i = 0; i < m_staticBatches.GetBatchCount(); i++)
+	{
+		const StaticBatches::BATCH& batch = m_staticBatches.GetBatch(i);
+		if (m_viewFrustum.TestBox(batch.bounds) == FRUSTUM_OUTSIDE)
+		{
+			continue;
+		}
+		if ((m_bOccludersDrawn == true) && (m_occlusionBuffer.IsBoxVisible(batch.bounds) == false))
+		{
+			m_renderStats.occludedItems += (unsigned int)batch.itemCount;
+			continue;
+		}
+
+		if (batch.textureSlot >= 0)
+		{
+			SetShaderTexture(batch.textureSlot);
+		}
+		else
+		{
+			SetShaderColor(batch.color.r, batch.color.g, batch.color.b, batch.color.a);
+		}
+		SetTextureUVScale(batch.uvScale.x, batch.uvScale.y);
+		SetShaderMaterial(batch.materialID);
+		m_staticBatches.DrawBatch(i);
+
+		m_renderStats.drawCalls++;
+		m_renderStats.staticBatchDraws++;
+		m_renderStats.staticBatchItems += (unsigned int)batch.itemCount;
+		m_renderStats.drawnItems += (unsigned int)batch.itemCount;
+	}
+}
+
+/***********************************************************
+ *  SetNodeTransform()
+ *
+ *  This method is used for moving a scene graph node
+ *  relative to its parent, either to transformation values
+ *  computed by the transform batch or to a model matrix.
+ *  The draw items of the node and of its subtree follow it
+ *  before the next frame.
+ ***********************************************************/
+void SceneManager::SetNodeTransform(
+	int node,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	if ((node < 0) || (node >= m_sceneGraph.GetNodeCount()))
+	{
+		return;
+	}
+	m_bSceneChanged = true;
+
+	// nodes added with a matrix join the batch when first moved this way
+	if (m_nodeTransformIndices[node] < 0)
+	{
+		AddNodeTransform(node, scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+		return;
+	}
+
+	m_nodeTransforms.Set(
+		m_nodeTransformIndices[node],
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+}
+
+void SceneManager::SetNodeTransform(int node, const glm::mat4& localTransform)
+{
+	if ((node < 0) || (node >= m_sceneGraph.GetNodeCount()))
+	{
+		return;
+	}
+	m_bSceneChanged = true;
+
+	// the matrix replaces any batched values of the node, and
+	// frees its transform for the next node joining the batch
+	if (m_nodeTransformIndices[node] >= 0)
+	{
+		m_nodeTransforms.Remove(m_nodeTransformIndices[node]);
+		m_transformNodes[m_nodeTransformIndices[node]] = -1;
+		m_nodeTransformIndices[node] = -1;
+	}
+
+	m_sceneGraph.SetLocalTransform(node, localTransform);
+}
+
+/***********************************************************
+ *  AddNodeTransform()
+ *
+ *  This method is used for adding the transformation values
+ *  of a node to the transform batch, which can reuse the
+ *  transform of a node that was given a matrix instead.
+ ***********************************************************/
+void SceneManager::AddNodeTransform(
+	int node,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
 {
-	for (int i = 0; i < m_loadedTextures; i++)
+	int transformIndex = m_nodeTransforms.Add(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	if (transformIndex >= (int)m_transformNodes.size())
 	{
-		glGenTextures(1, &m_textureIDs[i].ID);
+		m_transformNodes.resize(transformIndex + 1, -1);
 	}
+	m_transformNodes[transformIndex] = node;
+	m_nodeTransformIndices[node] = transformIndex;
 }
 
 /***********************************************************
- *  FindTextureID()
+ *  DrawMesh()
  *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method is used for drawing the basic shape mesh
+ *  referenced by a draw item.
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+void SceneManager::DrawMesh(MESH_TYPE mesh)
 {
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
+	m_renderStats.drawCalls++;
+	GLRecorder::RecordDrawMesh(mesh);
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	switch (mesh)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
+	case MESH_PLANE:
+		m_basicMeshes->DrawPlaneMesh();
+		break;
+	case MESH_BOX:
+		m_basicMeshes->DrawBoxMesh();
+		break;
+	case MESH_CYLINDER:
+		m_basicMeshes->DrawCylinderMesh();
+		break;
+	case MESH_TAPERED_CYLINDER:
+		m_basicMeshes->DrawTaperedCylinderMesh();
+		break;
+	case MESH_CONE:
+		m_basicMeshes->DrawConeMesh();
+		break;
+	case MESH_SPHERE:
+		m_basicMeshes->DrawSphereMesh();
+		break;
+	case MESH_TORUS:
+		m_basicMeshes->DrawTorusMesh();
+		break;
+	case MESH_PRISM:
+		m_basicMeshes->DrawPrismMesh();
+		break;
+	case MESH_PYRAMID4:
+		m_basicMeshes->DrawPyramid4Mesh();
+		break;
+	default:
+		break;
 	}
 
-	return(textureID);
+	// the mesh was drawn with its own vertex array
+	GLStateCache::InvalidateVertexState();
 }
 
 /***********************************************************
- *  FindTextureSlot()
+ *  CanInstance()
  *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method is used for checking whether a draw item can
+ *  be drawn with the instanced meshes at all - it must be
+ *  opaque and have a material to select from the material
+ *  buffer.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+bool SceneManager::CanInstance(const RenderQueue::DRAW_ITEM& item)
 {
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
+	return((item.bTransparent == false) && (item.materialID >= 0));
 }
 
 /***********************************************************
- *  FindMaterial()
+ *  CanInstanceTogether()
  *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
+ *  This method is used for checking whether the next draw
+ *  item can be added to the instanced draw of the first
+ *  one - it must be instanceable itself, and share the mesh
+ *  and its level of detail, the texture and UV scale.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+bool SceneManager::CanInstanceTogether(
+	const RenderQueue::DRAW_ITEM& first,
+	const RenderQueue::DRAW_ITEM& next)
 {
-	if (m_objectMaterials.size() == 0)
+	if ((CanInstance(next) == false) ||
+		(next.mesh != first.mesh) ||
+		(next.detailLevel != first.detailLevel) ||
+		(next.textureSlot != first.textureSlot) ||
+		(next.uvScale != first.uvScale))
 	{
 		return(false);
 	}
 
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
+	// untextured items also need the same color
+	if ((next.textureSlot < 0) && (next.color != first.color))
 	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.ambientColor = m_objectMaterials[index].ambientColor;
-			material.ambientStrength = m_objectMaterials[index].ambientStrength;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
+		return(false);
 	}
 
 	return(true);
 }
 
 /***********************************************************
- *  SetTransformations()
+ *  SelectDetailLevels()
  *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
+ *  This method is used for picking the level of detail of
+ *  every visible draw item drawn with the instanced meshes,
+ *  from the diameter of its bounding sphere projected with
+ *  the current camera.  An item only moves to another level
+ *  once its size is past the level size by the hysteresis
+ *  fraction, and keeps its level while it is not visible.
  ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
+void SceneManager::SelectDetailLevels()
 {
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
+	if ((m_bInstancingSupported == false) || (m_instancedMeshes->IsLoaded() == false))
+	{
+		return;
+	}
 
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
+	// the clip space w of a point is its distance along the view
+	// direction with a perspective projection, and 1 with an
+	// orthographic one
+	glm::mat4 viewProjection = m_projectionMatrix * m_viewMatrix;
+	float projectionScale = std::abs(m_projectionMatrix[1][1]);
 
-	modelView = translation * rotationX * rotationY * rotationZ * scale;
+	m_jobSystem.ParallelFor((int)m_visibleItems.size(), ITEM_UPDATES_PER_JOB,
+		[this, &viewProjection, projectionScale](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(m_visibleItems[i]);
+				int levelCount = m_instancedMeshes->GetDetailLevelCount(item.mesh);
+				if ((levelCount <= 1) || (CanInstance(item) == false))
+				{
+					item.detailLevel = 0;
+					continue;
+				}
+
+				float size = GetProjectedSize(item, viewProjection, projectionScale);
+
+				int level = std::min(item.detailLevel, levelCount - 1);
+				while ((level + 1 < levelCount) &&
+					(size < DETAIL_LEVEL_SIZES[level] * (1.0f - DETAIL_LEVEL_HYSTERESIS)))
+				{
+					level++;
+				}
+				while ((level > 0) &&
+					(size > DETAIL_LEVEL_SIZES[level - 1] * (1.0f + DETAIL_LEVEL_HYSTERESIS)))
+				{
+					level--;
+				}
+				item.detailLevel = level;
+			}
+		});
+}
 
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
+/***********************************************************
+ *  GetProjectedSize()
+ *
+ *  This method is used for getting the diameter of the
+ *  bounding sphere of a draw item projected with the
+ *  passed in camera matrices, as a fraction of the full
+ *  view height.  The radius scaled by the projection and
+ *  divided by the distance is the radius in normalized
+ *  device units, and the view height is two of those.
+ ***********************************************************/
+float SceneManager::GetProjectedSize(const RenderQueue::DRAW_ITEM& item, const glm::mat4& viewProjection, float projectionScale) const
+{
+	const BOUNDING_BOX& bounds = m_meshBounds[item.mesh];
+	glm::vec4 center = item.transform * glm::vec4((bounds.min + bounds.max) * 0.5f, 1.0f);
+	float scale = std::max(glm::length(glm::vec3(item.transform[0])),
+		std::max(glm::length(glm::vec3(item.transform[1])), glm::length(glm::vec3(item.transform[2]))));
+	float radius = glm::length(bounds.max - bounds.min) * 0.5f * scale;
+	float distance = std::max((viewProjection * center).w, DETAIL_MIN_DISTANCE);
+
+	return(radius * projectionScale / distance);
 }
 
 /***********************************************************
- *  SetShaderColor()
+ *  CullOccludedItems()
  *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
+ *  This method is used for rasterizing the opaque boxes and
+ *  planes that look largest from the camera, the only
+ *  shapes filling their bounds, into the occlusion buffer,
+ *  and removing the visible items whose bounds are hidden
+ *  behind them.  The baked items are tested by their static
+ *  batch instead.
  ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
+void SceneManager::CullOccludedItems()
 {
-	// variables for this method
-	glm::vec4 currentColor;
+	glm::mat4 viewProjection = m_projectionMatrix * m_viewMatrix;
+	float projectionScale = std::abs(m_projectionMatrix[1][1]);
+	int visibleCount = (int)m_visibleItems.size();
 
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
+	m_occluderSizes.resize(visibleCount);
+	m_jobSystem.ParallelFor(visibleCount, ITEM_UPDATES_PER_JOB,
+		[this, &viewProjection, projectionScale](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				const RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(m_visibleItems[i]);
+				bool bCandidate = (item.bTransparent == false) &&
+					((item.mesh == MESH_BOX) || (item.mesh == MESH_PLANE));
+				m_occluderSizes[i] = (bCandidate == true) ? GetProjectedSize(item, viewProjection, projectionScale) : 0.0f;
+			}
+		});
+
+	// the largest occluders on the screen usually hide the most
+	m_occluders.clear();
+	for (int i = 0; i < visibleCount; i++)
+	{
+		if (m_occluderSizes[i] >= OCCLUDER_MIN_SIZE)
+		{
+			m_occluders.push_back(i);
+		}
+	}
+	if (m_occluders.size() == 0)
+	{
+		return;
+	}
+	if (m_occluders.size() > MAX_OCCLUDERS)
+	{
+		std::partial_sort(m_occluders.begin(), m_occluders.begin() + MAX_OCCLUDERS, m_occluders.end(),
+			[this](int a, int b)
+			{
+				return(m_occluderSizes[a] > m_occluderSizes[b]);
+			});
+		m_occluders.resize(MAX_OCCLUDERS);
+	}
+
+	m_occlusionBuffer.Begin(viewProjection);
+	for (size_t i = 0; i < m_occluders.size(); i++)
+	{
+		const RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(m_visibleItems[m_occluders[i]]);
+		m_occlusionBuffer.DrawBox(m_meshBounds[item.mesh], item.transform);
+	}
+	m_occlusionBuffer.Finish();
+	m_bOccludersDrawn = true;
+	m_renderStats.occluders += (unsigned int)m_occluders.size();
 
-	if (NULL != m_pShaderManager)
+	m_occludedItems.assign(visibleCount, 0);
+	m_jobSystem.ParallelFor(visibleCount, ITEM_UPDATES_PER_JOB,
+		[this](int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				int itemIndex = m_visibleItems[i];
+				if (IsItemBaked(m_renderQueue.GetItem(itemIndex)) == false)
+				{
+					m_occludedItems[i] = (m_occlusionBuffer.IsBoxVisible(m_sceneBounds.GetItemBox(itemIndex)) == false) ? 1 : 0;
+				}
+			}
+		});
+
+	int keptCount = 0;
+	for (int i = 0; i < visibleCount; i++)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+		if (m_occludedItems[i] == 0)
+		{
+			m_visibleItems[keptCount++] = m_visibleItems[i];
+		}
 	}
+	m_renderStats.occludedItems += (unsigned int)(visibleCount - keptCount);
+	m_visibleItems.resize(keptCount);
 }
 
 /***********************************************************
- *  SetShaderTexture()
+ *  DrawMeshInstanced()
  *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
+ *  This method is used for drawing several copies of a
+ *  basic shape mesh.  When the shader supports instancing
+ *  all the copies are drawn with one call, otherwise each
+ *  copy is drawn with its own transform and material.
  ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
+void SceneManager::DrawMeshInstanced(
+	MESH_TYPE mesh,
+	int detailLevel,
+	const glm::mat4* transforms,
+	const int* materialIDs,
+	int count)
 {
-	if (NULL != m_pShaderManager)
+	if ((m_bInstancingSupported == true) && (NULL != m_pUniformCache))
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+		m_pUniformCache->Set(m_uniforms.bUseInstancing, true);
+		m_instancedMeshes->DrawInstanced(mesh, detailLevel, transforms, materialIDs, count);
+		m_renderStats.drawCalls++;
+		m_renderStats.instancedDraws++;
+		m_pUniformCache->Set(m_uniforms.bUseInstancing, false);
+		return;
+	}
 
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
+	for (int i = 0; i < count; i++)
+	{
+		SetModelMatrix(transforms[i]);
+		SetShaderMaterial(materialIDs[i]);
+		DrawMesh(mesh);
 	}
 }
 
 /***********************************************************
- *  SetTextureUVScale()
+ *  IsMultiDrawActive()
  *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
+ *  This method is used for checking whether the instanced
+ *  draws are queued and submitted together instead of being
+ *  drawn one by one.
  ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
+bool SceneManager::IsMultiDrawActive() const
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
+	return((m_bMultiDrawEnabled == true) &&
+		(m_bInstancingSupported == true) &&
+		(NULL != m_pUniformCache) &&
+		(m_instancedMeshes->IsMultiDrawSupported() == true));
 }
 
 /***********************************************************
- *  SetShaderMaterial()
+ *  SubmitQueuedDraws()
  *
- *  This method is used for passing the material values
- *  into the shader.
+ *  This method is used for drawing the queued instanced
+ *  draws with a single multi-draw call, before any uniform
+ *  they share is changed.
  ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
+void SceneManager::SubmitQueuedDraws()
 {
-	if (m_objectMaterials.size() > 0)
+	if (m_instancedMeshes->GetQueuedDrawCount() == 0)
 	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
+		return;
+	}
 
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.ambientColor", material.ambientColor);
-			m_pShaderManager->setFloatValue("material.ambientStrength", material.ambientStrength);
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
+	m_pUniformCache->Set(m_uniforms.bUseInstancing, true);
+	int drawCount = m_instancedMeshes->SubmitQueuedDraws();
+	m_pUniformCache->Set(m_uniforms.bUseInstancing, false);
+
+	if (m_instancedMeshes->IsMultiDrawSupported() == true)
+	{
+		m_renderStats.drawCalls++;
+		m_renderStats.multiDraws++;
+	}
+	else
+	{
+		m_renderStats.drawCalls += (unsigned int)drawCount;
 	}
+	m_renderStats.instancedDraws += (unsigned int)drawCount;
+}
+
+/***********************************************************
+ *  SetCameraView()
+ *
+ *  This method is used for passing the view parameters of
+ *  the current frame to the scene, for ordering the draw
+ *  items by their distance from the camera.
+ ***********************************************************/
+void SceneManager::SetCameraView(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	const glm::vec3& viewPosition)
+{
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+	m_viewPosition = viewPosition;
 }
 
 /**************************************************************/
@@ -384,24 +1522,25 @@ void SceneManager::SetShaderMaterial(
   ***********************************************************/
 
 void SceneManager::LoadSceneTextures() {
-	// load the texture images and convert to OpenGL texture data
-	bool bReturn = false;
+	// start decoding the texture images in the background
+	m_textureLoader->Start();
 
 	// load the textures for the 3D scene
-	bReturn = CreateGLTexture("Textures/cloud.jpg", "cloud");
-	bReturn = CreateGLTexture("Textures/fire.jpg", "fire");
-	bReturn = CreateGLTexture("Textures/metal.jpg", "metal");
-	bReturn = CreateGLTexture("Textures/mud.jpg", "mud");
-	bReturn = CreateGLTexture("Textures/seashells.jpg", "seashells");
-	bReturn = CreateGLTexture("Textures/soil.jpg", "soil");
-	bReturn = CreateGLTexture("Textures/stainedglass.jpg", "stainedglass");
-	bReturn = CreateGLTexture("Textures/stone.jpg", "stone");
-	bReturn = CreateGLTexture("Textures/treebark.jpg", "treebark");
-	bReturn = CreateGLTexture("Textures/wood.jpg", "wood");
-
-	// after the texture image data is loaded into memory, the
-	// loaded textures need to be bound to texture slots - there
-	// are a total of 16 available slots for scene textures
+	LoadGLTextureAsync("Textures/cloud.jpg", "cloud");
+	LoadGLTextureAsync("Textures/fire.jpg", "fire");
+	LoadGLTextureAsync("Textures/metal.jpg", "metal");
+	LoadGLTextureAsync("Textures/mud.jpg", "mud");
+	LoadGLTextureAsync("Textures/seashells.jpg", "seashells");
+	LoadGLTextureAsync("Textures/soil.jpg", "soil");
+	LoadGLTextureAsync("Textures/stainedglass.jpg", "stainedglass");
+	LoadGLTextureAsync("Textures/stone.jpg", "stone");
+	LoadGLTextureAsync("Textures/treebark.jpg", "treebark");
+	LoadGLTextureAsync("Textures/wood.jpg", "wood");
+
+	// the texture arrays are allocated for the reserved layers and
+	// bound to texture units - there is one unit for every texture
+	// size, holding any number of textures as layers.  Until an
+	// image is loaded, objects using it are drawn in plain grey
 	BindGLTextures();
 }
 
@@ -414,14 +1553,27 @@ void SceneManager::LoadSceneTextures() {
  ***********************************************************/
 void SceneManager::PrepareScene()
 {
-	// load the texture images and convert to OpenGL texture data
-	LoadSceneTextures();
+	// compute the bounds of the meshes for view frustum culling
+	ComputeMeshBounds();
+
+	// the scene lights are kept in the shader light block
+	m_lightBuffer.Create(LIGHT_BLOCK_BINDING, sizeof(LIGHT_BLOCK));
 
-	// Define the object materials for the 3D scene
-	DefineObjectMaterials();
+	// load the scene description, or define the scene in code
+	// when there is no scene file
+	bool bSceneLoaded = LoadSceneFile(SCENE_FILENAME);
+	if (bSceneLoaded == false)
+	{
+		// load the texture images and convert to OpenGL texture data
+		LoadSceneTextures();
+
+		// Define the object materials for the 3D scene
+		DefineObjectMaterials();
 
-	// Set up scene lights
-	SetupSceneLights();
+		// Set up scene lights in the shader light block
+		SetupSceneLights();
+	}
+	UploadMaterials();
 
 	// only one instance of a particular mesh needs to be
 	// loaded in memory no matter how many times it is drawn
@@ -436,6 +1588,125 @@ void SceneManager::PrepareScene()
 	m_basicMeshes->LoadPrismMesh(); // Load the prism mesh
 	m_basicMeshes->LoadPyramid4Mesh(); // Load the pyramid mesh
 	m_basicMeshes->LoadSphereMesh(); // Load the sphere mesh
+	// the meshes bound their own vertex arrays and buffers
+	GLStateCache::InvalidateVertexState();
+
+	// load the instanced copies of the meshes when the shader
+	// reads the per-instance model matrix
+	GLint currentProgram = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+	m_bInstancingSupported = (glGetAttribLocation(currentProgram, "instanceModel") ==
+		(GLint)InstancedMeshes::INSTANCE_MODEL_LOCATION);
+	if (m_bInstancingSupported == true)
+	{
+		m_instancedMeshes->LoadMeshes();
+	}
+
+	// fill the retained render queue with the scene objects
+	if (bSceneLoaded == false)
+	{
+		BuildScene();
+	}
+	UpdateSceneGraph();
+	BuildSceneBounds();
+
+	// merge the draw items that never move into the static batches
+	BakeStaticGeometry();
+}
+
+/***********************************************************
+ *  LoadSceneFile()
+ *
+ *  This method is used for loading the textures, materials,
+ *  lights and objects described by a scene file.  The file
+ *  is checked completely before anything is loaded, and the
+ *  objects are streamed from its records into storage that
+ *  is reserved up front, so large scenes load without
+ *  per-object allocations.
+ ***********************************************************/
+bool SceneManager::LoadSceneFile(const std::string& filename)
+{
+	SceneFile sceneFile;
+	if (sceneFile.Open(filename) == false)
+	{
+		return(false);
+	}
+
+	// start decoding the texture images in the background
+	m_textureLoader->Start();
+	for (int i = 0; i < sceneFile.GetTextureCount(); i++)
+	{
+		const SceneFile::SCENE_TEXTURE& texture = sceneFile.GetTexture(i);
+		LoadGLTextureAsync(sceneFile.GetString(texture.path), sceneFile.GetString(texture.tag));
+	}
+	BindGLTextures();
+
+	for (int i = 0; i < sceneFile.GetMaterialCount(); i++)
+	{
+		const SceneFile::SCENE_MATERIAL& record = sceneFile.GetMaterial(i);
+
+		OBJECT_MATERIAL material;
+		material.ambientColor = record.ambientColor;
+		material.ambientStrength = record.ambientStrength;
+		material.diffuseColor = record.diffuseColor;
+		material.specularColor = record.specularColor;
+		material.shininess = record.shininess;
+		material.tag = sceneFile.GetString(record.tag);
+		material.bTransparent = ((record.flags & SceneFile::MATERIAL_TRANSPARENT) != 0);
+		AddObjectMaterial(material);
+	}
+
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->Set(m_uniforms.bUseLighting, true);
+	}
+	if (sceneFile.GetLightCount() > MAX_LIGHTS)
+	{
+		std::cout << "Scene file " << filename << " has more than " << MAX_LIGHTS << " lights" << std::endl;
+	}
+	for (int i = 0; (i < sceneFile.GetLightCount()) && (i < MAX_LIGHTS); i++)
+	{
+		const SceneFile::SCENE_LIGHT& light = sceneFile.GetLight(i);
+		SetShaderLight(i,
+			light.position,
+			light.ambientColor,
+			light.diffuseColor,
+			light.specularColor,
+			light.focalStrength,
+			light.specularIntensity);
+	}
+
+	// node records refer to their parents by file index, and the
+	// nodes are added in file order after any existing ones
+	int firstNode = m_sceneGraph.GetNodeCount();
+	ReserveSceneObjects(sceneFile.GetNodeCount(), sceneFile.GetObjectCount());
+	for (int i = 0; i < sceneFile.GetNodeCount(); i++)
+	{
+		const SceneFile::SCENE_NODE& record = sceneFile.GetNode(i);
+
+		int node = AddSceneNode(
+			(record.parent == SceneFile::NO_PARENT) ? -1 : firstNode + record.parent,
+			record.scale,
+			record.rotation.x,
+			record.rotation.y,
+			record.rotation.z,
+			record.position);
+		if (record.mesh != SceneFile::NO_MESH)
+		{
+			int itemIndex = AddDrawItem(
+				(MESH_TYPE)record.mesh,
+				node,
+				sceneFile.GetString(record.texture),
+				sceneFile.GetString(record.material),
+				record.uvScale);
+			if ((record.flags & SceneFile::NODE_STATIC) != 0)
+			{
+				SetItemStatic(itemIndex, true);
+			}
+		}
+	}
+
+	return(true);
 }
 
 void SceneManager::DefineObjectMaterials() {
@@ -446,7 +1717,7 @@ void SceneManager::DefineObjectMaterials() {
 	goldMaterial.specularColor = glm::vec3(0.6f, 0.5f, 0.4f);
 	goldMaterial.shininess = 22.0;
 	goldMaterial.tag = "gold";
-	m_objectMaterials.push_back(goldMaterial);
+	AddObjectMaterial(goldMaterial);
 	OBJECT_MATERIAL cementMaterial;
 	cementMaterial.ambientColor = glm::vec3(0.2f, 0.2f, 0.2f);
 	cementMaterial.ambientStrength = 0.2f;
@@ -454,7 +1725,7 @@ void SceneManager::DefineObjectMaterials() {
 	cementMaterial.specularColor = glm::vec3(0.4f, 0.4f, 0.4f);
 	cementMaterial.shininess = 0.5;
 	cementMaterial.tag = "cement";
-	m_objectMaterials.push_back(cementMaterial);
+	AddObjectMaterial(cementMaterial);
 	OBJECT_MATERIAL woodMaterial;
 	woodMaterial.ambientColor = glm::vec3(0.4f, 0.3f, 0.1f);
 	woodMaterial.ambientStrength = 0.2f;
@@ -462,7 +1733,7 @@ void SceneManager::DefineObjectMaterials() {
 	woodMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
 	woodMaterial.shininess = 0.3;
 	woodMaterial.tag = "wood";
-	m_objectMaterials.push_back(woodMaterial);
+	AddObjectMaterial(woodMaterial);
 	OBJECT_MATERIAL tileMaterial;
 	tileMaterial.ambientColor = glm::vec3(0.2f, 0.3f, 0.4f);
 	tileMaterial.ambientStrength = 0.3f;
@@ -470,7 +1741,7 @@ void SceneManager::DefineObjectMaterials() {
 	tileMaterial.specularColor = glm::vec3(0.4f, 0.5f, 0.6f);
 	tileMaterial.shininess = 25.0;
 	tileMaterial.tag = "tile";
-	m_objectMaterials.push_back(tileMaterial);
+	AddObjectMaterial(tileMaterial);
 	OBJECT_MATERIAL glassMaterial;
 	glassMaterial.ambientColor = glm::vec3(0.4f, 0.4f, 0.4f);
 	glassMaterial.ambientStrength = 0.3f;
@@ -478,7 +1749,8 @@ void SceneManager::DefineObjectMaterials() {
 	glassMaterial.specularColor = glm::vec3(0.6f, 0.6f, 0.6f);
 	glassMaterial.shininess = 85.0;
 	glassMaterial.tag = "glass";
-	m_objectMaterials.push_back(glassMaterial);
+	glassMaterial.bTransparent = true;
+	AddObjectMaterial(glassMaterial);
 	OBJECT_MATERIAL clayMaterial;
 	clayMaterial.ambientColor = glm::vec3(0.2f, 0.2f, 0.3f);
 	clayMaterial.ambientStrength = 0.3f;
@@ -486,53 +1758,251 @@ void SceneManager::DefineObjectMaterials() {
 	clayMaterial.specularColor = glm::vec3(0.2f, 0.2f, 0.4f);
 	clayMaterial.shininess = 0.5;
 	clayMaterial.tag = "clay";
-	m_objectMaterials.push_back(clayMaterial);
+	AddObjectMaterial(clayMaterial);
 }
 
 void SceneManager::SetupSceneLights() {
 	// Enable lighting in shaders
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->Set(m_uniforms.bUseLighting, true);
+	}
 
 	// Light 1 - White Key Light (Main Light Source)
-	m_pShaderManager->setVec3Value("lightSources[0].position", 3.0f, 14.0f, 0.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].ambientColor", 0.02f, 0.05f, 0.05f); // Slightly cool ambient
-	m_pShaderManager->setVec3Value("lightSources[0].diffuseColor", 1.0f, 0.3f, 0.2f); 
-	m_pShaderManager->setVec3Value("lightSources[0].specularColor", 1.0f, 0.4f, 0.3f);
-	m_pShaderManager->setFloatValue("lightSources[0].focalStrength", 32.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].specularIntensity", 0.5f);
+	SetShaderLight(0,
+		glm::vec3(3.0f, 14.0f, 0.0f),
+		glm::vec3(0.02f, 0.05f, 0.05f), // Slightly cool ambient
+		glm::vec3(1.0f, 0.3f, 0.2f),
+		glm::vec3(1.0f, 0.4f, 0.3f),
+		32.0f,
+		0.5f);
 
 	// Light 2 - White Fill Light (Softens Shadows)
-	m_pShaderManager->setVec3Value("lightSources[1].position", -3.0f, 10.0f, 3.0f);
-	m_pShaderManager->setVec3Value("lightSources[1].ambientColor", 0.02f, 0.02f, 0.02f);
-	m_pShaderManager->setVec3Value("lightSources[1].diffuseColor", 0.6f, 0.6f, 0.6f);
-	m_pShaderManager->setVec3Value("lightSources[1].specularColor", 0.3f, 0.3f, 0.3f);
-	m_pShaderManager->setFloatValue("lightSources[1].focalStrength", 25.0f);
-	m_pShaderManager->setFloatValue("lightSources[1].specularIntensity", 0.3f);
+	SetShaderLight(1,
+		glm::vec3(-3.0f, 10.0f, 3.0f),
+		glm::vec3(0.02f, 0.02f, 0.02f),
+		glm::vec3(0.6f, 0.6f, 0.6f),
+		glm::vec3(0.3f, 0.3f, 0.3f),
+		25.0f,
+		0.3f);
 
 	// Light 3 - Warm Colored Light (Adds Warmth and Color)
-	m_pShaderManager->setVec3Value("lightSources[2].position", 0.6f, 5.0f, 6.0f);
-	m_pShaderManager->setVec3Value("lightSources[2].ambientColor", 0.03f, 0.02f, 0.01f); // Slightly warm ambient
-	m_pShaderManager->setVec3Value("lightSources[2].diffuseColor", 0.9f, 0.6f, 0.2f);  // Orange-yellow tone
-	m_pShaderManager->setVec3Value("lightSources[2].specularColor", 0.4f, 0.3f, 0.2f);
-	m_pShaderManager->setFloatValue("lightSources[2].focalStrength", 18.0f);
-	m_pShaderManager->setFloatValue("lightSources[2].specularIntensity", 0.6f);
+	SetShaderLight(2,
+		glm::vec3(0.6f, 5.0f, 6.0f),
+		glm::vec3(0.03f, 0.02f, 0.01f), // Slightly warm ambient
+		glm::vec3(0.9f, 0.6f, 0.2f),  // Orange-yellow tone
+		glm::vec3(0.4f, 0.3f, 0.2f),
+		18.0f,
+		0.6f);
 
 	// Light 4 - Cool Blue Back Light (Adds Depth)
-	m_pShaderManager->setVec3Value("lightSources[3].position", -4.0f, 8.0f, -5.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].ambientColor", 0.01f, 0.01f, 0.03f);
-	m_pShaderManager->setVec3Value("lightSources[3].diffuseColor", 0.2f, 0.4f, 1.0f); // Cool blue light
-	m_pShaderManager->setVec3Value("lightSources[3].specularColor", 0.3f, 0.4f, 0.8f);
-	m_pShaderManager->setFloatValue("lightSources[3].focalStrength", 20.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].specularIntensity", 0.7f);
+	SetShaderLight(3,
+		glm::vec3(-4.0f, 8.0f, -5.0f),
+		glm::vec3(0.01f, 0.01f, 0.03f),
+		glm::vec3(0.2f, 0.4f, 1.0f), // Cool blue light
+		glm::vec3(0.3f, 0.4f, 0.8f),
+		20.0f,
+		0.7f);
 }
 
 /***********************************************************
  *  RenderScene()
  *
  *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
+ *  submitting the retained draw items in sorted order
  ***********************************************************/
 void SceneManager::RenderScene()
+{
+	// changes made from here on are drawn by the next frame
+	m_bSceneChanged = false;
+
+	{
+		ProfileScope scope(m_pProfiler, m_profileScopes.textureUploads);
+
+		// put any textures loaded in the background into their slots
+		UpdateTextureLoads();
+
+		// upload the light sources and materials changed since the last frame
+		m_lightBuffer.Flush();
+		if (m_bMaterialsChanged == true)
+		{
+			UploadMaterials();
+		}
+	}
+
+	{
+		ProfileScope scope(m_pProfiler, m_profileScopes.sceneGraph);
+
+		// compute the model matrices of the moved draw items
+		UpdateSceneGraph();
+
+		// merge the static draw items again when any of them changed
+		if (m_bStaticBatchesChanged == true)
+		{
+			BakeStaticGeometry();
+		}
+	}
+
+	{
+		ProfileScope scope(m_pProfiler, m_profileScopes.culling, false);
+
+		// draw items added since the hierarchy was built need a rebuild,
+		// moved items only need their bounding volumes refit
+		if (m_sceneBounds.GetItemCount() != m_renderQueue.GetItemCount())
+		{
+			BuildSceneBounds();
+		}
+		m_sceneBounds.Refit();
+
+		// only the draw items inside the view frustum are drawn
+		m_viewFrustum.Extract(m_projectionMatrix * m_viewMatrix);
+		m_visibleItems.clear();
+		m_sceneBounds.Query(m_viewFrustum, m_visibleItems, &m_jobSystem);
+
+		// the draw items hidden behind large boxes and planes are
+		// not drawn
+		m_bOccludersDrawn = false;
+		if (m_bOcclusionCulling == true)
+		{
+			ProfileScope occlusionScope(m_pProfiler, m_profileScopes.occlusion, false);
+			CullOccludedItems();
+		}
+
+		// the baked draw items are drawn by the static batches
+		if (m_staticBatches.GetItemCount() > 0)
+		{
+			m_visibleItems.erase(std::remove_if(m_visibleItems.begin(), m_visibleItems.end(),
+				[this](int itemIndex)
+				{
+					return(IsItemBaked(m_renderQueue.GetItem(itemIndex)));
+				}), m_visibleItems.end());
+		}
+
+		// small round meshes are drawn with fewer triangles
+		SelectDetailLevels();
+	}
+
+	{
+		ProfileScope scope(m_pProfiler, m_profileScopes.sorting, false);
+
+		// order the visible draw items by render state and depth
+		m_renderQueue.Sort(m_viewPosition, SCENE_FAR_PLANE, m_visibleItems, &m_jobSystem);
+	}
+
+	ProfileScope drawScope(m_pProfiler, m_profileScopes.drawing);
+
+	const std::vector<int>& sortedItems = m_renderQueue.GetSortedItems();
+	m_renderStats.frames++;
+	m_renderStats.drawnItems += (unsigned int)sortedItems.size();
+
+	// the static batches are opaque, so they are drawn before the
+	// sorted draw items
+	DrawStaticBatches();
+
+	// render state of the previous draw, for counting changes
+	const RenderQueue::DRAW_ITEM* pPreviousItem = NULL;
+	bool bMultiDraw = IsMultiDrawActive();
+
+	size_t index = 0;
+	while (index < sortedItems.size())
+	{
+		const RenderQueue::DRAW_ITEM& item = m_renderQueue.GetItem(sortedItems[index]);
+		ProfileScope meshScope(m_pProfiler, m_profileScopes.drawMesh[item.mesh]);
+
+		// opaque items sorted next to each other with the same mesh
+		// and texture are drawn together with one instanced call
+		bool bInstanced = (m_bInstancingSupported == true) && (CanInstance(item) == true);
+		size_t runEnd = index + 1;
+		if (bInstanced == true)
+		{
+			while ((runEnd < sortedItems.size()) &&
+				(CanInstanceTogether(item, m_renderQueue.GetItem(sortedItems[runEnd])) == true))
+			{
+				runEnd++;
+			}
+		}
+
+		// texture or color, and UV scale changes
+		bool bTextureChanged = (NULL == pPreviousItem) ||
+			(pPreviousItem->textureSlot != item.textureSlot) ||
+			((item.textureSlot < 0) && (pPreviousItem->color != item.color));
+		bool bUVScaleChanged = (NULL == pPreviousItem) || (pPreviousItem->uvScale != item.uvScale);
+		if (bTextureChanged == true)
+		{
+			m_renderStats.stateChanges++;
+		}
+		if (bUVScaleChanged == true)
+		{
+			m_renderStats.stateChanges++;
+		}
+		pPreviousItem = &item;
+
+		// the queued draws are drawn with the uniforms of the items
+		// queued so far
+		if ((bMultiDraw == true) &&
+			((bTextureChanged == true) || (bUVScaleChanged == true) || (bInstanced == false)))
+		{
+			SubmitQueuedDraws();
+		}
+
+		if (item.textureSlot >= 0)
+		{
+			SetShaderTexture(item.textureSlot);
+		}
+		else
+		{
+			SetShaderColor(item.color.r, item.color.g, item.color.b, item.color.a);
+		}
+		SetTextureUVScale(item.uvScale.x, item.uvScale.y);
+
+		if (bInstanced == true)
+		{
+			m_instanceTransforms.clear();
+			m_instanceMaterials.clear();
+			for (size_t i = index; i < runEnd; i++)
+			{
+				const RenderQueue::DRAW_ITEM& instance = m_renderQueue.GetItem(sortedItems[i]);
+				m_instanceTransforms.push_back(instance.transform);
+				m_instanceMaterials.push_back(instance.materialID);
+			}
+
+			if (bMultiDraw == true)
+			{
+				m_instancedMeshes->QueueDraw(item.mesh, item.detailLevel, m_instanceTransforms.data(), m_instanceMaterials.data(), (int)m_instanceTransforms.size());
+			}
+			else
+			{
+				DrawMeshInstanced(item.mesh, item.detailLevel, m_instanceTransforms.data(), m_instanceMaterials.data(), (int)m_instanceTransforms.size());
+			}
+			if (item.detailLevel > 0)
+			{
+				m_renderStats.reducedDetailItems += (unsigned int)m_instanceTransforms.size();
+			}
+		}
+		else
+		{
+			SetModelMatrix(item.transform);
+			SetShaderMaterial(item.materialID);
+			DrawMesh(item.mesh);
+		}
+
+		index = runEnd;
+	}
+
+	if (bMultiDraw == true)
+	{
+		SubmitQueuedDraws();
+	}
+}
+
+/***********************************************************
+ *  BuildScene()
+ *
+ *  This method is used for building the 3D scene by 
+ *  adding the transformed basic 3D shapes to the render
+ *  queue
+ ***********************************************************/
+void SceneManager::BuildScene()
 {
 	// declare the variables for the transformations
 	glm::vec3 scaleXYZ;
@@ -541,15 +2011,9 @@ void SceneManager::RenderScene()
 	float ZrotationDegrees = 0.0f;
 	glm::vec3 positionXYZ;
 
-	glm::mat4 scale;
-	glm::mat4 rotation;
-	glm::mat4 rotation2;
-	glm::mat4 translation;
-	glm::mat4 model;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** Set needed transformations before adding the basic mesh.   ***/
 	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
+	/*** and adding all the basic 3D shapes.						***/
 	/******************************************************************/
 	// set the XYZ scale for the mesh
 	scaleXYZ = glm::vec3(20.0f, 1.0f, 10.0f);
@@ -562,46 +2026,35 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// add the mesh with transformation values, the wood texture and
+	// material, and the texture repeated 5 times in the U and V
+	// directions to create a tiled floor
+	AddDrawItem(MESH_PLANE,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.3, 0.2, 1.0); // Updated floor color to brown to resemble a table
-	SetShaderTexture("wood"); // Set the texture for the floor
-	SetShaderMaterial("wood"); // Set the material for the floor
-
-	SetTextureUVScale(5.0f, 5.0f); // repeat the texture 5 times in the U and V directions to create a tiled floor
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
+		positionXYZ,
+		"wood", "wood", SCENE_UV_SCALE);
 	/****************************************************************/
 	
 	// Create a coffee cup using tapered cylinder (Parent Object)
-	glm::mat4 cupTransform = glm::mat4(1.0f); // cup transformation matrix
-	cupTransform = glm::translate(cupTransform, glm::vec3(6.0f, 1.12f, 7.0f)); // cup base position to be on the table	
-	cupTransform = glm::rotate(cupTransform, glm::radians(160.0f), glm::vec3(1.0f, 0.0f, 0.0f)); // cup rotation to make it stand upright
-	cupTransform = glm::scale(cupTransform, glm::vec3(0.4f, 1.1f, 0.4f)); // cup scale to make it taller
+	int cupNode = AddSceneNode(-1,
+		glm::vec3(0.4f, 1.1f, 0.4f), // cup scale to make it taller
+		160.0f, 0.0f, 0.0f, // cup rotation to make it stand upright
+		glm::vec3(6.0f, 1.12f, 7.0f)); // cup base position to be on the table
 
-	m_pShaderManager->setMat4Value("model", cupTransform); // set the cup transformation matrix
-	//SetShaderColor(1.0, 0.0, 0.0, 1.0); // cup color to red
-	SetShaderTexture("stainedglass"); // Set the texture for the cup
-	SetShaderMaterial("glass"); // Set the material for the cup
-	m_basicMeshes->DrawTaperedCylinderMesh(); // Draw the tapered cylinder mesh
+	AddDrawItem(MESH_TAPERED_CYLINDER, cupNode, "stainedglass", "glass", SCENE_UV_SCALE); // stained glass cup
 
 	// Create a torus for the handle of the cup (Child Object)
-	glm::mat4 handleTransform = cupTransform; // handle transformation matrix
+	glm::mat4 handleTransform = glm::mat4(1.0f); // handle transformation relative to the cup
 	handleTransform = glm::translate(handleTransform, glm::vec3(1.0f, 0.5f, 0.0f)); // handle position to be on the cup
 	handleTransform = glm::rotate(handleTransform, glm::radians(90.0f), glm::vec3(0.0f, 10.0f, 90.0f)); // handle rotation to make it stand upright
 	handleTransform = glm::scale(handleTransform, glm::vec3(0.2f, 0.2f, 0.1f)); // handle scale to make it smaller
 
-	m_pShaderManager->setMat4Value("model", handleTransform); // set the handle transformation matrix
-	//SetShaderColor(0.0, 0.0, 1.0, 1.0); // handle color to blue
-	SetShaderTexture("stainedglass"); // Set the texture for the handle
-	m_basicMeshes->DrawTorusMesh(); // Draw the torus mesh
+	// the handle follows the cup when the cup node moves
+	int handleNode = AddSceneNode(cupNode, handleTransform);
+	AddDrawItem(MESH_TORUS, handleNode, "stainedglass", "glass", SCENE_UV_SCALE); // handle shares the cup material
 
 	// Add Computer Monitor
 	AddComputerMonitor(glm::vec3(0.5f,1.5f, 2.0f));
@@ -611,49 +2064,58 @@ void SceneManager::RenderScene()
 
 	// Add Stack of Books
 	AddStackOfBooks(glm::vec3(-9.0f, 1.3f, 7.2f));
+
+	// nothing in this scene moves
+	for (int i = 0; i < m_renderQueue.GetItemCount(); i++)
+	{
+		SetItemStatic(i, true);
+	}
 }
 
 void SceneManager::AddComputerMonitor(glm::vec3 position) {
-	// Monitor body (Box)
-	SetTransformations(glm::vec3(8.0f, 3.0f, 0.1f), 0.0f, 0.0f, 0.0f, position);
-	SetShaderTexture("cloud"); // Cloud texture for monitor frame
-	SetShaderMaterial("glass");
-	m_basicMeshes->DrawBoxMesh();
-}
-
-void SceneManager::AddPencil(glm::vec3 position) {
-	// Pencil body (Cylinder)
-	SetTransformations(glm::vec3(0.05f, 1.5f, 0.05f), 0.0f, 0.0f, 90.0f, position);
-	SetShaderTexture("wood"); // Wooden texture for pencil body
-	SetShaderMaterial("wood");
-	m_basicMeshes->DrawCylinderMesh();
-
-	// Metal band near eraser (Small Cylinder)
-	SetTransformations(glm::vec3(0.05f, 0.05f, 0.05f), 0.0f, 0.0f, 90.0f, position + glm::vec3(0.05f, 0.0f, 0.0f));
-	SetShaderTexture("metal"); // Metal texture for band
-	SetShaderMaterial("gold");
-	m_basicMeshes->DrawCylinderMesh();
-
-	// Eraser (Small Cylinder)
-	SetTransformations(glm::vec3(0.05f, 0.2f, 0.05f), 0.0f, 0.0f, 90.0f, position + glm::vec3(0.25f, 0.0f, 0.0f));
-	SetShaderTexture("fire"); // Red texture for eraser
-	SetShaderMaterial("clay");
-	m_basicMeshes->DrawCylinderMesh();
-}
-
-void SceneManager::AddStackOfBooks(glm::vec3 position) {
-		SetTransformations(glm::vec3(1.5f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f, position + glm::vec3(0.1f, -1.1f, 0.0f));
-		SetShaderTexture("fire"); 
-		SetShaderMaterial("clay");
-		m_basicMeshes->DrawBoxMesh();
+	// Monitor body (Box) with cloud texture for monitor frame
+	AddDrawItem(MESH_BOX,
+		glm::vec3(8.0f, 3.0f, 0.1f), 0.0f, 0.0f, 0.0f, position,
+		"cloud", "glass", SCENE_UV_SCALE);
+}
 
-		SetTransformations(glm::vec3(1.5f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f, position + glm::vec3(0.0f, -0.8f, 0.0f));
-		SetShaderTexture("metal");
-		SetShaderMaterial("clay");
-		m_basicMeshes->DrawBoxMesh();
+int SceneManager::AddPencil(glm::vec3 position) {
+	// the pencil parts are placed relative to one root node
+	int pencilNode = AddSceneNode(-1, glm::vec3(1.0f), 0.0f, 0.0f, 0.0f, position);
 
-		SetTransformations(glm::vec3(1.5f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f, position + glm::vec3(0.0f, -0.5f, 0.1f));
-		SetShaderTexture("seashells");
-		SetShaderMaterial("clay");
-		m_basicMeshes->DrawBoxMesh();
+	// Pencil body (Cylinder) with wooden texture
+	AddDrawItem(MESH_CYLINDER,
+		AddSceneNode(pencilNode, glm::vec3(0.05f, 1.5f, 0.05f), 0.0f, 0.0f, 90.0f, glm::vec3(0.0f)),
+		"wood", "wood", SCENE_UV_SCALE);
+
+	// Metal band near eraser (Small Cylinder) with metal texture
+	AddDrawItem(MESH_CYLINDER,
+		AddSceneNode(pencilNode, glm::vec3(0.05f, 0.05f, 0.05f), 0.0f, 0.0f, 90.0f, glm::vec3(0.05f, 0.0f, 0.0f)),
+		"metal", "gold", SCENE_UV_SCALE);
+
+	// Eraser (Small Cylinder) with red texture
+	AddDrawItem(MESH_CYLINDER,
+		AddSceneNode(pencilNode, glm::vec3(0.05f, 0.2f, 0.05f), 0.0f, 0.0f, 90.0f, glm::vec3(0.25f, 0.0f, 0.0f)),
+		"fire", "clay", SCENE_UV_SCALE);
+
+	return(pencilNode);
 }
+
+int SceneManager::AddStackOfBooks(glm::vec3 position) {
+		// the books are placed relative to one root node
+		int stackNode = AddSceneNode(-1, glm::vec3(1.0f), 0.0f, 0.0f, 0.0f, position);
+
+		AddDrawItem(MESH_BOX,
+			AddSceneNode(stackNode, glm::vec3(1.5f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.1f, -1.1f, 0.0f)),
+			"fire", "clay", SCENE_UV_SCALE);
+
+		AddDrawItem(MESH_BOX,
+			AddSceneNode(stackNode, glm::vec3(1.5f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, -0.8f, 0.0f)),
+			"metal", "clay", SCENE_UV_SCALE);
+
+		AddDrawItem(MESH_BOX,
+			AddSceneNode(stackNode, glm::vec3(1.5f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, -0.5f, 0.1f)),
+			"seashells", "clay", SCENE_UV_SCALE);
+
+		return(stackNode);
+}
\ No newline at end of file
@@ -11,8 +11,24 @@
 
 #include "ShaderManager.h"
 #include "ShapeMeshes.h"
+#include "UniformCache.h"
+#include "TagRegistry.h"
+#include "RenderQueue.h"
+#include "InstancedMeshes.h"
+#include "TextureLoader.h"
+#include "TextureArrays.h"
+#include "UniformBuffer.h"
+#include "BoundingVolumes.h"
+#include "TransformBatch.h"
+#include "SceneGraph.h"
+#include "JobSystem.h"
+#include "StaticBatches.h"
+#include "OcclusionBuffer.h"
+#include "SceneFile.h"
+#include "FrameProfiler.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 /***********************************************************
@@ -25,14 +41,16 @@ class SceneManager
 {
 public:
 	// constructor
-	SceneManager(ShaderManager *pShaderManager);
+	SceneManager(ShaderManager *pShaderManager, UniformCache* pUniformCache);
 	// destructor
 	~SceneManager();
 
 	struct TEXTURE_INFO
 	{
 		std::string tag;
-		uint32_t ID;
+		TextureArrays::TEXTURE_LAYER layer;
+		// set once an image has been uploaded into the layer
+		bool bLoaded = false;
 	};
 
 	struct OBJECT_MATERIAL
@@ -43,31 +61,226 @@ public:
 		glm::vec3 specularColor;
 		float shininess;
 		std::string tag;
+		bool bTransparent = false;
+	};
+
+	// number of light sources the shader light block holds
+	static const int MAX_LIGHTS = 16;
+	// binding point of the shader light block
+	static const GLuint LIGHT_BLOCK_BINDING = 0;
+
+	// std140 layout of one light source in the shader light block -
+	// each float fills the padding after the vec3 before it
+	struct LIGHT_DATA
+	{
+		glm::vec3 position;
+		float focalStrength;
+		glm::vec3 ambientColor;
+		float specularIntensity;
+		glm::vec3 diffuseColor;
+		float padding0;
+		glm::vec3 specularColor;
+		float padding1;
+	};
+
+	// std140 layout of the shader light block
+	struct LIGHT_BLOCK
+	{
+		GLint numLights;
+		GLint padding[3];
+		LIGHT_DATA lightSources[MAX_LIGHTS];
+	};
+
+	// binding point of the shader material buffer
+	static const GLuint MATERIAL_BUFFER_BINDING = 2;
+
+	// std430 layout of one material in the shader material buffer
+	struct MATERIAL_DATA
+	{
+		glm::vec3 ambientColor;
+		float ambientStrength;
+		glm::vec3 diffuseColor;
+		float shininess;
+		glm::vec3 specularColor;
+		float padding;
+	};
+
+	struct SHADER_UNIFORMS
+	{
+		UniformHandle<glm::mat4> model;
+		UniformHandle<glm::vec4> objectColor;
+		UniformHandle<int> objectTexture;
+		UniformHandle<int> objectTextureLayer;
+		UniformHandle<bool> bUseTexture;
+		UniformHandle<bool> bUseLighting;
+		UniformHandle<glm::vec2> UVscale;
+		UniformHandle<bool> bUseInstancing;
+		UniformHandle<int> materialIndex;
+	};
+
+	// rendering counters, summed over the frames since the
+	// last reset
+	struct RENDER_STATS
+	{
+		unsigned int frames;
+		unsigned int drawnItems;
+		unsigned int drawCalls;
+		unsigned int instancedDraws;
+		// calls submitting several instanced draws at once
+		unsigned int multiDraws;
+		unsigned int stateChanges;
+		// drawn items using a less detailed level of their mesh
+		unsigned int reducedDetailItems;
+		// draw calls of merged static items, and the items merged
+		unsigned int staticBatchDraws;
+		unsigned int staticBatchItems;
+		// boxes and planes rasterized as occluders, and the items
+		// hidden behind them
+		unsigned int occluders;
+		unsigned int occludedItems;
+	};
+
+	// IDs of the profiler scopes timed by the scene
+	struct PROFILE_SCOPES
+	{
+		int textureUploads;
+		int sceneGraph;
+		int culling;
+		int occlusion;
+		int sorting;
+		int drawing;
+		int drawMesh[MESH_COUNT];
 	};
 
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
+	// pointer to the shared uniform location cache
+	UniformCache* m_pUniformCache;
+	// handles of the uniforms used by the scene
+	SHADER_UNIFORMS m_uniforms;
+	// profiler timing the phases of the scene, or NULL
+	FrameProfiler* m_pProfiler;
+	PROFILE_SCOPES m_profileScopes;
+	// rendering counters
+	RENDER_STATS m_renderStats;
+	// light sources of the scene, mirrored in the shader light block
+	UniformBuffer m_lightBuffer;
+	// number of light sources set into the light block
+	int m_lightCount;
+	// defined materials, mirrored in the shader material buffer
+	UniformBuffer m_materialBuffer;
+	// true when materials were defined since the last upload
+	bool m_bMaterialsChanged;
+	// true when objects, materials or lights changed since the
+	// last rendered frame
+	bool m_bSceneChanged;
 	// pointer to basic shapes object
 	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
-	// defined object materials
+	// pointer to instanced basic shapes object
+	InstancedMeshes* m_instancedMeshes;
+	// true when the shader reads the per-instance data
+	bool m_bInstancingSupported;
+	// true to queue the instanced draws sharing the same uniforms
+	// and submit them with one multi-draw call, where supported
+	bool m_bMultiDrawEnabled;
+	// staging memory for instanced draw calls
+	std::vector<glm::mat4> m_instanceTransforms;
+	std::vector<int> m_instanceMaterials;
+	// pointer to the background texture loader object
+	TextureLoader* m_textureLoader;
+	// texture arrays holding the loaded textures
+	TextureArrays m_textureArrays;
+	// loaded textures info, indexed by texture slot
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// defined object materials, indexed by material ID
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// interned texture tags
+	TagRegistry m_textureTags;
+	// interned material tags
+	TagRegistry m_materialTags;
+	// retained draw items of the scene
+	RenderQueue m_renderQueue;
+	// local space bounds of the basic shape meshes
+	BOUNDING_BOX m_meshBounds[MESH_COUNT];
+	// world space bounds of the draw items
+	BoundingVolumeHierarchy m_sceneBounds;
+	// view frustum of the current frame
+	Frustum m_viewFrustum;
+	// draw items inside the view frustum
+	std::vector<int> m_visibleItems;
+	// hierarchy of the scene objects positioning the draw items
+	SceneGraph m_sceneGraph;
+	// scene graph nodes whose world matrices changed last update
+	std::vector<int> m_changedNodes;
+	// world space bounds of the draw items of the changed nodes
+	std::vector<BOUNDING_BOX> m_changedBounds;
+	// threads computing the transforms, bounds and sort keys
+	JobSystem m_jobSystem;
+	// static draw items merged into a few vertex buffers
+	StaticBatches m_staticBatches;
+	// true when static items were added, flagged or moved since
+	// the batches were baked
+	bool m_bStaticBatchesChanged;
+	// depth of the largest boxes and planes, rasterized on the CPU
+	OcclusionBuffer m_occlusionBuffer;
+	// true to skip the draw items hidden behind the occluders
+	bool m_bOcclusionCulling;
+	// true when occluders were rasterized for the current frame
+	bool m_bOccludersDrawn;
+	// projected size of each visible box and plane
+	std::vector<float> m_occluderSizes;
+	// visible items rasterized as occluders
+	std::vector<int> m_occluders;
+	// true for each visible item hidden behind the occluders
+	std::vector<unsigned char> m_occludedItems;
+	// scale, rotation and position of the nodes added with them
+	TransformBatch m_nodeTransforms;
+	// node of each batched transform, or -1 once removed
+	std::vector<int> m_transformNodes;
+	// batched transform of each node, or -1
+	std::vector<int> m_nodeTransformIndices;
+	// view parameters of the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	glm::vec3 m_viewPosition;
 
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
-	// bind loaded OpenGL textures to slots in memory
+	// resolve the handles of the uniforms used by the scene
+	void RegisterUniforms();
+
+	// get the slot of a texture tag, adding a new slot if needed
+	int ReserveTextureSlot(std::string_view tag);
+	// queue a texture image to be loaded in the background
+	bool LoadGLTextureAsync(const char* filename, std::string_view tag);
+	// put the textures finished in the background into their slots
+	void UpdateTextureLoads();
+	// bind the texture arrays to texture units
 	void BindGLTextures();
 	// free the loaded OpenGL textures
 	void DestroyGLTextures();
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureSlot(std::string_view tag);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	int FindMaterialID(std::string_view tag);
+	// add a material to the defined materials list
+	int AddObjectMaterial(const OBJECT_MATERIAL& material);
+
+	// compose a model matrix from the transformation values
+	glm::mat4 ComposeTransform(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// add the transformation values of a node to the batch
+	void AddNodeTransform(
+		int node,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
 
 	// set the transformation values 
 	// into the transform buffer
@@ -78,6 +291,19 @@ private:
 		float ZrotationDegrees,
 		glm::vec3 positionXYZ);
 
+	// set the model matrix into the shader
+	void SetModelMatrix(const glm::mat4& modelMatrix);
+
+	// set the light source values into the shader
+	void SetShaderLight(
+		int lightIndex,
+		glm::vec3 position,
+		glm::vec3 ambientColor,
+		glm::vec3 diffuseColor,
+		glm::vec3 specularColor,
+		float focalStrength,
+		float specularIntensity);
+
 	// set the color values into the shader
 	void SetShaderColor(
 		float redColorValue,
@@ -87,7 +313,9 @@ private:
 
 	// set the texture data into the shader
 	void SetShaderTexture(
-		std::string textureTag);
+		std::string_view textureTag);
+	void SetShaderTexture(
+		int textureSlot);
 
 	// set the UV scale for the texture mapping
 	void SetTextureUVScale(
@@ -95,22 +323,164 @@ private:
 
 	// set the object material into the shader
 	void SetShaderMaterial(
-		std::string materialTag);
+		std::string_view materialTag);
+	void SetShaderMaterial(
+		int materialID);
+	// write the defined materials into the shader material buffer
+	void UploadMaterials();
+
+	// add a mesh to the retained render queue
+	int AddDrawItem(
+		MESH_TYPE mesh,
+		const glm::mat4& transform,
+		std::string_view textureTag,
+		std::string_view materialTag,
+		glm::vec2 uvScale);
+	int AddDrawItem(
+		MESH_TYPE mesh,
+		int node,
+		std::string_view textureTag,
+		std::string_view materialTag,
+		glm::vec2 uvScale);
+	int AddDrawItem(
+		MESH_TYPE mesh,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ,
+		std::string_view textureTag,
+		std::string_view materialTag,
+		glm::vec2 uvScale);
+	// compute the moved scene graph nodes into their draw items
+	void UpdateSceneGraph();
+
+	// compute the local space bounds of the basic shape meshes
+	void ComputeMeshBounds();
+	// build the bounding volume hierarchy over the draw items
+	void BuildSceneBounds();
+	// world space bounds of a draw item
+	BOUNDING_BOX GetItemBounds(const RenderQueue::DRAW_ITEM& item);
+
+	// draw the basic shape mesh referenced by a draw item
+	void DrawMesh(MESH_TYPE mesh);
+	// true if a draw item can be drawn with the instanced meshes
+	bool CanInstance(const RenderQueue::DRAW_ITEM& item);
+	// true if two draw items can share one instanced draw
+	bool CanInstanceTogether(
+		const RenderQueue::DRAW_ITEM& first,
+		const RenderQueue::DRAW_ITEM& next);
+	// pick the level of detail of the visible draw items from
+	// their projected size
+	void SelectDetailLevels();
+	// merge the static draw items into the static batches
+	void BakeStaticGeometry();
+	// true if a draw item is drawn by the static batches
+	bool IsItemBaked(const RenderQueue::DRAW_ITEM& item) const;
+	// draw the static batches inside the view frustum
+	void DrawStaticBatches();
+	// diameter of the bounding sphere of a draw item projected
+	// with the current camera, as a fraction of the view height
+	float GetProjectedSize(const RenderQueue::DRAW_ITEM& item, const glm::mat4& viewProjection, float projectionScale) const;
+	// rasterize the largest visible boxes and planes and remove
+	// the visible items hidden behind them
+	void CullOccludedItems();
+	// true if instanced draws are queued for a multi-draw call
+	bool IsMultiDrawActive() const;
+	// submit the queued instanced draws with one call
+	void SubmitQueuedDraws();
 
 public:
 
+	// draw several copies of a basic shape mesh, each with its
+	// own transform and material, in one call per mesh type
+	// and level of detail
+	void DrawMeshInstanced(
+		MESH_TYPE mesh,
+		int detailLevel,
+		const glm::mat4* transforms,
+		const int* materialIDs,
+		int count);
+
+	// move a draw item, refitting its bounding volume
+	void SetItemTransform(int itemIndex, const glm::mat4& transform);
+	// flag a draw item as never moving, so that it is merged into
+	// the static batches before the next frame
+	void SetItemStatic(int itemIndex, bool bStatic);
+	// number of draw items in the scene
+	int GetItemCount() const { return(m_renderQueue.GetItemCount()); }
+
+	// add a scene graph node under a parent node, or as a root
+	// node when the parent is -1, and return its index
+	int AddSceneNode(
+		int parentNode,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	int AddSceneNode(int parentNode, const glm::mat4& localTransform);
+	// move a scene graph node, along with its subtree
+	void SetNodeTransform(
+		int node,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	void SetNodeTransform(int node, const glm::mat4& localTransform);
+
+	// time the phases of the scene and every draw with a profiler
+	void SetProfiler(FrameProfiler* pProfiler);
+	// change the number of threads updating, culling and sorting
+	// the scene, besides the one rendering it
+	void SetWorkerThreads(int workerCount);
+	// submit the instanced draws with multi-draw indirect calls
+	// where supported, or one call per draw
+	void SetMultiDrawEnabled(bool bEnabled) { m_bMultiDrawEnabled = bEnabled; }
+	// skip the draw items hidden behind large boxes and planes
+	void SetOcclusionCulling(bool bEnabled) { m_bOcclusionCulling = bEnabled; }
+	// threads updating, culling and sorting the scene
+	int GetThreadCount() const { return(m_jobSystem.GetThreadCount()); }
+	// rendering counters since the last reset
+	const RENDER_STATS& GetRenderStats() const { return(m_renderStats); }
+	void ResetRenderStats();
+	// true when the scene changed since the last rendered frame,
+	// or while textures are still loading, so that a loop drawing
+	// on demand knows the displayed frame is out of date
+	bool IsSceneChanged();
+
+	// remove every scene object, keeping the textures, materials
+	// and lights
+	void ClearScene();
+	// make room for the nodes and draw items of a scene
+	void ReserveSceneObjects(int nodeCount, int itemCount);
+
+	// set the view parameters of the current frame
+	void SetCameraView(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		const glm::vec3& viewPosition);
+
 	// The following methods are for the students to 
 	// customize for their own 3D scene
 	void PrepareScene();
+	// load the textures, materials, lights and objects of a
+	// scene file instead of the methods below
+	bool LoadSceneFile(const std::string& filename);
+	// wait for every queued texture to be loaded, for frames
+	// that must show the finished scene
+	void FinishTextureLoads();
 	void DefineObjectMaterials();
 	void SetupSceneLights();
+	void BuildScene();
 	void RenderScene();
 
 	void AddComputerMonitor(glm::vec3 position);
 
-	void AddPencil(glm::vec3 position);
+	int AddPencil(glm::vec3 position);
 
-	void AddStackOfBooks(glm::vec3 position);
+	int AddStackOfBooks(glm::vec3 position);
 
 	void LoadSceneTextures();
 };
\ No newline at end of file
@@ -0,0 +1,558 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapegeometry.cpp
+// ============
+// generate the vertex data of the basic 3D shapes on the CPU
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declaration of the shape dimensions
+namespace
+{
+	const float PI = 3.14159265358979f;
+	// top radius of the tapered cylinder, the bottom radius is 1
+	const float TAPERED_TOP_RADIUS = 0.5f;
+	// radius of the torus tube, the main radius is 1
+	const float TORUS_TUBE_RADIUS = 0.1f;
+	// fewest segments that still produce a closed round shape
+	const int MIN_SEGMENTS = 3;
+}
+
+/***********************************************************
+ *  Generate()
+ *
+ *  This method is used for generating the vertex data of
+ *  the passed in basic shape.
+ ***********************************************************/
+void ShapeGeometry::Generate(MESH_TYPE mesh, int segments, MESH_DATA& data)
+{
+	data.vertices.clear();
+	data.indices.clear();
+
+	segments = std::max(segments, MIN_SEGMENTS);
+
+	switch (mesh)
+	{
+	case MESH_PLANE:
+		GeneratePlane(data);
+		break;
+	case MESH_BOX:
+		GenerateBox(data);
+		break;
+	case MESH_CYLINDER:
+		GenerateCylinder(data, segments, 1.0f);
+		break;
+	case MESH_TAPERED_CYLINDER:
+		GenerateCylinder(data, segments, TAPERED_TOP_RADIUS);
+		break;
+	case MESH_CONE:
+		GenerateCone(data, segments);
+		break;
+	case MESH_SPHERE:
+		GenerateSphere(data, segments);
+		break;
+	case MESH_TORUS:
+		GenerateTorus(data, segments);
+		break;
+	case MESH_PRISM:
+		GeneratePrism(data);
+		break;
+	case MESH_PYRAMID4:
+		GeneratePyramid4(data);
+		break;
+	default:
+		break;
+	}
+
+	FixWinding(data);
+	ComputeBounds(data);
+}
+
+/***********************************************************
+ *  IsRound()
+ *
+ *  This method is used for checking whether a shape has
+ *  round parts split into segments, so that it can be
+ *  generated with fewer triangles when it is drawn small.
+ ***********************************************************/
+bool ShapeGeometry::IsRound(MESH_TYPE mesh)
+{
+	switch (mesh)
+	{
+	case MESH_CYLINDER:
+	case MESH_TAPERED_CYLINDER:
+	case MESH_CONE:
+	case MESH_SPHERE:
+	case MESH_TORUS:
+		return(true);
+	default:
+		return(false);
+	}
+}
+
+/***********************************************************
+ *  AddVertex()
+ *
+ *  This method is used for appending one vertex to the
+ *  mesh data.
+ ***********************************************************/
+uint32_t ShapeGeometry::AddVertex(
+	MESH_DATA& data,
+	glm::vec3 position,
+	glm::vec3 normal,
+	glm::vec2 uv)
+{
+	uint32_t index = (uint32_t)GetVertexCount(data);
+
+	data.vertices.push_back(position.x);
+	data.vertices.push_back(position.y);
+	data.vertices.push_back(position.z);
+	data.vertices.push_back(normal.x);
+	data.vertices.push_back(normal.y);
+	data.vertices.push_back(normal.z);
+	data.vertices.push_back(uv.x);
+	data.vertices.push_back(uv.y);
+
+	return(index);
+}
+
+/***********************************************************
+ *  AddFlatFace()
+ *
+ *  This method is used for appending a flat convex face,
+ *  triangulated as a fan around its first corner.
+ ***********************************************************/
+void ShapeGeometry::AddFlatFace(
+	MESH_DATA& data,
+	const glm::vec3* positions,
+	const glm::vec2* uvs,
+	int count,
+	glm::vec3 normal)
+{
+	uint32_t first = (uint32_t)GetVertexCount(data);
+
+	for (int i = 0; i < count; i++)
+	{
+		AddVertex(data, positions[i], normal, uvs[i]);
+	}
+
+	for (int i = 1; i < count - 1; i++)
+	{
+		data.indices.push_back(first);
+		data.indices.push_back(first + i);
+		data.indices.push_back(first + i + 1);
+	}
+}
+
+/***********************************************************
+ *  OutwardNormal()
+ *
+ *  This method is used for getting the normal of a face of
+ *  a convex shape that contains the origin, pointing away
+ *  from the origin.
+ ***********************************************************/
+glm::vec3 ShapeGeometry::OutwardNormal(const glm::vec3* positions, int count)
+{
+	glm::vec3 normal = glm::normalize(glm::cross(
+		positions[1] - positions[0],
+		positions[2] - positions[0]));
+	glm::vec3 center = glm::vec3(0.0f);
+
+	for (int i = 0; i < count; i++)
+	{
+		center += positions[i];
+	}
+
+	if (glm::dot(normal, center) < 0.0f)
+	{
+		normal = -normal;
+	}
+
+	return(normal);
+}
+
+/***********************************************************
+ *  FixWinding()
+ *
+ *  This method is used for ordering the corners of every
+ *  triangle counter-clockwise when seen from the side its
+ *  vertex normals point to, so that back-face culling and
+ *  the shader agree on the front face.
+ ***********************************************************/
+void ShapeGeometry::FixWinding(MESH_DATA& data)
+{
+	const float* v = data.vertices.data();
+
+	for (size_t i = 0; i + 2 < data.indices.size(); i += 3)
+	{
+		const float* a = v + data.indices[i] * FLOATS_PER_VERTEX;
+		const float* b = v + data.indices[i + 1] * FLOATS_PER_VERTEX;
+		const float* c = v + data.indices[i + 2] * FLOATS_PER_VERTEX;
+
+		glm::vec3 pa = glm::vec3(a[0], a[1], a[2]);
+		glm::vec3 pb = glm::vec3(b[0], b[1], b[2]);
+		glm::vec3 pc = glm::vec3(c[0], c[1], c[2]);
+		glm::vec3 normal = glm::vec3(a[3] + b[3] + c[3], a[4] + b[4] + c[4], a[5] + b[5] + c[5]);
+
+		if (glm::dot(glm::cross(pb - pa, pc - pa), normal) < 0.0f)
+		{
+			std::swap(data.indices[i + 1], data.indices[i + 2]);
+		}
+	}
+}
+
+/***********************************************************
+ *  ComputeBounds()
+ *
+ *  This method is used for calculating the local bounding
+ *  box of the generated vertices.
+ ***********************************************************/
+void ShapeGeometry::ComputeBounds(MESH_DATA& data)
+{
+	data.boundsMin = glm::vec3(0.0f);
+	data.boundsMax = glm::vec3(0.0f);
+
+	int vertexCount = GetVertexCount(data);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		const float* p = &data.vertices[i * FLOATS_PER_VERTEX];
+		glm::vec3 position = glm::vec3(p[0], p[1], p[2]);
+
+		if (i == 0)
+		{
+			data.boundsMin = position;
+			data.boundsMax = position;
+		}
+		else
+		{
+			data.boundsMin = glm::min(data.boundsMin, position);
+			data.boundsMax = glm::max(data.boundsMax, position);
+		}
+	}
+}
+
+/***********************************************************
+ *  GeneratePlane()
+ *
+ *  Flat plane on the XZ axes from -1 to 1, facing up.
+ ***********************************************************/
+void ShapeGeometry::GeneratePlane(MESH_DATA& data)
+{
+	glm::vec3 positions[4] = {
+		glm::vec3(-1.0f, 0.0f, 1.0f),
+		glm::vec3(1.0f, 0.0f, 1.0f),
+		glm::vec3(1.0f, 0.0f, -1.0f),
+		glm::vec3(-1.0f, 0.0f, -1.0f) };
+	glm::vec2 uvs[4] = {
+		glm::vec2(0.0f, 0.0f),
+		glm::vec2(1.0f, 0.0f),
+		glm::vec2(1.0f, 1.0f),
+		glm::vec2(0.0f, 1.0f) };
+
+	AddFlatFace(data, positions, uvs, 4, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+/***********************************************************
+ *  GenerateBox()
+ *
+ *  Unit cube centered on the origin, one flat face per side.
+ ***********************************************************/
+void ShapeGeometry::GenerateBox(MESH_DATA& data)
+{
+	glm::vec2 uvs[4] = {
+		glm::vec2(0.0f, 0.0f),
+		glm::vec2(1.0f, 0.0f),
+		glm::vec2(1.0f, 1.0f),
+		glm::vec2(0.0f, 1.0f) };
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		for (int side = -1; side <= 1; side += 2)
+		{
+			// the two axes spanning the face
+			int u = (axis + 1) % 3;
+			int v = (axis + 2) % 3;
+			glm::vec3 positions[4];
+			float corners[4][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+
+			for (int i = 0; i < 4; i++)
+			{
+				positions[i] = glm::vec3(0.0f);
+				positions[i][axis] = 0.5f * side;
+				positions[i][u] = corners[i][0];
+				positions[i][v] = corners[i][1];
+			}
+
+			AddFlatFace(data, positions, uvs, 4, OutwardNormal(positions, 4));
+		}
+	}
+}
+
+/***********************************************************
+ *  GenerateCylinder()
+ *
+ *  Cylinder standing on the XZ plane, from a radius of 1 at
+ *  the bottom (y = 0) to the passed in radius at the top
+ *  (y = 1).  A top radius below 1 gives the tapered cylinder.
+ ***********************************************************/
+void ShapeGeometry::GenerateCylinder(MESH_DATA& data, int segments, float topRadius)
+{
+	// the side normals lean up as the cylinder narrows
+	float slope = 1.0f - topRadius;
+
+	for (int i = 0; i <= segments; i++)
+	{
+		float angle = 2.0f * PI * (float)i / (float)segments;
+		float c = cosf(angle);
+		float s = sinf(angle);
+		glm::vec3 normal = glm::normalize(glm::vec3(c, slope, s));
+		float u = (float)i / (float)segments;
+
+		AddVertex(data, glm::vec3(c, 0.0f, s), normal, glm::vec2(u, 0.0f));
+		AddVertex(data, glm::vec3(c * topRadius, 1.0f, s * topRadius), normal, glm::vec2(u, 1.0f));
+	}
+
+	for (int i = 0; i < segments; i++)
+	{
+		uint32_t bottom = i * 2;
+		uint32_t top = bottom + 1;
+		uint32_t nextBottom = bottom + 2;
+		uint32_t nextTop = bottom + 3;
+
+		data.indices.insert(data.indices.end(), { bottom, top, nextBottom });
+		data.indices.insert(data.indices.end(), { nextBottom, top, nextTop });
+	}
+
+	// bottom and top caps
+	for (int cap = 0; cap < 2; cap++)
+	{
+		float y = (float)cap;
+		float radius = (cap == 0) ? 1.0f : topRadius;
+		glm::vec3 normal = glm::vec3(0.0f, (cap == 0) ? -1.0f : 1.0f, 0.0f);
+		uint32_t center = AddVertex(data, glm::vec3(0.0f, y, 0.0f), normal, glm::vec2(0.5f, 0.5f));
+
+		for (int i = 0; i <= segments; i++)
+		{
+			float angle = 2.0f * PI * (float)i / (float)segments;
+			float c = cosf(angle);
+			float s = sinf(angle);
+
+			AddVertex(data, glm::vec3(c * radius, y, s * radius), normal, glm::vec2(0.5f + 0.5f * c, 0.5f + 0.5f * s));
+		}
+
+		for (int i = 0; i < segments; i++)
+		{
+			data.indices.insert(data.indices.end(), { center, center + 1 + i, center + 2 + i });
+		}
+	}
+}
+
+/***********************************************************
+ *  GenerateCone()
+ *
+ *  Cone standing on the XZ plane with a base radius of 1 at
+ *  y = 0 and the tip at y = 1.
+ ***********************************************************/
+void ShapeGeometry::GenerateCone(MESH_DATA& data, int segments)
+{
+	for (int i = 0; i <= segments; i++)
+	{
+		float angle = 2.0f * PI * (float)i / (float)segments;
+		float c = cosf(angle);
+		float s = sinf(angle);
+		glm::vec3 normal = glm::normalize(glm::vec3(c, 1.0f, s));
+		float u = (float)i / (float)segments;
+
+		AddVertex(data, glm::vec3(c, 0.0f, s), normal, glm::vec2(u, 0.0f));
+		AddVertex(data, glm::vec3(0.0f, 1.0f, 0.0f), normal, glm::vec2(u, 1.0f));
+	}
+
+	for (int i = 0; i < segments; i++)
+	{
+		uint32_t bottom = i * 2;
+		data.indices.insert(data.indices.end(), { bottom, bottom + 1, bottom + 2 });
+	}
+
+	// base cap
+	glm::vec3 normal = glm::vec3(0.0f, -1.0f, 0.0f);
+	uint32_t center = AddVertex(data, glm::vec3(0.0f), normal, glm::vec2(0.5f, 0.5f));
+
+	for (int i = 0; i <= segments; i++)
+	{
+		float angle = 2.0f * PI * (float)i / (float)segments;
+		float c = cosf(angle);
+		float s = sinf(angle);
+
+		AddVertex(data, glm::vec3(c, 0.0f, s), normal, glm::vec2(0.5f + 0.5f * c, 0.5f + 0.5f * s));
+	}
+
+	for (int i = 0; i < segments; i++)
+	{
+		data.indices.insert(data.indices.end(), { center, center + 1 + i, center + 2 + i });
+	}
+}
+
+/***********************************************************
+ *  GenerateSphere()
+ *
+ *  Sphere with a radius of 1 centered on the origin, with
+ *  half as many stacks as segments around.
+ ***********************************************************/
+void ShapeGeometry::GenerateSphere(MESH_DATA& data, int segments)
+{
+	int stacks = std::max(segments / 2, 2);
+
+	for (int j = 0; j <= stacks; j++)
+	{
+		float phi = PI * (float)j / (float)stacks;
+
+		for (int i = 0; i <= segments; i++)
+		{
+			float theta = 2.0f * PI * (float)i / (float)segments;
+			glm::vec3 position = glm::vec3(
+				sinf(phi) * cosf(theta),
+				cosf(phi),
+				sinf(phi) * sinf(theta));
+
+			AddVertex(data, position, position,
+				glm::vec2((float)i / (float)segments, 1.0f - (float)j / (float)stacks));
+		}
+	}
+
+	for (int j = 0; j < stacks; j++)
+	{
+		for (int i = 0; i < segments; i++)
+		{
+			uint32_t a = j * (segments + 1) + i;
+			uint32_t b = a + segments + 1;
+
+			data.indices.insert(data.indices.end(), { a, a + 1, b });
+			data.indices.insert(data.indices.end(), { a + 1, b + 1, b });
+		}
+	}
+}
+
+/***********************************************************
+ *  GenerateTorus()
+ *
+ *  Torus around the Z axis with a main radius of 1, with
+ *  half as many segments around the tube as around the ring.
+ ***********************************************************/
+void ShapeGeometry::GenerateTorus(MESH_DATA& data, int segments)
+{
+	int tubeSegments = std::max(segments / 2, MIN_SEGMENTS);
+
+	for (int i = 0; i <= segments; i++)
+	{
+		float u = 2.0f * PI * (float)i / (float)segments;
+		glm::vec3 ringDirection = glm::vec3(cosf(u), sinf(u), 0.0f);
+
+		for (int j = 0; j <= tubeSegments; j++)
+		{
+			float v = 2.0f * PI * (float)j / (float)tubeSegments;
+			glm::vec3 normal = ringDirection * cosf(v) + glm::vec3(0.0f, 0.0f, sinf(v));
+
+			AddVertex(data, ringDirection + normal * TORUS_TUBE_RADIUS, normal,
+				glm::vec2((float)i / (float)segments, (float)j / (float)tubeSegments));
+		}
+	}
+
+	for (int i = 0; i < segments; i++)
+	{
+		for (int j = 0; j < tubeSegments; j++)
+		{
+			uint32_t a = i * (tubeSegments + 1) + j;
+			uint32_t b = a + tubeSegments + 1;
+
+			data.indices.insert(data.indices.end(), { a, b, a + 1 });
+			data.indices.insert(data.indices.end(), { a + 1, b, b + 1 });
+		}
+	}
+}
+
+/***********************************************************
+ *  GeneratePrism()
+ *
+ *  Triangular prism centered on the origin, with the
+ *  triangle faces toward the front and back.
+ ***********************************************************/
+void ShapeGeometry::GeneratePrism(MESH_DATA& data)
+{
+	glm::vec2 triangle[3] = {
+		glm::vec2(-0.5f, -0.5f),
+		glm::vec2(0.5f, -0.5f),
+		glm::vec2(0.0f, 0.5f) };
+	glm::vec2 triangleUVs[3] = {
+		glm::vec2(0.0f, 0.0f),
+		glm::vec2(1.0f, 0.0f),
+		glm::vec2(0.5f, 1.0f) };
+	glm::vec2 quadUVs[4] = {
+		glm::vec2(0.0f, 0.0f),
+		glm::vec2(1.0f, 0.0f),
+		glm::vec2(1.0f, 1.0f),
+		glm::vec2(0.0f, 1.0f) };
+
+	// front and back triangles
+	for (int side = -1; side <= 1; side += 2)
+	{
+		glm::vec3 positions[3];
+		for (int i = 0; i < 3; i++)
+		{
+			positions[i] = glm::vec3(triangle[i].x, triangle[i].y, 0.5f * side);
+		}
+		AddFlatFace(data, positions, triangleUVs, 3, OutwardNormal(positions, 3));
+	}
+
+	// three rectangular sides
+	for (int i = 0; i < 3; i++)
+	{
+		glm::vec2 a = triangle[i];
+		glm::vec2 b = triangle[(i + 1) % 3];
+		glm::vec3 positions[4] = {
+			glm::vec3(a.x, a.y, 0.5f),
+			glm::vec3(b.x, b.y, 0.5f),
+			glm::vec3(b.x, b.y, -0.5f),
+			glm::vec3(a.x, a.y, -0.5f) };
+
+		AddFlatFace(data, positions, quadUVs, 4, OutwardNormal(positions, 4));
+	}
+}
+
+/***********************************************************
+ *  GeneratePyramid4()
+ *
+ *  Square based pyramid centered on the origin, with the
+ *  base at y = -0.5 and the tip at y = 0.5.
+ ***********************************************************/
+void ShapeGeometry::GeneratePyramid4(MESH_DATA& data)
+{
+	glm::vec3 base[4] = {
+		glm::vec3(-0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, -0.5f, -0.5f),
+		glm::vec3(-0.5f, -0.5f, -0.5f) };
+	glm::vec2 baseUVs[4] = {
+		glm::vec2(0.0f, 0.0f),
+		glm::vec2(1.0f, 0.0f),
+		glm::vec2(1.0f, 1.0f),
+		glm::vec2(0.0f, 1.0f) };
+	glm::vec2 sideUVs[3] = {
+		glm::vec2(0.0f, 0.0f),
+		glm::vec2(1.0f, 0.0f),
+		glm::vec2(0.5f, 1.0f) };
+	glm::vec3 apex = glm::vec3(0.0f, 0.5f, 0.0f);
+
+	AddFlatFace(data, base, baseUVs, 4, glm::vec3(0.0f, -1.0f, 0.0f));
+
+	for (int i = 0; i < 4; i++)
+	{
+		glm::vec3 positions[3] = { base[i], base[(i + 1) % 4], apex };
+		AddFlatFace(data, positions, sideUVs, 3, OutwardNormal(positions, 3));
+	}
+}
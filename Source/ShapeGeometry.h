@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapegeometry.h
+// ============
+// generate the vertex data of the basic 3D shapes on the CPU
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RenderQueue.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/***********************************************************
+ *  ShapeGeometry
+ *
+ *  This class builds the vertices and triangle indices of
+ *  the basic 3D shapes in local memory, following the same
+ *  unit-size conventions as the ShapeMeshes class.  Every
+ *  vertex is made of a position, a normal and a texture
+ *  coordinate, matching the shader attribute layout.
+ ***********************************************************/
+class ShapeGeometry
+{
+public:
+	// number of floats in one vertex
+	static const int FLOATS_PER_VERTEX = 8;
+	// default number of segments around round shapes
+	static const int DEFAULT_SEGMENTS = 36;
+
+	struct MESH_DATA
+	{
+		std::vector<float> vertices;
+		std::vector<uint32_t> indices;
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+	};
+
+	// generate the shape with the passed in number of segments
+	// around its round parts - flat shapes ignore the segments
+	static void Generate(MESH_TYPE mesh, int segments, MESH_DATA& data);
+	// true for the shapes with round parts, whose triangle count
+	// depends on the number of segments
+	static bool IsRound(MESH_TYPE mesh);
+
+	// number of vertices in the generated data
+	static int GetVertexCount(const MESH_DATA& data)
+	{
+		return((int)data.vertices.size() / FLOATS_PER_VERTEX);
+	}
+
+private:
+	static void GeneratePlane(MESH_DATA& data);
+	static void GenerateBox(MESH_DATA& data);
+	static void GenerateCylinder(MESH_DATA& data, int segments, float topRadius);
+	static void GenerateCone(MESH_DATA& data, int segments);
+	static void GenerateSphere(MESH_DATA& data, int segments);
+	static void GenerateTorus(MESH_DATA& data, int segments);
+	static void GeneratePrism(MESH_DATA& data);
+	static void GeneratePyramid4(MESH_DATA& data);
+
+	// append a vertex and return its index
+	static uint32_t AddVertex(
+		MESH_DATA& data,
+		glm::vec3 position,
+		glm::vec3 normal,
+		glm::vec2 uv);
+	// append a flat face made of a triangle fan
+	static void AddFlatFace(
+		MESH_DATA& data,
+		const glm::vec3* positions,
+		const glm::vec2* uvs,
+		int count,
+		glm::vec3 normal);
+	// normal of a face of a convex shape centered on the origin
+	static glm::vec3 OutwardNormal(const glm::vec3* positions, int count);
+	// order every triangle counter-clockwise around its normals
+	static void FixWinding(MESH_DATA& data);
+	// recompute the bounding box of the generated vertices
+	static void ComputeBounds(MESH_DATA& data);
+};
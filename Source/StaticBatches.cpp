@@ -0,0 +1,264 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatches.cpp
+// ============
+// merge the meshes of objects that never move into a few vertex buffers
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StaticBatches.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+
+// declaration of the vertex layout
+namespace
+{
+	// vertex shader attribute locations of the shape vertices
+	const GLuint POSITION_LOCATION = 0;
+	const GLuint NORMAL_LOCATION = 1;
+	const GLuint TEXCOORD_LOCATION = 2;
+}
+
+/***********************************************************
+ *  StaticBatches()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StaticBatches::StaticBatches()
+{
+	m_firstPendingBatch = 0;
+	m_itemCount = 0;
+	m_bMeshesGenerated = false;
+}
+
+/***********************************************************
+ *  ~StaticBatches()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StaticBatches::~StaticBatches()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  CanBake()
+ *
+ *  This method is used for checking whether a draw item can
+ *  be merged into a batch - transparent items are sorted
+ *  and drawn one by one instead.
+ ***********************************************************/
+bool StaticBatches::CanBake(const RenderQueue::DRAW_ITEM& item)
+{
+	return(item.bTransparent == false);
+}
+
+/***********************************************************
+ *  AddItem()
+ *
+ *  This method is used for transforming the mesh of a draw
+ *  item to world space and appending it to the batch of its
+ *  render state.  Normals are transformed by the inverse
+ *  transpose of the model matrix, so they stay correct for
+ *  non-uniform scales.
+ ***********************************************************/
+void StaticBatches::AddItem(const RenderQueue::DRAW_ITEM& item)
+{
+	if ((CanBake(item) == false) || (item.mesh < 0) || (item.mesh >= MESH_COUNT))
+	{
+		return;
+	}
+
+	// the batches use the same tessellation as the instanced meshes
+	if (m_bMeshesGenerated == false)
+	{
+		for (int i = 0; i < MESH_COUNT; i++)
+		{
+			ShapeGeometry::Generate((MESH_TYPE)i, ShapeGeometry::DEFAULT_SEGMENTS, m_meshes[i]);
+		}
+		m_bMeshesGenerated = true;
+	}
+
+	const ShapeGeometry::MESH_DATA& mesh = m_meshes[item.mesh];
+	int vertexCount = ShapeGeometry::GetVertexCount(mesh);
+	int batchIndex = FindBatch(item, vertexCount);
+	BATCH& batch = m_batches[batchIndex];
+	BATCH_DATA& data = m_batchData[batchIndex];
+
+	glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(item.transform)));
+	uint32_t firstVertex = (uint32_t)(data.vertices.size() / ShapeGeometry::FLOATS_PER_VERTEX);
+
+	for (int i = 0; i < vertexCount; i++)
+	{
+		const float* vertex = &mesh.vertices[i * ShapeGeometry::FLOATS_PER_VERTEX];
+		glm::vec3 position = glm::vec3(item.transform * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+		glm::vec3 normal = glm::normalize(normalMatrix * glm::vec3(vertex[3], vertex[4], vertex[5]));
+
+		data.vertices.push_back(position.x);
+		data.vertices.push_back(position.y);
+		data.vertices.push_back(position.z);
+		data.vertices.push_back(normal.x);
+		data.vertices.push_back(normal.y);
+		data.vertices.push_back(normal.z);
+		data.vertices.push_back(vertex[6]);
+		data.vertices.push_back(vertex[7]);
+
+		if ((batch.itemCount == 0) && (i == 0))
+		{
+			batch.bounds.min = position;
+			batch.bounds.max = position;
+		}
+		batch.bounds.min = glm::min(batch.bounds.min, position);
+		batch.bounds.max = glm::max(batch.bounds.max, position);
+	}
+
+	// mirrored transforms turn the triangles inside out
+	bool bMirrored = (glm::determinant(glm::mat3(item.transform)) < 0.0f);
+	for (size_t i = 0; i < mesh.indices.size(); i += 3)
+	{
+		data.indices.push_back(firstVertex + mesh.indices[i]);
+		data.indices.push_back(firstVertex + mesh.indices[i + (bMirrored ? 2 : 1)]);
+		data.indices.push_back(firstVertex + mesh.indices[i + (bMirrored ? 1 : 2)]);
+	}
+
+	batch.itemCount++;
+	m_itemCount++;
+}
+
+/***********************************************************
+ *  FindBatch()
+ *
+ *  This method is used for finding the batch an item is
+ *  appended to.  Only the batches that were not uploaded
+ *  yet are searched, from the most recently started one,
+ *  and a new batch is started when none shares the render
+ *  state of the item or has room for its vertices.
+ ***********************************************************/
+int StaticBatches::FindBatch(const RenderQueue::DRAW_ITEM& item, int vertexCount)
+{
+	for (int i = (int)m_batches.size() - 1; i >= m_firstPendingBatch; i--)
+	{
+		const BATCH& batch = m_batches[i];
+		if ((batch.materialID == item.materialID) &&
+			(batch.textureSlot == item.textureSlot) &&
+			(batch.uvScale == item.uvScale) &&
+			((item.textureSlot >= 0) || (batch.color == item.color)))
+		{
+			int batchVertices = (int)(m_batchData[i].vertices.size() / ShapeGeometry::FLOATS_PER_VERTEX);
+			if (batchVertices + vertexCount <= MAX_BATCH_VERTICES)
+			{
+				return(i);
+			}
+			break;
+		}
+	}
+
+	BATCH batch;
+	batch.materialID = item.materialID;
+	batch.textureSlot = item.textureSlot;
+	batch.color = item.color;
+	batch.uvScale = item.uvScale;
+	batch.bounds.min = glm::vec3(0.0f);
+	batch.bounds.max = glm::vec3(0.0f);
+	batch.itemCount = 0;
+	batch.vao = 0;
+	batch.vbos[0] = 0;
+	batch.vbos[1] = 0;
+	batch.nIndices = 0;
+	m_batches.push_back(batch);
+	m_batchData.push_back(BATCH_DATA());
+
+	return((int)m_batches.size() - 1);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for creating the vertex arrays of the
+ *  batches started since the last upload, and for freeing
+ *  their merged vertices afterwards.
+ ***********************************************************/
+void StaticBatches::Upload()
+{
+	for (int i = m_firstPendingBatch; i < (int)m_batches.size(); i++)
+	{
+		CreateBuffers(m_batches[i], m_batchData[i]);
+		m_batchData[i] = BATCH_DATA();
+	}
+	m_firstPendingBatch = (int)m_batches.size();
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the vertex array of one
+ *  batch, with the merged vertices in the same attributes
+ *  as the basic shape meshes.
+ ***********************************************************/
+void StaticBatches::CreateBuffers(BATCH& batch, const BATCH_DATA& data)
+{
+	GLsizei stride = sizeof(float) * ShapeGeometry::FLOATS_PER_VERTEX;
+
+	glGenVertexArrays(1, &batch.vao);
+	GLStateCache::BindVertexArray(batch.vao);
+
+	glGenBuffers(2, batch.vbos);
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, batch.vbos[0]);
+	GLRecorder::BufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(float), data.vertices.data(), GL_STATIC_DRAW);
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.vbos[1]);
+	GLRecorder::BufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(uint32_t), data.indices.data(), GL_STATIC_DRAW);
+	batch.nIndices = (GLsizei)data.indices.size();
+
+	glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	glEnableVertexAttribArray(POSITION_LOCATION);
+	glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 3));
+	glEnableVertexAttribArray(NORMAL_LOCATION);
+	glVertexAttribPointer(TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 6));
+	glEnableVertexAttribArray(TEXCOORD_LOCATION);
+
+	GLStateCache::BindVertexArray(0);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for freeing the vertex arrays and the
+ *  buffers of all the batches.
+ ***********************************************************/
+void StaticBatches::Clear()
+{
+	for (size_t i = 0; i < m_batches.size(); i++)
+	{
+		if (m_batches[i].vao != 0)
+		{
+			GLStateCache::DeleteVertexArrays(1, &m_batches[i].vao);
+			GLStateCache::DeleteBuffers(2, m_batches[i].vbos);
+		}
+	}
+	m_batches.clear();
+	m_batchData.clear();
+	m_firstPendingBatch = 0;
+	m_itemCount = 0;
+}
+
+/***********************************************************
+ *  DrawBatch()
+ *
+ *  This method is used for drawing all the merged items of
+ *  a batch with one indexed draw call.
+ ***********************************************************/
+void StaticBatches::DrawBatch(int index)
+{
+	if ((index < 0) || (index >= (int)m_batches.size()) || (m_batches[index].vao == 0))
+	{
+		return;
+	}
+
+	// recorded as a single instance, the same command as the
+	// instanced draws, since the batch has no instance data
+	GLStateCache::BindVertexArray(m_batches[index].vao);
+	GLRecorder::DrawElementsInstanced(GL_TRIANGLES, m_batches[index].nIndices, GL_UNSIGNED_INT, (void*)0, 1);
+}
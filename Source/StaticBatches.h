@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatches.h
+// ============
+// merge the meshes of objects that never move into a few vertex buffers
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RenderQueue.h"
+#include "ShapeGeometry.h"
+#include "BoundingVolumes.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  StaticBatches
+ *
+ *  This class bakes the draw items of objects that never
+ *  move into merged vertex and index buffers.  The vertices
+ *  of every item are transformed to world space once, and
+ *  the items sharing a material, texture, color and UV
+ *  scale are appended to the same batch, so each batch is
+ *  drawn with one call and an identity model matrix.
+ *  Transparent items are never baked, since they must be
+ *  drawn one by one from back to front.
+ ***********************************************************/
+class StaticBatches
+{
+public:
+	// constructor
+	StaticBatches();
+	// destructor
+	~StaticBatches();
+
+	// largest number of vertices merged into one batch, so the
+	// batches stay small enough to be culled separately
+	static const int MAX_BATCH_VERTICES = 65536;
+
+	struct BATCH
+	{
+		int materialID;
+		int textureSlot;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		// world space bounds of the merged items
+		BOUNDING_BOX bounds;
+		// number of merged items
+		int itemCount;
+		GLuint vao;
+		GLuint vbos[2];
+		GLsizei nIndices;
+	};
+
+	// true if a draw item can be merged into a batch
+	static bool CanBake(const RenderQueue::DRAW_ITEM& item);
+
+	// append the world space mesh of a draw item to the batch of
+	// its render state
+	void AddItem(const RenderQueue::DRAW_ITEM& item);
+	// create the vertex arrays of the batches added since the
+	// last upload
+	void Upload();
+	// free the batches and their buffers
+	void Clear();
+
+	// batches, in the order they were started
+	int GetBatchCount() const { return((int)m_batches.size()); }
+	const BATCH& GetBatch(int index) const { return(m_batches[index]); }
+	// number of merged items in all the batches
+	int GetItemCount() const { return(m_itemCount); }
+
+	// draw the merged items of a batch with one call
+	void DrawBatch(int index);
+
+private:
+	// merged vertices and indices of a batch, until uploaded
+	struct BATCH_DATA
+	{
+		std::vector<float> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	// merged batches
+	std::vector<BATCH> m_batches;
+	// vertices waiting to be uploaded, one entry per batch
+	std::vector<BATCH_DATA> m_batchData;
+	// first batch not uploaded yet
+	int m_firstPendingBatch;
+	// number of merged items
+	int m_itemCount;
+	// local space meshes of the basic shapes, generated once
+	ShapeGeometry::MESH_DATA m_meshes[MESH_COUNT];
+	bool m_bMeshesGenerated;
+
+	// batch with room for the passed in number of vertices and
+	// the render state of the item, started when there is none
+	int FindBatch(const RenderQueue::DRAW_ITEM& item, int vertexCount);
+	// create the vertex array and buffers of a batch
+	void CreateBuffers(BATCH& batch, const BATCH_DATA& data);
+};
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// tagregistry.cpp
+// ============
+// intern string tags into compact integer IDs
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TagRegistry.h"
+
+namespace
+{
+	// returned for IDs that are out of range
+	const std::string g_EmptyTag;
+}
+
+/***********************************************************
+ *  TagRegistry()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TagRegistry::TagRegistry()
+{
+}
+
+/***********************************************************
+ *  ~TagRegistry()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TagRegistry::~TagRegistry()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Intern()
+ *
+ *  This method is used for getting the ID associated with
+ *  the passed in tag.  Unknown tags are assigned the next
+ *  available ID.
+ ***********************************************************/
+int TagRegistry::Intern(std::string_view tag)
+{
+	int id = Find(tag);
+	if (id >= 0)
+	{
+		return(id);
+	}
+
+	id = (int)m_tags.size();
+	m_tags.emplace_back(tag);
+	m_lookup.emplace(std::string_view(m_tags.back()), id);
+
+	return(id);
+}
+
+/***********************************************************
+ *  Find()
+ *
+ *  This method is used for getting the ID associated with
+ *  the passed in tag without adding it.
+ ***********************************************************/
+int TagRegistry::Find(std::string_view tag) const
+{
+	auto iter = m_lookup.find(tag);
+	if (iter == m_lookup.end())
+	{
+		return(-1);
+	}
+
+	return(iter->second);
+}
+
+/***********************************************************
+ *  GetTag()
+ *
+ *  This method is used for getting the tag string that was
+ *  interned for the passed in ID.
+ ***********************************************************/
+const std::string& TagRegistry::GetTag(int id) const
+{
+	if ((id < 0) || (id >= (int)m_tags.size()))
+	{
+		return(g_EmptyTag);
+	}
+
+	return(m_tags[id]);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the interned tags.
+ ***********************************************************/
+void TagRegistry::Clear()
+{
+	m_lookup.clear();
+	m_tags.clear();
+}
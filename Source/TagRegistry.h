@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////
+// tagregistry.h
+// ============
+// intern string tags into compact integer IDs
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/***********************************************************
+ *  TagRegistry
+ *
+ *  This class maps string tags, such as texture and material
+ *  names, to dense integer IDs starting at zero.  Tags are
+ *  interned once at load time; lookups by std::string_view
+ *  are hashed and never allocate.
+ ***********************************************************/
+class TagRegistry
+{
+public:
+	// constructor
+	TagRegistry();
+	// destructor
+	~TagRegistry();
+
+	// return the ID of the tag, adding it if not yet known
+	int Intern(std::string_view tag);
+	// return the ID of the tag, or -1 if it is not known
+	int Find(std::string_view tag) const;
+	// return the tag string associated with an ID
+	const std::string& GetTag(int id) const;
+	// number of interned tags
+	int Count() const { return((int)m_tags.size()); }
+	// remove all the interned tags
+	void Clear();
+
+private:
+	// interned tag strings - a deque keeps the storage stable
+	// so that the lookup keys can view into it
+	std::deque<std::string> m_tags;
+	// hashed lookup from tag to ID
+	std::unordered_map<std::string_view, int> m_lookup;
+};
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.cpp
+// ============
+// pack same-sized textures into the layers of texture arrays
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureArrays.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <iostream>
+
+/***********************************************************
+ *  TextureArrays()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureArrays::TextureArrays()
+{
+	m_maxTextureUnits = 0;
+}
+
+/***********************************************************
+ *  ~TextureArrays()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureArrays::~TextureArrays()
+{
+	DestroyArrays();
+}
+
+/***********************************************************
+ *  GetArrayTexture()
+ *
+ *  This method is used for getting the OpenGL name of the
+ *  array texture at the passed in index.
+ ***********************************************************/
+GLuint TextureArrays::GetArrayTexture(int arrayIndex) const
+{
+	if ((arrayIndex < 0) || (arrayIndex >= (int)m_arrays.size()))
+	{
+		return(0);
+	}
+
+	return(m_arrays[arrayIndex].textureID);
+}
+
+/***********************************************************
+ *  FindArray()
+ *
+ *  This method is used for finding an array holding
+ *  textures of the passed in size and format that still has
+ *  room for another layer.  A new array is created on the
+ *  next free texture unit when there is none, and -1 is
+ *  returned when the units are used up.
+ ***********************************************************/
+int TextureArrays::FindArray(int width, int height, GLenum internalFormat, int levels)
+{
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		const TEXTURE_ARRAY& textureArray = m_arrays[i];
+		if ((textureArray.width == width) &&
+			(textureArray.height == height) &&
+			(textureArray.internalFormat == internalFormat) &&
+			(textureArray.levels == levels) &&
+			((textureArray.textureID == 0) || (textureArray.layerCount < textureArray.layerCapacity)))
+		{
+			return((int)i);
+		}
+	}
+
+	// the arrays are all sampled in the fragment shader, so the
+	// units it can reach are the limit, not the combined count
+	if (m_maxTextureUnits == 0)
+	{
+		GLint combinedUnits = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &m_maxTextureUnits);
+		glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &combinedUnits);
+		m_maxTextureUnits = std::min(m_maxTextureUnits, combinedUnits);
+	}
+	if ((int)m_arrays.size() >= m_maxTextureUnits)
+	{
+		std::cout << "No texture unit left for a " << width << "x" << height << " texture array" << std::endl;
+		return(-1);
+	}
+
+	// the storage is allocated once all the layers are reserved
+	TEXTURE_ARRAY textureArray;
+	textureArray.textureID = 0;
+	textureArray.width = width;
+	textureArray.height = height;
+	textureArray.internalFormat = internalFormat;
+	textureArray.levels = levels;
+	textureArray.layerCount = 0;
+	textureArray.layerCapacity = 0;
+	m_arrays.push_back(textureArray);
+
+	return((int)m_arrays.size() - 1);
+}
+
+/***********************************************************
+ *  AllocateArray()
+ *
+ *  This method is used for allocating the storage of an
+ *  array with room for the layers reserved in it, and
+ *  binding it to the texture unit of the array.
+ ***********************************************************/
+void TextureArrays::AllocateArray(int arrayIndex)
+{
+	TEXTURE_ARRAY& textureArray = m_arrays[arrayIndex];
+
+	glGenTextures(1, &textureArray.textureID);
+	GLStateCache::ActiveTexture(GL_TEXTURE0 + arrayIndex);
+	GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, textureArray.textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, textureArray.levels, textureArray.internalFormat,
+		textureArray.width, textureArray.height, textureArray.layerCount);
+
+	textureArray.layerCapacity = textureArray.layerCount;
+}
+
+/***********************************************************
+ *  ReserveLayer()
+ *
+ *  This method is used for reserving a layer for a texture
+ *  of the passed in size and format before it is loaded.  A
+ *  reloaded texture keeps its layer when the format
+ *  matches, otherwise the old layer is simply no longer
+ *  referenced.
+ ***********************************************************/
+bool TextureArrays::ReserveLayer(
+	int width,
+	int height,
+	GLenum internalFormat,
+	int levels,
+	TEXTURE_LAYER& layer)
+{
+	if (IsLayerFormat(layer, width, height, internalFormat, levels) == true)
+	{
+		return(true);
+	}
+
+	int arrayIndex = FindArray(width, height, internalFormat, levels);
+	if (arrayIndex < 0)
+	{
+		layer = TEXTURE_LAYER();
+		return(false);
+	}
+
+	layer.arrayIndex = arrayIndex;
+	layer.layer = m_arrays[arrayIndex].layerCount;
+	m_arrays[arrayIndex].layerCount++;
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsLayerFormat()
+ *
+ *  This method is used for checking that a reserved layer
+ *  is in an array holding textures of the passed in size
+ *  and format, so a texture can be uploaded into it.
+ ***********************************************************/
+bool TextureArrays::IsLayerFormat(
+	const TEXTURE_LAYER& layer,
+	int width,
+	int height,
+	GLenum internalFormat,
+	int levels) const
+{
+	if ((layer.IsValid() == false) || (layer.arrayIndex >= (int)m_arrays.size()) ||
+		(layer.layer >= m_arrays[layer.arrayIndex].layerCount))
+	{
+		return(false);
+	}
+
+	const TEXTURE_ARRAY& textureArray = m_arrays[layer.arrayIndex];
+	return((textureArray.width == width) &&
+		(textureArray.height == height) &&
+		(textureArray.internalFormat == internalFormat) &&
+		(textureArray.levels == levels));
+}
+
+/***********************************************************
+ *  UploadLevel()
+ *
+ *  This method is used for uploading one mipmap level of a
+ *  texture into its reserved layer.  The pixels may be an
+ *  offset into a bound pixel unpack buffer, so the level is
+ *  transferred straight from the buffer into the array.
+ ***********************************************************/
+void TextureArrays::UploadLevel(const TEXTURE_LAYER& layer, int level, GLenum format, const void* pixels)
+{
+	TEXTURE_ARRAY& textureArray = m_arrays[layer.arrayIndex];
+	if (textureArray.textureID == 0)
+	{
+		AllocateArray(layer.arrayIndex);
+	}
+
+	GLStateCache::ActiveTexture(GL_TEXTURE0 + layer.arrayIndex);
+	GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, textureArray.textureID);
+	GLRecorder::TexSubImage3D(
+		GL_TEXTURE_2D_ARRAY,
+		level,
+		0, 0, layer.layer,
+		std::max(textureArray.width >> level, 1),
+		std::max(textureArray.height >> level, 1),
+		1,
+		format,
+		GL_UNSIGNED_BYTE,
+		pixels);
+}
+
+/***********************************************************
+ *  BindArrays()
+ *
+ *  This method is used for allocating the arrays whose
+ *  layers have all been reserved, and binding every texture
+ *  array to the texture unit matching its index.
+ ***********************************************************/
+void TextureArrays::BindArrays()
+{
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		if (m_arrays[i].textureID == 0)
+		{
+			AllocateArray((int)i);
+		}
+		GLStateCache::ActiveTexture(GL_TEXTURE0 + (GLenum)i);
+		GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_arrays[i].textureID);
+	}
+}
+
+/***********************************************************
+ *  DestroyArrays()
+ *
+ *  This method is used for freeing all the texture arrays.
+ ***********************************************************/
+void TextureArrays::DestroyArrays()
+{
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		GLStateCache::DeleteTextures(1, &m_arrays[i].textureID);
+	}
+	m_arrays.clear();
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.h
+// ============
+// pack same-sized textures into the layers of texture arrays
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  TextureArrays
+ *
+ *  This class keeps loaded textures in the layers of texture
+ *  arrays, one array for every combination of size, format
+ *  and mipmap count.  Each array stays bound to the texture
+ *  unit matching its index, so any texture can be selected
+ *  in the shader by an array unit and a layer without
+ *  binding a texture per object.  Layers are reserved while
+ *  the textures are queued, so each array is allocated once
+ *  with room for exactly its textures, and the mipmap levels
+ *  are uploaded straight into the layers.  A layer reserved
+ *  after its array was allocated starts a new array on the
+ *  next texture unit, so no layers are ever copied.
+ ***********************************************************/
+class TextureArrays
+{
+public:
+	// constructor
+	TextureArrays();
+	// destructor
+	~TextureArrays();
+
+	struct TEXTURE_LAYER
+	{
+		int arrayIndex = -1;
+		int layer = -1;
+
+		bool IsValid() const { return((arrayIndex >= 0) && (layer >= 0)); }
+	};
+
+	// reserve a layer in an array of the passed in format - a valid
+	// passed in layer of an array with the same format is kept
+	bool ReserveLayer(
+		int width,
+		int height,
+		GLenum internalFormat,
+		int levels,
+		TEXTURE_LAYER& layer);
+	// true if a reserved layer is in an array of the passed in format
+	bool IsLayerFormat(
+		const TEXTURE_LAYER& layer,
+		int width,
+		int height,
+		GLenum internalFormat,
+		int levels) const;
+	// upload one mipmap level of a reserved layer from the pixels,
+	// or from an offset into the bound pixel unpack buffer
+	void UploadLevel(const TEXTURE_LAYER& layer, int level, GLenum format, const void* pixels);
+	// allocate the arrays still waiting for storage and bind every
+	// array to the texture unit matching its index
+	void BindArrays();
+	// free all the texture arrays
+	void DestroyArrays();
+
+	// number of created arrays
+	int GetArrayCount() const { return((int)m_arrays.size()); }
+	// OpenGL name of an array texture
+	GLuint GetArrayTexture(int arrayIndex) const;
+
+private:
+	struct TEXTURE_ARRAY
+	{
+		GLuint textureID;
+		int width;
+		int height;
+		GLenum internalFormat;
+		int levels;
+		int layerCount;
+		int layerCapacity;
+	};
+
+	// created texture arrays, indexed by texture unit
+	std::vector<TEXTURE_ARRAY> m_arrays;
+	// number of texture units the fragment shader can sample
+	GLint m_maxTextureUnits;
+
+	// find the array of the passed in texture format with room for
+	// another layer, or create one
+	int FindArray(int width, int height, GLenum internalFormat, int levels);
+	// allocate the storage of an array for its reserved layers
+	void AllocateArray(int arrayIndex);
+};
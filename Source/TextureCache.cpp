@@ -0,0 +1,413 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.cpp
+// ============
+// store decoded, mipmapped textures on disk for fast reloading
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureCache.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// declaration of the cache file layout
+namespace
+{
+	// "TXC1" - identifies a texture cache file
+	const uint32_t CACHE_MAGIC = 0x31435854;
+	// bumped whenever the layout below changes
+	const uint32_t CACHE_VERSION = 1;
+
+	struct CACHE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceSize;
+		int64_t sourceModifiedTime;
+		uint32_t width;
+		uint32_t height;
+		uint32_t channels;
+		uint32_t levelCount;
+		uint64_t pixelSize;
+		uint32_t checksum;
+		uint32_t reserved;
+	};
+
+	struct CACHE_LEVEL
+	{
+		uint32_t width;
+		uint32_t height;
+		uint64_t offset;
+		uint64_t size;
+	};
+}
+
+/***********************************************************
+ *  TextureCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureCache::TextureCache()
+{
+	m_directory = "TextureCache";
+}
+
+/***********************************************************
+ *  ~TextureCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureCache::~TextureCache()
+{
+}
+
+/***********************************************************
+ *  SetDirectory()
+ *
+ *  This method is used for setting the directory holding
+ *  the cache files.  The directory is created if needed.
+ ***********************************************************/
+void TextureCache::SetDirectory(const std::string& directory)
+{
+	m_directory = directory;
+
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+}
+
+/***********************************************************
+ *  GetCachePath()
+ *
+ *  This method is used for getting the path of the cache
+ *  file for a source image, flattening the source path into
+ *  a single file name.
+ ***********************************************************/
+std::string TextureCache::GetCachePath(const std::string& sourceFile) const
+{
+	std::string name = sourceFile;
+	for (size_t i = 0; i < name.size(); i++)
+	{
+		if ((name[i] == '/') || (name[i] == '\\') || (name[i] == ':'))
+		{
+			name[i] = '_';
+		}
+	}
+
+	return(m_directory + "/" + name + ".texcache");
+}
+
+/***********************************************************
+ *  Checksum()
+ *
+ *  This method is used for calculating a checksum of the
+ *  pixel data.  It uses the FNV-1a offset basis and prime,
+ *  but folds in eight bytes at a time instead of one, so it
+ *  is not the FNV-1a hash of the data; only the last few
+ *  bytes are hashed one at a time.
+ ***********************************************************/
+uint32_t TextureCache::Checksum(const unsigned char* data, size_t size)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	size_t index = 0;
+
+	for (; index + 8 <= size; index += 8)
+	{
+		uint64_t block;
+		memcpy(&block, data + index, sizeof(block));
+		hash ^= block;
+		hash *= 1099511628211ULL;
+	}
+	for (; index < size; index++)
+	{
+		hash ^= data[index];
+		hash *= 1099511628211ULL;
+	}
+
+	return((uint32_t)(hash ^ (hash >> 32)));
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for mapping the cache file of a
+ *  source image.  False is returned when there is no entry,
+ *  or the entry is stale or damaged and must be rebuilt.
+ ***********************************************************/
+bool TextureCache::Open(const std::string& sourceFile, CACHED_TEXTURE& texture)
+{
+	uint64_t sourceSize = 0;
+	int64_t sourceModifiedTime = 0;
+	if (MappedFile::GetFileStamp(sourceFile, sourceSize, sourceModifiedTime) == false)
+	{
+		return(false);
+	}
+
+	size_t mapSize = 0;
+	void* mapView = MappedFile::Map(GetCachePath(sourceFile), mapSize);
+	if (NULL == mapView)
+	{
+		return(false);
+	}
+
+	const unsigned char* data = (const unsigned char*)mapView;
+	CACHE_HEADER header;
+	bool bValid = (mapSize >= sizeof(CACHE_HEADER));
+	if (bValid == true)
+	{
+		memcpy(&header, data, sizeof(header));
+		bValid = (header.magic == CACHE_MAGIC) &&
+			(header.version == CACHE_VERSION) &&
+			(header.sourceSize == sourceSize) &&
+			(header.sourceModifiedTime == sourceModifiedTime) &&
+			(header.width > 0) &&
+			(header.height > 0) &&
+			(header.levelCount > 0);
+	}
+
+	// the level table and the pixels must exactly fill the rest
+	// of the file - each size is compared with what is left, so
+	// huge values cannot wrap around and pass the check
+	if (bValid == true)
+	{
+		size_t remaining = mapSize - sizeof(CACHE_HEADER);
+		bValid = (header.levelCount <= remaining / sizeof(CACHE_LEVEL));
+		if (bValid == true)
+		{
+			remaining -= (size_t)header.levelCount * sizeof(CACHE_LEVEL);
+			bValid = (header.pixelSize == (uint64_t)remaining);
+		}
+	}
+
+	if (bValid == true)
+	{
+		const unsigned char* pixels = data + sizeof(CACHE_HEADER) + header.levelCount * sizeof(CACHE_LEVEL);
+		bValid = (header.channels >= 1) && (header.channels <= 4) &&
+			(Checksum(pixels, (size_t)header.pixelSize) == header.checksum);
+
+		// the level table is outside the checksum, so every level
+		// must be the one Build() lays out - half the size of the
+		// level before it, down to 1x1, with its pixels in the file
+		uint64_t expectedWidth = header.width;
+		uint64_t expectedHeight = header.height;
+		texture.levels.resize(header.levelCount);
+		for (uint32_t i = 0; (i < header.levelCount) && (bValid == true); i++)
+		{
+			CACHE_LEVEL level;
+			memcpy(&level, data + sizeof(CACHE_HEADER) + i * sizeof(CACHE_LEVEL), sizeof(level));
+			texture.levels[i].width = (int)level.width;
+			texture.levels[i].height = (int)level.height;
+			texture.levels[i].offset = (size_t)level.offset;
+			texture.levels[i].size = (size_t)level.size;
+			bValid = (level.width == expectedWidth) &&
+				(level.height == expectedHeight) &&
+				(level.size == expectedWidth * expectedHeight * header.channels) &&
+				(level.offset <= header.pixelSize) &&
+				(level.size <= header.pixelSize - level.offset);
+
+			expectedWidth = std::max(expectedWidth / 2, (uint64_t)1);
+			expectedHeight = std::max(expectedHeight / 2, (uint64_t)1);
+		}
+
+		if (bValid == true)
+		{
+			bValid = (texture.levels.back().width == 1) && (texture.levels.back().height == 1);
+		}
+
+		texture.width = (int)header.width;
+		texture.height = (int)header.height;
+		texture.channels = (int)header.channels;
+		texture.pixels = pixels;
+		texture.pixelSize = (size_t)header.pixelSize;
+	}
+
+	if (bValid == false)
+	{
+		MappedFile::Unmap(mapView, mapSize);
+		texture.levels.clear();
+		return(false);
+	}
+
+	texture.mapView = mapView;
+	texture.mapSize = mapSize;
+	texture.ownedPixels.clear();
+
+	return(true);
+}
+
+/***********************************************************
+ *  Downsample()
+ *
+ *  This method is used for building the next mipmap level
+ *  by averaging each 2x2 block of the source level.  Odd
+ *  sizes reuse the last row or column.
+ ***********************************************************/
+void TextureCache::Downsample(
+	const unsigned char* source,
+	int sourceWidth,
+	int sourceHeight,
+	unsigned char* destination,
+	int channels)
+{
+	int width = std::max(sourceWidth / 2, 1);
+	int height = std::max(sourceHeight / 2, 1);
+
+	for (int y = 0; y < height; y++)
+	{
+		const unsigned char* row0 = source + (size_t)std::min(y * 2, sourceHeight - 1) * sourceWidth * channels;
+		const unsigned char* row1 = source + (size_t)std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth * channels;
+
+		for (int x = 0; x < width; x++)
+		{
+			int x0 = std::min(x * 2, sourceWidth - 1) * channels;
+			int x1 = std::min(x * 2 + 1, sourceWidth - 1) * channels;
+
+			for (int c = 0; c < channels; c++)
+			{
+				int sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+				destination[((size_t)y * width + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the full mipmap chain
+ *  of a decoded image and writing it into the cache.  The
+ *  texture can be uploaded even if the write fails.
+ ***********************************************************/
+bool TextureCache::Build(
+	const std::string& sourceFile,
+	const unsigned char* pixels,
+	int width,
+	int height,
+	int channels,
+	CACHED_TEXTURE& texture)
+{
+	texture.width = width;
+	texture.height = height;
+	texture.channels = channels;
+	texture.mapView = NULL;
+	texture.mapSize = 0;
+	texture.levels.clear();
+
+	// lay out the levels down to 1x1
+	size_t totalSize = 0;
+	int levelWidth = width;
+	int levelHeight = height;
+	while (true)
+	{
+		TEXTURE_LEVEL level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		level.offset = totalSize;
+		level.size = (size_t)levelWidth * levelHeight * channels;
+		texture.levels.push_back(level);
+		totalSize += level.size;
+
+		if ((levelWidth == 1) && (levelHeight == 1))
+		{
+			break;
+		}
+		levelWidth = std::max(levelWidth / 2, 1);
+		levelHeight = std::max(levelHeight / 2, 1);
+	}
+
+	texture.ownedPixels.resize(totalSize);
+	memcpy(texture.ownedPixels.data(), pixels, texture.levels[0].size);
+	for (size_t i = 1; i < texture.levels.size(); i++)
+	{
+		const TEXTURE_LEVEL& previous = texture.levels[i - 1];
+		Downsample(
+			texture.ownedPixels.data() + previous.offset,
+			previous.width,
+			previous.height,
+			texture.ownedPixels.data() + texture.levels[i].offset,
+			channels);
+	}
+	texture.pixels = texture.ownedPixels.data();
+	texture.pixelSize = totalSize;
+
+	// write the cache file
+	CACHE_HEADER header;
+	memset(&header, 0, sizeof(header));
+	if (MappedFile::GetFileStamp(sourceFile, header.sourceSize, header.sourceModifiedTime) == false)
+	{
+		return(false);
+	}
+	header.magic = CACHE_MAGIC;
+	header.version = CACHE_VERSION;
+	header.width = (uint32_t)width;
+	header.height = (uint32_t)height;
+	header.channels = (uint32_t)channels;
+	header.levelCount = (uint32_t)texture.levels.size();
+	header.pixelSize = (uint64_t)totalSize;
+	header.checksum = Checksum(texture.pixels, totalSize);
+
+	// write to a temporary file first so a partially written
+	// entry is never picked up by another load
+	std::string cachePath = GetCachePath(sourceFile);
+	std::string tempPath = cachePath + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return(false);
+		}
+
+		file.write((const char*)&header, sizeof(header));
+		for (size_t i = 0; i < texture.levels.size(); i++)
+		{
+			CACHE_LEVEL level;
+			level.width = (uint32_t)texture.levels[i].width;
+			level.height = (uint32_t)texture.levels[i].height;
+			level.offset = (uint64_t)texture.levels[i].offset;
+			level.size = (uint64_t)texture.levels[i].size;
+			file.write((const char*)&level, sizeof(level));
+		}
+		file.write((const char*)texture.pixels, totalSize);
+
+		if (!file)
+		{
+			return(false);
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error)
+	{
+		std::cout << "Could not write texture cache:" << cachePath << std::endl;
+		std::filesystem::remove(tempPath, error);
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for releasing the mapped cache file
+ *  or the owned pixel memory of a texture.
+ ***********************************************************/
+void TextureCache::Close(CACHED_TEXTURE& texture)
+{
+	if (NULL != texture.mapView)
+	{
+		MappedFile::Unmap(texture.mapView, texture.mapSize);
+		texture.mapView = NULL;
+		texture.mapSize = 0;
+	}
+	texture.ownedPixels.clear();
+	texture.ownedPixels.shrink_to_fit();
+	texture.pixels = NULL;
+	texture.pixelSize = 0;
+}
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.h
+// ============
+// store decoded, mipmapped textures on disk for fast reloading
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TextureCache
+ *
+ *  This class keeps a binary copy of every decoded texture
+ *  image, with its full mipmap chain, in a cache directory.
+ *  Cache files are memory-mapped when loaded, so a texture
+ *  can be uploaded level by level without decoding the
+ *  source image again.  Each cache file records the size and
+ *  modification time of its source image, so an edited image
+ *  makes the entry stale, and a checksum of the pixel data,
+ *  so a damaged entry is rebuilt instead of uploaded.  The
+ *  mipmap level table is checked against the image size.
+ ***********************************************************/
+class TextureCache
+{
+public:
+	// constructor
+	TextureCache();
+	// destructor
+	~TextureCache();
+
+	struct TEXTURE_LEVEL
+	{
+		int width;
+		int height;
+		size_t offset;
+		size_t size;
+	};
+
+	struct CACHED_TEXTURE
+	{
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		std::vector<TEXTURE_LEVEL> levels;
+		// pixel data of all the levels, either inside the
+		// mapped cache file or in the owned memory
+		const unsigned char* pixels = NULL;
+		size_t pixelSize = 0;
+		std::vector<unsigned char> ownedPixels;
+		void* mapView = NULL;
+		size_t mapSize = 0;
+	};
+
+	// set the directory holding the cache files
+	void SetDirectory(const std::string& directory);
+	// map the cache entry of a source image if it is up to date
+	bool Open(const std::string& sourceFile, CACHED_TEXTURE& texture);
+	// build the mipmap chain of a decoded image and write it
+	// to the cache - the texture keeps its own copy of the pixels
+	bool Build(
+		const std::string& sourceFile,
+		const unsigned char* pixels,
+		int width,
+		int height,
+		int channels,
+		CACHED_TEXTURE& texture);
+	// release the mapped or owned pixels of a texture
+	static void Close(CACHED_TEXTURE& texture);
+
+private:
+	// directory holding the cache files
+	std::string m_directory;
+
+	// path of the cache file for a source image
+	std::string GetCachePath(const std::string& sourceFile) const;
+	// checksum of the pixel data
+	static uint32_t Checksum(const unsigned char* data, size_t size);
+	// average each 2x2 block of a level into the next level
+	static void Downsample(
+		const unsigned char* source,
+		int sourceWidth,
+		int sourceHeight,
+		unsigned char* destination,
+		int channels);
+};
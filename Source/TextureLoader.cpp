@@ -0,0 +1,386 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.cpp
+// ============
+// decode texture images on worker threads and upload them to OpenGL
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureLoader.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+// declaration of the global variables and defines
+namespace
+{
+	// directory holding the texture cache files
+	const char* const TEXTURE_CACHE_DIRECTORY = "TextureCache";
+
+	/***********************************************************
+	 *  GetImageFormat()
+	 *
+	 *  This function is used for getting the OpenGL formats of
+	 *  an image with the passed in number of channels.
+	 ***********************************************************/
+	bool GetImageFormat(int channels, GLenum& internalFormat, GLenum& format)
+	{
+		// if the loaded image is in RGB format
+		if (channels == 3)
+		{
+			internalFormat = GL_RGB8;
+			format = GL_RGB;
+		}
+		// if the loaded image is in RGBA format - it supports transparency
+		else if (channels == 4)
+		{
+			internalFormat = GL_RGBA8;
+			format = GL_RGBA;
+		}
+		else
+		{
+			std::cout << "Not implemented to handle image with " << channels << " channels" << std::endl;
+			return(false);
+		}
+
+		return(true);
+	}
+}
+
+/***********************************************************
+ *  TextureLoader()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureLoader::TextureLoader()
+{
+	m_activeDecodes = 0;
+	m_bStopping = false;
+	m_pixelBuffer = 0;
+}
+
+/***********************************************************
+ *  ~TextureLoader()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureLoader::~TextureLoader()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for creating the pixel buffer and
+ *  for starting the worker
+ *  threads.  By default one worker is started for every
+ *  processor core except the one running the render loop.
+ ***********************************************************/
+void TextureLoader::Start(int workerCount)
+{
+	if (m_workers.size() > 0)
+	{
+		return;
+	}
+
+	// indicate to always flip images vertically when loaded - this
+	// is set once here since the setting is shared by all threads
+	stbi_set_flip_vertically_on_load(true);
+
+	m_cache.SetDirectory(TEXTURE_CACHE_DIRECTORY);
+
+	glGenBuffers(1, &m_pixelBuffer);
+
+	if (workerCount <= 0)
+	{
+		workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+	}
+
+	m_bStopping = false;
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&TextureLoader::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for stopping the worker threads and
+ *  freeing any images that were not uploaded.
+ ***********************************************************/
+void TextureLoader::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+		m_requests.clear();
+	}
+	m_requestReady.notify_all();
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+
+	for (size_t i = 0; i < m_decoded.size(); i++)
+	{
+		TextureCache::Close(m_decoded[i].texture);
+	}
+	m_decoded.clear();
+
+	if (m_pixelBuffer != 0)
+	{
+		GLStateCache::DeleteBuffers(1, &m_pixelBuffer);
+		m_pixelBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  ReadImageFormat()
+ *
+ *  This method is used for reading the size and format of
+ *  an image file from its header, without decoding it, so
+ *  a texture array layer can be reserved for the image
+ *  before it is loaded.  The image is loaded with the full
+ *  mipmap chain down to 1x1.
+ ***********************************************************/
+bool TextureLoader::ReadImageFormat(
+	const char* filename,
+	int& width,
+	int& height,
+	GLenum& internalFormat,
+	int& levels)
+{
+	int channels = 0;
+	if (stbi_info(filename, &width, &height, &channels) == 0)
+	{
+		return(false);
+	}
+
+	GLenum format = 0;
+	if (GetImageFormat(channels, internalFormat, format) == false)
+	{
+		return(false);
+	}
+
+	levels = 1;
+	for (int size = std::max(width, height); size > 1; size /= 2)
+	{
+		levels++;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  QueueLoad()
+ *
+ *  This method is used for queueing an image file to be
+ *  decoded by the next available worker thread.
+ ***********************************************************/
+void TextureLoader::QueueLoad(const char* filename, int slot, const TextureArrays::TEXTURE_LAYER& layer)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		LOAD_REQUEST request;
+		request.filename = filename;
+		request.slot = slot;
+		request.layer = layer;
+		m_requests.push_back(request);
+	}
+	m_requestReady.notify_one();
+}
+
+/***********************************************************
+ *  IsBusy()
+ *
+ *  This method is used for checking whether any image is
+ *  still queued, being decoded or waiting to be uploaded.
+ ***********************************************************/
+bool TextureLoader::IsBusy()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return((m_requests.size() > 0) || (m_activeDecodes > 0) || (m_decoded.size() > 0));
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is run by every worker thread.  It takes the
+ *  next queued request and, outside of the lock, maps its
+ *  texture cache entry.  When the entry is missing or stale
+ *  the image file is decoded and the cache entry rebuilt.
+ *  The pixels are then queued for upload.
+ ***********************************************************/
+void TextureLoader::WorkerLoop()
+{
+	while (true)
+	{
+		LOAD_REQUEST request;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_requestReady.wait(lock, [this]() { return((m_bStopping == true) || (m_requests.size() > 0)); });
+			if (m_bStopping == true)
+			{
+				return;
+			}
+
+			request = m_requests.front();
+			m_requests.pop_front();
+			m_activeDecodes++;
+		}
+
+		DECODED_IMAGE image;
+		image.filename = request.filename;
+		image.slot = request.slot;
+		image.layer = request.layer;
+
+		bool bLoaded = m_cache.Open(request.filename, image.texture);
+		if (bLoaded == false)
+		{
+			int width = 0;
+			int height = 0;
+			int channels = 0;
+
+			// try to parse the image data from the specified image file
+			unsigned char* pixels = stbi_load(
+				request.filename.c_str(),
+				&width,
+				&height,
+				&channels,
+				0);
+
+			if (pixels)
+			{
+				// the texture keeps the built pixels even if the
+				// cache file could not be written
+				m_cache.Build(request.filename, pixels, width, height, channels, image.texture);
+				stbi_image_free(pixels);
+				bLoaded = true;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_activeDecodes--;
+		if (bLoaded == true)
+		{
+			m_decoded.push_back(std::move(image));
+		}
+		else
+		{
+			std::cout << "Could not load image:" << request.filename << std::endl;
+		}
+	}
+}
+
+/***********************************************************
+ *  ProcessUploads()
+ *
+ *  This method is used for uploading decoded images into
+ *  their texture array layers.  It must be called from the
+ *  thread that owns the OpenGL context, and uploads at most
+ *  the passed in number of images so a frame is never held
+ *  up by more than a few uploads.
+ ***********************************************************/
+int TextureLoader::ProcessUploads(int maxUploads, TextureArrays& arrays, std::vector<LOADED_TEXTURE>& loaded)
+{
+	int uploads = 0;
+
+	while (uploads < maxUploads)
+	{
+		DECODED_IMAGE image;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_decoded.size() == 0)
+			{
+				break;
+			}
+			image = std::move(m_decoded.front());
+			m_decoded.pop_front();
+		}
+
+		bool bUploaded = UploadImage(image, arrays);
+		TextureCache::Close(image.texture);
+
+		if (bUploaded == true)
+		{
+			std::cout << "Successfully loaded image:" << image.filename << ", width:" << image.texture.width << ", height:" << image.texture.height << ", channels:" << image.texture.channels << std::endl;
+
+			LOADED_TEXTURE texture;
+			texture.slot = image.slot;
+			texture.width = image.texture.width;
+			texture.height = image.texture.height;
+			loaded.push_back(texture);
+		}
+		uploads++;
+	}
+
+	return(uploads);
+}
+
+/***********************************************************
+ *  UploadImage()
+ *
+ *  This method is used for copying the pixels of every
+ *  mipmap level into the pixel buffer and uploading them
+ *  level by level straight into the reserved texture array
+ *  layer, so the driver can transfer the data without
+ *  stalling on the application memory and no mipmaps are
+ *  generated at load time.
+ ***********************************************************/
+bool TextureLoader::UploadImage(const DECODED_IMAGE& image, TextureArrays& arrays)
+{
+	GLenum internalFormat = 0;
+	GLenum format = 0;
+
+	const TextureCache::CACHED_TEXTURE& texture = image.texture;
+	if (GetImageFormat(texture.channels, internalFormat, format) == false)
+	{
+		return(false);
+	}
+
+	// the image may have changed since its layer was reserved
+	if (arrays.IsLayerFormat(image.layer, texture.width, texture.height, internalFormat, (int)texture.levels.size()) == false)
+	{
+		std::cout << "Image no longer matches its reserved texture layer:" << image.filename << std::endl;
+		return(false);
+	}
+
+	GLsizeiptr size = (GLsizeiptr)texture.pixelSize;
+
+	// orphan the pixel buffer and copy the pixels into it
+	GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffer);
+	GLRecorder::BufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+	void* pBuffer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (NULL == pBuffer)
+	{
+		GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return(false);
+	}
+	memcpy(pBuffer, texture.pixels, size);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	// rows of RGB images are not padded to four bytes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (size_t i = 0; i < texture.levels.size(); i++)
+	{
+		arrays.UploadLevel(image.layer, (int)i, format, (void*)texture.levels[i].offset);
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	return(true);
+}
\ No newline at end of file
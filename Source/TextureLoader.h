@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.h
+// ============
+// decode texture images on worker threads and upload them to OpenGL
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextureArrays.h"
+#include "TextureCache.h"
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  TextureLoader
+ *
+ *  This class decodes texture image files on a pool of
+ *  worker threads.  The decoded pixels are queued back to
+ *  the thread owning the OpenGL context, which uploads them
+ *  a few at a time through a pixel buffer object straight
+ *  into the texture array layers reserved for them.  Decoded
+ *  images and their mipmaps are kept in
+ *  a texture cache, so later runs skip the decode entirely.
+ ***********************************************************/
+class TextureLoader
+{
+public:
+	// constructor
+	TextureLoader();
+	// destructor
+	~TextureLoader();
+
+	struct LOADED_TEXTURE
+	{
+		int slot;
+		int width;
+		int height;
+	};
+
+	// start the worker threads and create the pixel buffer
+	void Start(int workerCount = 0);
+	// stop the worker threads and free any pending images
+	void Stop();
+
+	// read the size and format of an image file from its header,
+	// with the number of mipmap levels it is loaded with
+	static bool ReadImageFormat(
+		const char* filename,
+		int& width,
+		int& height,
+		GLenum& internalFormat,
+		int& levels);
+	// queue an image file to be decoded into the reserved texture
+	// array layer of the texture slot
+	void QueueLoad(const char* filename, int slot, const TextureArrays::TEXTURE_LAYER& layer);
+	// upload up to the passed in number of decoded images into
+	// their layers and append the loaded slots to the passed in list
+	int ProcessUploads(int maxUploads, TextureArrays& arrays, std::vector<LOADED_TEXTURE>& loaded);
+	// true while images are queued, decoding or waiting for upload
+	bool IsBusy();
+
+private:
+	struct LOAD_REQUEST
+	{
+		std::string filename;
+		int slot;
+		TextureArrays::TEXTURE_LAYER layer;
+	};
+
+	struct DECODED_IMAGE
+	{
+		std::string filename;
+		int slot;
+		TextureArrays::TEXTURE_LAYER layer;
+		TextureCache::CACHED_TEXTURE texture;
+	};
+
+	// worker threads decoding the images
+	std::vector<std::thread> m_workers;
+	// images waiting to be decoded
+	std::deque<LOAD_REQUEST> m_requests;
+	// decoded images waiting to be uploaded
+	std::deque<DECODED_IMAGE> m_decoded;
+	// number of images currently being decoded
+	int m_activeDecodes;
+	// guards the queues and the counters
+	std::mutex m_mutex;
+	// wakes the workers when requests are queued
+	std::condition_variable m_requestReady;
+	// set when the workers need to exit
+	bool m_bStopping;
+	// pixel buffer used for streaming uploads
+	GLuint m_pixelBuffer;
+	// decoded and mipmapped images stored on disk
+	TextureCache m_cache;
+
+	// loop run by each worker thread
+	void WorkerLoop();
+	// upload every mipmap level of a decoded image into its layer
+	bool UploadImage(const DECODED_IMAGE& image, TextureArrays& arrays);
+};
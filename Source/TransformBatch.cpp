@@ -0,0 +1,411 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformbatch.cpp
+// ============
+// compute the transformation matrices of many objects in one vectorized pass
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformBatch.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// SSE is part of every x64 target and of x86 targets built
+// with SSE2 code generation
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define TRANSFORM_BATCH_SSE
+#include <xmmintrin.h>
+#endif
+
+// declaration of the global variables and defines
+namespace
+{
+	// groups of four transforms computed by one job range
+	const int TRANSFORM_GROUPS_PER_JOB = 256;
+}
+
+/***********************************************************
+ *  TransformBatch()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformBatch::TransformBatch()
+{
+}
+
+/***********************************************************
+ *  ~TransformBatch()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TransformBatch::~TransformBatch()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Add()
+ *
+ *  This method is used for adding a transform.  The index
+ *  of a removed transform is reused before the arrays grow.
+ *  Its matrix is computed by the next pass.
+ ***********************************************************/
+int TransformBatch::Add(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	if (m_freeIndices.size() > 0)
+	{
+		int index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+		m_bRemoved[index] = false;
+		Set(index, scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+
+		return(index);
+	}
+
+	m_positionX.push_back(0.0f);
+	m_positionY.push_back(0.0f);
+	m_positionZ.push_back(0.0f);
+	m_rotationDegrees.push_back(glm::vec3(0.0f));
+	m_sinX.push_back(0.0f);
+	m_cosX.push_back(1.0f);
+	m_sinY.push_back(0.0f);
+	m_cosY.push_back(1.0f);
+	m_sinZ.push_back(0.0f);
+	m_cosZ.push_back(1.0f);
+	m_scaleX.push_back(1.0f);
+	m_scaleY.push_back(1.0f);
+	m_scaleZ.push_back(1.0f);
+	m_matrices.push_back(glm::mat4(1.0f));
+	m_bChanged.push_back(false);
+	m_bRemoved.push_back(false);
+
+	int index = (int)m_positionX.size() - 1;
+	Set(index, scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+
+	return(index);
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  This method is used for changing a transform.  The sines
+ *  and cosines of the rotations are computed here, the same
+ *  way glm::rotate() computes them.
+ ***********************************************************/
+void TransformBatch::Set(
+	int index,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	if ((index < 0) || (index >= GetCount()) || (m_bRemoved[index] == true))
+	{
+		return;
+	}
+
+	m_positionX[index] = positionXYZ.x;
+	m_positionY[index] = positionXYZ.y;
+	m_positionZ[index] = positionXYZ.z;
+	m_rotationDegrees[index] = glm::vec3(XrotationDegrees, YrotationDegrees, ZrotationDegrees);
+	m_sinX[index] = std::sin(glm::radians(XrotationDegrees));
+	m_cosX[index] = std::cos(glm::radians(XrotationDegrees));
+	m_sinY[index] = std::sin(glm::radians(YrotationDegrees));
+	m_cosY[index] = std::cos(glm::radians(YrotationDegrees));
+	m_sinZ[index] = std::sin(glm::radians(ZrotationDegrees));
+	m_cosZ[index] = std::cos(glm::radians(ZrotationDegrees));
+	m_scaleX[index] = scaleXYZ.x;
+	m_scaleY[index] = scaleXYZ.y;
+	m_scaleZ[index] = scaleXYZ.z;
+
+	if (m_bChanged[index] == false)
+	{
+		m_bChanged[index] = true;
+		m_changed.push_back(index);
+	}
+}
+
+/***********************************************************
+ *  Remove()
+ *
+ *  This method is used for removing a transform.  Its index
+ *  is kept for the next added transform, and a change to it
+ *  that was not computed yet is dropped, so the pass never
+ *  reports it.
+ ***********************************************************/
+void TransformBatch::Remove(int index)
+{
+	if ((index < 0) || (index >= GetCount()) || (m_bRemoved[index] == true))
+	{
+		return;
+	}
+
+	if (m_bChanged[index] == true)
+	{
+		m_changed.erase(std::find(m_changed.begin(), m_changed.end(), index));
+		m_bChanged[index] = false;
+	}
+
+	m_bRemoved[index] = true;
+	m_freeIndices.push_back(index);
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for a number of
+ *  transforms, so adding them does not reallocate.
+ ***********************************************************/
+void TransformBatch::Reserve(int count)
+{
+	m_positionX.reserve(count);
+	m_positionY.reserve(count);
+	m_positionZ.reserve(count);
+	m_rotationDegrees.reserve(count);
+	m_sinX.reserve(count);
+	m_cosX.reserve(count);
+	m_sinY.reserve(count);
+	m_cosY.reserve(count);
+	m_sinZ.reserve(count);
+	m_cosZ.reserve(count);
+	m_scaleX.reserve(count);
+	m_scaleY.reserve(count);
+	m_scaleZ.reserve(count);
+	m_matrices.reserve(count);
+	m_changed.reserve(count);
+	m_changedGroups.reserve((count + 3) / 4);
+	m_bChanged.reserve(count);
+	m_bRemoved.reserve(count);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the transforms.
+ ***********************************************************/
+void TransformBatch::Clear()
+{
+	m_positionX.clear();
+	m_positionY.clear();
+	m_positionZ.clear();
+	m_rotationDegrees.clear();
+	m_sinX.clear();
+	m_cosX.clear();
+	m_sinY.clear();
+	m_cosY.clear();
+	m_sinZ.clear();
+	m_cosZ.clear();
+	m_scaleX.clear();
+	m_scaleY.clear();
+	m_scaleZ.clear();
+	m_matrices.clear();
+	m_changed.clear();
+	m_computedChanges.clear();
+	m_changedGroups.clear();
+	m_bChanged.clear();
+	m_bRemoved.clear();
+	m_freeIndices.clear();
+}
+
+/***********************************************************
+ *  Compute()
+ *
+ *  This method is used for computing the matrices of the
+ *  transforms changed since the last pass.  Only the groups
+ *  of four holding a changed transform are computed, in
+ *  index order.  With a job system the groups are split
+ *  into ranges, so every thread computes the same matrices
+ *  the single-threaded pass would.
+ ***********************************************************/
+void TransformBatch::Compute(JobSystem* pJobSystem)
+{
+	m_changedGroups.clear();
+	for (size_t i = 0; i < m_changed.size(); i++)
+	{
+		m_changedGroups.push_back(m_changed[i] / 4);
+	}
+	std::sort(m_changedGroups.begin(), m_changedGroups.end());
+	m_changedGroups.erase(std::unique(m_changedGroups.begin(), m_changedGroups.end()), m_changedGroups.end());
+
+	int groupCount = (int)m_changedGroups.size();
+	if (NULL != pJobSystem)
+	{
+		pJobSystem->ParallelFor(groupCount, TRANSFORM_GROUPS_PER_JOB,
+			[this](int first, int last)
+			{
+				ComputeGroups(first, last);
+			});
+	}
+	else
+	{
+		ComputeGroups(0, groupCount);
+	}
+
+	for (size_t i = 0; i < m_changed.size(); i++)
+	{
+		m_bChanged[m_changed[i]] = false;
+	}
+	m_computedChanges.swap(m_changed);
+	m_changed.clear();
+}
+
+/***********************************************************
+ *  ComputeGroups()
+ *
+ *  This method is used for computing the matrices of a
+ *  range of the changed groups, four at a time, and one at
+ *  a time for the last group when it is not full.
+ ***********************************************************/
+void TransformBatch::ComputeGroups(int first, int last)
+{
+	int count = GetCount();
+
+	for (int i = first; i < last; i++)
+	{
+		int index = m_changedGroups[i] * 4;
+		if (index + 4 <= count)
+		{
+			ComputeFour(index);
+			continue;
+		}
+
+		for (; index < count; index++)
+		{
+			ComputeOne(index);
+		}
+	}
+}
+
+/***********************************************************
+ *  ComputeOne()
+ *
+ *  This method is used for computing one matrix.  The
+ *  rotation is the product rotateX * rotateY * rotateZ
+ *  expanded into its nine terms, and each of its columns is
+ *  multiplied by the matching scale.
+ ***********************************************************/
+void TransformBatch::ComputeOne(int index)
+{
+	float sx = m_sinX[index];
+	float cx = m_cosX[index];
+	float sy = m_sinY[index];
+	float cy = m_cosY[index];
+	float sz = m_sinZ[index];
+	float cz = m_cosZ[index];
+
+	glm::mat4& matrix = m_matrices[index];
+
+	matrix[0][0] = (cy * cz) * m_scaleX[index];
+	matrix[0][1] = (cx * sz + sx * sy * cz) * m_scaleX[index];
+	matrix[0][2] = (sx * sz - cx * sy * cz) * m_scaleX[index];
+	matrix[0][3] = 0.0f;
+
+	matrix[1][0] = -(cy * sz) * m_scaleY[index];
+	matrix[1][1] = (cx * cz - sx * sy * sz) * m_scaleY[index];
+	matrix[1][2] = (sx * cz + cx * sy * sz) * m_scaleY[index];
+	matrix[1][3] = 0.0f;
+
+	matrix[2][0] = sy * m_scaleZ[index];
+	matrix[2][1] = -(sx * cy) * m_scaleZ[index];
+	matrix[2][2] = (cx * cy) * m_scaleZ[index];
+	matrix[2][3] = 0.0f;
+
+	matrix[3][0] = m_positionX[index];
+	matrix[3][1] = m_positionY[index];
+	matrix[3][2] = m_positionZ[index];
+	matrix[3][3] = 1.0f;
+}
+
+/***********************************************************
+ *  ComputeFour()
+ *
+ *  This method is used for computing four matrices at
+ *  once with SSE.  Each register holds one matrix term for
+ *  four objects, and the terms are transposed into matrix
+ *  columns when they are stored.  Negation flips the sign
+ *  bit, like the unary minus of ComputeOne(), so a zero
+ *  term keeps the same sign and the results are identical.
+ ***********************************************************/
+void TransformBatch::ComputeFour(int first)
+{
+#ifdef TRANSFORM_BATCH_SSE
+	__m128 sx = _mm_loadu_ps(&m_sinX[first]);
+	__m128 cx = _mm_loadu_ps(&m_cosX[first]);
+	__m128 sy = _mm_loadu_ps(&m_sinY[first]);
+	__m128 cy = _mm_loadu_ps(&m_cosY[first]);
+	__m128 sz = _mm_loadu_ps(&m_sinZ[first]);
+	__m128 cz = _mm_loadu_ps(&m_cosZ[first]);
+	__m128 scaleX = _mm_loadu_ps(&m_scaleX[first]);
+	__m128 scaleY = _mm_loadu_ps(&m_scaleY[first]);
+	__m128 scaleZ = _mm_loadu_ps(&m_scaleZ[first]);
+	__m128 zero = _mm_setzero_ps();
+	__m128 signBit = _mm_set1_ps(-0.0f);
+	__m128 sxsy = _mm_mul_ps(sx, sy);
+	__m128 cxsy = _mm_mul_ps(cx, sy);
+
+	// same terms, in the same order, as ComputeOne()
+	__m128 columns[4][4];
+	columns[0][0] = _mm_mul_ps(_mm_mul_ps(cy, cz), scaleX);
+	columns[0][1] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, sz), _mm_mul_ps(sxsy, cz)), scaleX);
+	columns[0][2] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sx, sz), _mm_mul_ps(cxsy, cz)), scaleX);
+	columns[0][3] = zero;
+
+	columns[1][0] = _mm_mul_ps(_mm_xor_ps(_mm_mul_ps(cy, sz), signBit), scaleY);
+	columns[1][1] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cx, cz), _mm_mul_ps(sxsy, sz)), scaleY);
+	columns[1][2] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sx, cz), _mm_mul_ps(cxsy, sz)), scaleY);
+	columns[1][3] = zero;
+
+	columns[2][0] = _mm_mul_ps(sy, scaleZ);
+	columns[2][1] = _mm_mul_ps(_mm_xor_ps(_mm_mul_ps(sx, cy), signBit), scaleZ);
+	columns[2][2] = _mm_mul_ps(_mm_mul_ps(cx, cy), scaleZ);
+	columns[2][3] = zero;
+
+	columns[3][0] = _mm_loadu_ps(&m_positionX[first]);
+	columns[3][1] = _mm_loadu_ps(&m_positionY[first]);
+	columns[3][2] = _mm_loadu_ps(&m_positionZ[first]);
+	columns[3][3] = _mm_set1_ps(1.0f);
+
+	for (int column = 0; column < 4; column++)
+	{
+		// after the transpose, register i holds the column of object i
+		_MM_TRANSPOSE4_PS(columns[column][0], columns[column][1], columns[column][2], columns[column][3]);
+		for (int i = 0; i < 4; i++)
+		{
+			_mm_storeu_ps(&m_matrices[first + i][column][0], columns[column][i]);
+		}
+	}
+#else
+	for (int i = 0; i < 4; i++)
+	{
+		ComputeOne(first + i);
+	}
+#endif
+}
+
+/***********************************************************
+ *  ComputeReference()
+ *
+ *  This method is used for composing a matrix from
+ *  separate scale, rotation and translation matrices with
+ *  GLM, for checking the matrices computed by the pass.
+ ***********************************************************/
+glm::mat4 TransformBatch::ComputeReference(int index) const
+{
+	glm::mat4 scale = glm::scale(glm::vec3(m_scaleX[index], m_scaleY[index], m_scaleZ[index]));
+	glm::mat4 rotationX = glm::rotate(glm::radians(m_rotationDegrees[index].x), glm::vec3(1.0f, 0.0f, 0.0f));
+	glm::mat4 rotationY = glm::rotate(glm::radians(m_rotationDegrees[index].y), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 rotationZ = glm::rotate(glm::radians(m_rotationDegrees[index].z), glm::vec3(0.0f, 0.0f, 1.0f));
+	glm::mat4 translation = glm::translate(glm::vec3(m_positionX[index], m_positionY[index], m_positionZ[index]));
+
+	return(translation * rotationX * rotationY * rotationZ * scale);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformbatch.h
+// ============
+// compute the transformation matrices of many objects in one vectorized pass
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "JobSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  TransformBatch
+ *
+ *  This class stores the scale, rotation and position of
+ *  many objects in structure-of-arrays form and computes
+ *  their matrices in one pass, four objects at a time
+ *  with SSE when it is available.  The matrices match the
+ *  translate * rotateX * rotateY * rotateZ * scale order of
+ *  SceneManager::ComposeTransform().  The sines and cosines
+ *  of the rotations are computed when a transform is set,
+ *  so the pass itself is only multiplications and adds.
+ ***********************************************************/
+class TransformBatch
+{
+public:
+	// constructor
+	TransformBatch();
+	// destructor
+	~TransformBatch();
+
+	// add a transform and return its index
+	int Add(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	// change a transform, to be computed by the next pass
+	void Set(
+		int index,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	// remove a transform, freeing its index for the next one added
+	void Remove(int index);
+	// make room for a number of transforms
+	void Reserve(int count);
+	// remove all the transforms
+	void Clear();
+
+	// compute the matrices of the changed transforms, spread
+	// over the threads of the job system when one is passed in
+	void Compute(JobSystem* pJobSystem = NULL);
+	// true when transforms changed since the last pass
+	bool IsDirty() const { return(m_changed.size() > 0); }
+	// transforms changed before the last pass
+	const std::vector<int>& GetComputedChanges() const { return(m_computedChanges); }
+
+	// number of transform indices, including removed ones
+	int GetCount() const { return((int)m_positionX.size()); }
+	// matrix computed by the last pass
+	const glm::mat4& GetMatrix(int index) const { return(m_matrices[index]); }
+	// matrix composed from separate GLM matrices, the way
+	// the pass replaces, for checking the computed results
+	glm::mat4 ComputeReference(int index) const;
+	// compute one matrix without SIMD
+	void ComputeOne(int index);
+	// compute four matrices with SSE, giving the same results
+	// as four calls to ComputeOne()
+	void ComputeFour(int first);
+
+private:
+	// transform values, one entry per object
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_positionZ;
+	std::vector<glm::vec3> m_rotationDegrees;
+	std::vector<float> m_sinX;
+	std::vector<float> m_cosX;
+	std::vector<float> m_sinY;
+	std::vector<float> m_cosY;
+	std::vector<float> m_sinZ;
+	std::vector<float> m_cosZ;
+	std::vector<float> m_scaleX;
+	std::vector<float> m_scaleY;
+	std::vector<float> m_scaleZ;
+	// computed matrices
+	std::vector<glm::mat4> m_matrices;
+	// transforms changed since the last pass, and during it
+	std::vector<int> m_changed;
+	std::vector<int> m_computedChanges;
+	// groups of four holding the changes of the current pass
+	std::vector<int> m_changedGroups;
+	// true for the transforms listed in m_changed
+	std::vector<bool> m_bChanged;
+	// true for removed transforms, whose indices are listed
+	// in m_freeIndices for reuse
+	std::vector<bool> m_bRemoved;
+	std::vector<int> m_freeIndices;
+
+	// compute the matrices of a range of the changed groups
+	void ComputeGroups(int first, int last);
+};
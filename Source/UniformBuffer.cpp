@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformbuffer.cpp
+// ============
+// mirror a shader uniform block in memory and upload only what changed
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "UniformBuffer.h"
+#include "GLRecorder.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+/***********************************************************
+ *  UniformBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+UniformBuffer::UniformBuffer()
+{
+	m_bufferID = 0;
+	m_target = GL_UNIFORM_BUFFER;
+	m_bindingPoint = 0;
+	m_dirtyBegin = 0;
+	m_dirtyEnd = 0;
+}
+
+/***********************************************************
+ *  ~UniformBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+UniformBuffer::~UniformBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the buffer with the
+ *  passed in size and attaching it to the binding point of
+ *  the shader block.  The contents start zeroed.
+ ***********************************************************/
+void UniformBuffer::Create(GLuint bindingPoint, size_t size, GLenum target)
+{
+	Destroy();
+
+	m_target = target;
+	m_bindingPoint = bindingPoint;
+	m_data.assign(size, 0);
+	m_dirtyBegin = 0;
+	m_dirtyEnd = 0;
+
+	glGenBuffers(1, &m_bufferID);
+	GLStateCache::BindBuffer(m_target, m_bufferID);
+	GLRecorder::BufferData(m_target, (GLsizeiptr)size, m_data.data(), GL_DYNAMIC_DRAW);
+	GLStateCache::BindBuffer(m_target, 0);
+
+	Bind();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the buffer.
+ ***********************************************************/
+void UniformBuffer::Destroy()
+{
+	if (m_bufferID != 0)
+	{
+		GLStateCache::DeleteBuffers(1, &m_bufferID);
+		m_bufferID = 0;
+	}
+	m_data.clear();
+	m_dirtyBegin = 0;
+	m_dirtyEnd = 0;
+}
+
+/***********************************************************
+ *  Bind()
+ *
+ *  This method is used for attaching the buffer to the
+ *  binding point of its shader block.
+ ***********************************************************/
+void UniformBuffer::Bind()
+{
+	if (m_bufferID != 0)
+	{
+		GLStateCache::BindBufferBase(m_target, m_bindingPoint, m_bufferID);
+	}
+}
+
+/***********************************************************
+ *  Write()
+ *
+ *  This method is used for copying data into the local copy
+ *  of the buffer.  Writes past the end of the buffer are
+ *  ignored, and bytes that do not change are not marked
+ *  dirty.
+ ***********************************************************/
+void UniformBuffer::Write(size_t offset, const void* data, size_t size)
+{
+	if ((size == 0) || (offset + size > m_data.size()))
+	{
+		return;
+	}
+
+	if (memcmp(&m_data[offset], data, size) == 0)
+	{
+		return;
+	}
+	memcpy(&m_data[offset], data, size);
+
+	if (m_dirtyEnd == m_dirtyBegin)
+	{
+		m_dirtyBegin = offset;
+		m_dirtyEnd = offset + size;
+	}
+	else
+	{
+		m_dirtyBegin = std::min(m_dirtyBegin, offset);
+		m_dirtyEnd = std::max(m_dirtyEnd, offset + size);
+	}
+}
+
+/***********************************************************
+ *  Flush()
+ *
+ *  This method is used for uploading the bytes changed since
+ *  the last flush with one sub-buffer update.
+ ***********************************************************/
+bool UniformBuffer::Flush()
+{
+	if ((m_bufferID == 0) || (m_dirtyEnd == m_dirtyBegin))
+	{
+		return(false);
+	}
+
+	// the buffer is left bound, so flushing it again does not
+	// need another bind
+	GLStateCache::BindBuffer(m_target, m_bufferID);
+	GLRecorder::BufferSubData(m_target, (GLintptr)m_dirtyBegin, (GLsizeiptr)(m_dirtyEnd - m_dirtyBegin), &m_data[m_dirtyBegin]);
+
+	m_dirtyBegin = 0;
+	m_dirtyEnd = 0;
+
+	return(true);
+}
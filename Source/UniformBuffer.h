@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformbuffer.h
+// ============
+// mirror a shader uniform block in memory and upload only what changed
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  UniformBuffer
+ *
+ *  This class owns an OpenGL buffer bound to a uniform (or
+ *  shader storage) block binding point, together with a copy
+ *  of its contents in local memory.  Writes only change the
+ *  local copy and widen a dirty byte range, and Flush()
+ *  uploads the whole dirty range with a single sub-buffer
+ *  update.  The layout of the local copy must follow the
+ *  std140 (or std430) rules of the shader block.
+ ***********************************************************/
+class UniformBuffer
+{
+public:
+	// constructor
+	UniformBuffer();
+	// destructor
+	~UniformBuffer();
+
+	// create the buffer and attach it to the block binding point
+	void Create(GLuint bindingPoint, size_t size, GLenum target = GL_UNIFORM_BUFFER);
+	// free the buffer
+	void Destroy();
+	// true once the buffer has been created
+	bool IsCreated() const { return(m_bufferID != 0); }
+
+	// copy data into the local copy, marking changed bytes dirty
+	void Write(size_t offset, const void* data, size_t size);
+	template<typename T>
+	void Write(size_t offset, const T& value)
+	{
+		Write(offset, &value, sizeof(T));
+	}
+	// upload the dirty range, returning false if nothing changed
+	bool Flush();
+
+	// attach the buffer to its binding point again
+	void Bind();
+	// OpenGL name of the buffer
+	GLuint GetBufferID() const { return(m_bufferID); }
+	// size of the buffer in bytes
+	size_t GetSize() const { return(m_data.size()); }
+
+private:
+	// OpenGL buffer and the binding it is attached to
+	GLuint m_bufferID;
+	GLenum m_target;
+	GLuint m_bindingPoint;
+	// local copy of the buffer contents
+	std::vector<unsigned char> m_data;
+	// byte range changed since the last upload
+	size_t m_dirtyBegin;
+	size_t m_dirtyEnd;
+};
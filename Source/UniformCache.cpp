@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformcache.cpp
+// ============
+// resolve shader uniform locations once and skip redundant uploads
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "UniformCache.h"
+#include "GLRecorder.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+
+/***********************************************************
+ *  UniformCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+UniformCache::UniformCache()
+{
+	m_programID = 0;
+	m_stats.uploads = 0;
+	m_stats.skipped = 0;
+}
+
+/***********************************************************
+ *  ~UniformCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+UniformCache::~UniformCache()
+{
+	m_entries.clear();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for resolving the locations of all
+ *  the registered uniforms against the shader program that
+ *  is currently in use.  It must be called after the shaders
+ *  are loaded and activated.
+ ***********************************************************/
+void UniformCache::Initialize()
+{
+	GLint currentProgram = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+	m_programID = (GLuint)currentProgram;
+
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		m_entries[i].location = glGetUniformLocation(m_programID, m_entries[i].name.c_str());
+	}
+
+	Invalidate();
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for discarding the shadowed values,
+ *  for example after the shader program has been relinked.
+ ***********************************************************/
+void UniformCache::Invalidate()
+{
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		m_entries[i].bHasValue = false;
+	}
+}
+
+/***********************************************************
+ *  ResetStats()
+ *
+ *  This method is used for clearing the upload counters.
+ ***********************************************************/
+void UniformCache::ResetStats()
+{
+	m_stats.uploads = 0;
+	m_stats.skipped = 0;
+}
+
+/***********************************************************
+ *  RegisterName()
+ *
+ *  This method is used for adding a uniform name to the
+ *  cache.  Registering the same name twice returns the
+ *  existing entry.  If the program is already known, the
+ *  location is resolved immediately.
+ ***********************************************************/
+int UniformCache::RegisterName(const char* name)
+{
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		if (m_entries[i].name.compare(name) == 0)
+		{
+			return((int)i);
+		}
+	}
+
+	UNIFORM_ENTRY entry;
+	entry.name = name;
+	entry.location = -1;
+	entry.bHasValue = false;
+	memset(entry.value, 0, sizeof(entry.value));
+
+	if (m_programID != 0)
+	{
+		entry.location = glGetUniformLocation(m_programID, name);
+	}
+
+	m_entries.push_back(entry);
+
+	return((int)m_entries.size() - 1);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for comparing the passed in value
+ *  against the shadow copy.  The location is returned when
+ *  the value needs to be uploaded, otherwise -1.
+ ***********************************************************/
+GLint UniformCache::Update(int index, const void* value, size_t size)
+{
+	if ((index < 0) || (index >= (int)m_entries.size()))
+	{
+		return(-1);
+	}
+
+	UNIFORM_ENTRY& entry = m_entries[index];
+	if (entry.location < 0)
+	{
+		return(-1);
+	}
+
+	if ((entry.bHasValue == true) && (memcmp(entry.value, value, size) == 0))
+	{
+		m_stats.skipped++;
+		return(-1);
+	}
+
+	memcpy(entry.value, value, size);
+	entry.bHasValue = true;
+	m_stats.uploads++;
+
+	return(entry.location);
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  These methods are used for uploading a typed value into
+ *  the uniform associated with the passed in handle.
+ ***********************************************************/
+void UniformCache::Set(UniformHandle<bool> handle, bool value)
+{
+	int intValue = (int)value;
+	GLint location = Update(handle.index, &intValue, sizeof(intValue));
+	if (location >= 0)
+	{
+		GLRecorder::Uniform1i(location, intValue);
+	}
+}
+
+void UniformCache::Set(UniformHandle<int> handle, int value)
+{
+	GLint location = Update(handle.index, &value, sizeof(value));
+	if (location >= 0)
+	{
+		GLRecorder::Uniform1i(location, value);
+	}
+}
+
+void UniformCache::Set(UniformHandle<float> handle, float value)
+{
+	GLint location = Update(handle.index, &value, sizeof(value));
+	if (location >= 0)
+	{
+		GLRecorder::Uniform1f(location, value);
+	}
+}
+
+void UniformCache::Set(UniformHandle<glm::vec2> handle, const glm::vec2& value)
+{
+	GLint location = Update(handle.index, glm::value_ptr(value), sizeof(glm::vec2));
+	if (location >= 0)
+	{
+		GLRecorder::Uniform2fv(location, glm::value_ptr(value));
+	}
+}
+
+void UniformCache::Set(UniformHandle<glm::vec3> handle, const glm::vec3& value)
+{
+	GLint location = Update(handle.index, glm::value_ptr(value), sizeof(glm::vec3));
+	if (location >= 0)
+	{
+		GLRecorder::Uniform3fv(location, glm::value_ptr(value));
+	}
+}
+
+void UniformCache::Set(UniformHandle<glm::vec4> handle, const glm::vec4& value)
+{
+	GLint location = Update(handle.index, glm::value_ptr(value), sizeof(glm::vec4));
+	if (location >= 0)
+	{
+		GLRecorder::Uniform4fv(location, glm::value_ptr(value));
+	}
+}
+
+void UniformCache::Set(UniformHandle<glm::mat4> handle, const glm::mat4& value)
+{
+	GLint location = Update(handle.index, glm::value_ptr(value), sizeof(glm::mat4));
+	if (location >= 0)
+	{
+		GLRecorder::UniformMatrix4fv(location, glm::value_ptr(value));
+	}
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformcache.h
+// ============
+// resolve shader uniform locations once and skip redundant uploads
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  UniformHandle
+ *
+ *  Typed handle to a uniform registered in the cache. The
+ *  type parameter selects the matching glUniform* call.
+ ***********************************************************/
+template<typename T>
+struct UniformHandle
+{
+	int index = -1;
+
+	bool IsValid() const { return(index >= 0); }
+};
+
+/***********************************************************
+ *  UniformCache
+ *
+ *  This class resolves uniform names into locations once,
+ *  after the shader program has been loaded, and keeps a
+ *  shadow copy of every uploaded value so that unchanged
+ *  values are not sent to the driver again.
+ ***********************************************************/
+class UniformCache
+{
+public:
+	// constructor
+	UniformCache();
+	// destructor
+	~UniformCache();
+
+	struct UNIFORM_STATS
+	{
+		unsigned int uploads;
+		unsigned int skipped;
+	};
+
+	// resolve all registered names against the program in use
+	void Initialize();
+	// forget all shadowed values so the next set always uploads
+	void Invalidate();
+
+	// register a uniform name and return its typed handle
+	template<typename T>
+	UniformHandle<T> Register(const char* name)
+	{
+		UniformHandle<T> handle;
+		handle.index = RegisterName(name);
+		return(handle);
+	}
+
+	// upload the value only when it differs from the shadow copy
+	void Set(UniformHandle<bool> handle, bool value);
+	void Set(UniformHandle<int> handle, int value);
+	void Set(UniformHandle<float> handle, float value);
+	void Set(UniformHandle<glm::vec2> handle, const glm::vec2& value);
+	void Set(UniformHandle<glm::vec3> handle, const glm::vec3& value);
+	void Set(UniformHandle<glm::vec4> handle, const glm::vec4& value);
+	void Set(UniformHandle<glm::mat4> handle, const glm::mat4& value);
+
+	// upload counters since the last reset
+	const UNIFORM_STATS& GetStats() const { return(m_stats); }
+	void ResetStats();
+
+private:
+	struct UNIFORM_ENTRY
+	{
+		std::string name;
+		GLint location;
+		bool bHasValue;
+		unsigned char value[sizeof(glm::mat4)];
+	};
+
+	// program the locations were resolved against
+	GLuint m_programID;
+	// registered uniforms, indexed by handle
+	std::vector<UNIFORM_ENTRY> m_entries;
+	// upload counters
+	UNIFORM_STATS m_stats;
+
+	// add a name to the registry, reusing an existing entry
+	int RegisterName(const char* name);
+	// compare against and refresh the shadow copy, returning
+	// the location to upload to or -1 if the upload is redundant
+	GLint Update(int index, const void* value, size_t size);
+};
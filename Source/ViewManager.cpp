@@ -8,6 +8,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ViewManager.h"
+#include "GLStateCache.h"
 
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
@@ -20,8 +21,6 @@ namespace
 	// Variables for window width and height
 	const int WINDOW_WIDTH = 2500; // Increased the window width to 2500 for better viewing
 	const int WINDOW_HEIGHT = 1600; // Increased the window height to 1600 for better viewing
-	const char* g_ViewName = "view";
-	const char* g_ProjectionName = "projection";
 
 	// camera object used for viewing and interacting with
 	// the 3D scene
@@ -42,6 +41,10 @@ namespace
 
 	// Global camera speed multiplier (adjustable by mouse scroll)
 	float g_CameraSpeedFactor = 1.0f;
+
+	// true when the camera, the projection or the window changed
+	// since the last drawn frame - set by the GLFW callbacks too
+	bool g_bViewChanged = true;
 }
 
 void Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset);
@@ -57,6 +60,10 @@ ViewManager::ViewManager(
 	// initialize the member variables
 	m_pShaderManager = pShaderManager;
 	m_pWindow = NULL;
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_viewWidth = WINDOW_WIDTH;
+	m_viewHeight = WINDOW_HEIGHT;
 	g_pCamera = new Camera();
 	// default camera view parameters
 	g_pCamera->Position = glm::vec3(0.0f, 5.0f, 12.0f);
@@ -114,9 +121,14 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	// this callback is used to receive mouse scrolling events
 	glfwSetScrollCallback(window, Scroll_Callback);
 
+	// these callbacks are used to redraw on demand, when a key is
+	// pressed or released and when the window must be repainted
+	glfwSetKeyCallback(window, &ViewManager::Key_Callback);
+	glfwSetWindowRefreshCallback(window, &ViewManager::Window_Refresh_Callback);
+
 	// enable blending for supporting tranparent rendering
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLStateCache::Enable(GL_BLEND);
+	GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	m_pWindow = window;
 
@@ -150,6 +162,35 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
 
 	// move the 3D camera according to the calculated offsets
 	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+	if ((xOffset != 0.0f) || (yOffset != 0.0f))
+	{
+		g_bViewChanged = true;
+	}
+}
+
+/***********************************************************
+ *  Key_Callback()
+ *
+ *  This method is automatically called from GLFW whenever
+ *  a key is pressed, repeated or released.  The keys are
+ *  read when the next frame is prepared, so this only wakes
+ *  a loop that is waiting for the view to change.
+ ***********************************************************/
+void ViewManager::Key_Callback(GLFWwindow* /*window*/, int /*key*/, int /*scancode*/, int /*action*/, int /*mods*/)
+{
+	g_bViewChanged = true;
+}
+
+/***********************************************************
+ *  Window_Refresh_Callback()
+ *
+ *  This method is automatically called from GLFW whenever
+ *  the contents of the window were damaged or resized and
+ *  need to be drawn again.
+ ***********************************************************/
+void ViewManager::Window_Refresh_Callback(GLFWwindow* /*window*/)
+{
+	g_bViewChanged = true;
 }
 
 /***********************************************************
@@ -186,6 +227,18 @@ void ViewManager::ProcessKeyboardEvents()
 		return;
 	}
 
+	// the camera keeps moving, and the frames keep being drawn,
+	// for as long as one of the movement keys is held down
+	if ((glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS))
+	{
+		g_bViewChanged = true;
+	}
+
 	// process camera zooming in and out
 	// Added speed factor to the zooming in and out of the camera
 	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS) {
@@ -227,9 +280,11 @@ void ViewManager::ToggleProjectionMode() {
 		g_pCamera->Position = glm::vec3(0.0f, 10.0f, 0.0f); // Move the camera to the top of the scene
 		g_pCamera->Front = glm::vec3(0.0f, -1.0f, 0.0f); // Set the front of the camera to look down at the 3D object
 		g_pCamera->Up = glm::vec3(0.0f, 0.0f, -1.0f); // Adjust Up vector to align with the camera's new position
+		g_bViewChanged = true;
 	}
 	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS) {
 		bOrthographicProjection = false;
+		g_bViewChanged = true;
 	}
 }
 
@@ -259,7 +314,7 @@ void ViewManager::PrepareSceneView()
 		projection = glm::ortho(-8.0f, 10.0f, -8.0f, 10.0f, 0.5f, 100.0f);
 	}
 	else {
-		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)m_viewWidth / (GLfloat)m_viewHeight, 0.1f, 100.0f);
 	}
 
 	// get the current view matrix from the camera
@@ -268,14 +323,112 @@ void ViewManager::PrepareSceneView()
 	// define the current projection matrix
 	// projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
 
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
+	// keep the matrices for the scene to sort and cull against
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+
+	// the camera block is created on the first frame, once the
+	// OpenGL context is available
+	if (m_cameraBuffer.IsCreated() == false)
+	{
+		m_cameraBuffer.Create(CAMERA_BLOCK_BINDING, sizeof(CAMERA_BLOCK));
+	}
+
+	// set the view and projection matrices and the view position of
+	// the camera into the camera block, uploaded once for the frame
+	CAMERA_BLOCK camera;
+	camera.view = view;
+	camera.projection = projection;
+	camera.viewPosition = g_pCamera->Position;
+	camera.padding = 0.0f;
+	m_cameraBuffer.Write(0, camera);
+	m_cameraBuffer.Flush();
+}
+
+/***********************************************************
+ *  GetViewPosition()
+ *
+ *  This method is used for getting the current position of
+ *  the camera in world space.
+ ***********************************************************/
+glm::vec3 ViewManager::GetViewPosition() const
+{
+	if (NULL == g_pCamera)
+	{
+		return(glm::vec3(0.0f));
+	}
+
+	return(g_pCamera->Position);
+}
+
+/***********************************************************
+ *  SetViewSize()
+ *
+ *  This method is used for setting the size of the rendered
+ *  view, such as an offscreen framebuffer, so the
+ *  perspective projection keeps its aspect ratio.
+ ***********************************************************/
+void ViewManager::SetViewSize(int width, int height)
+{
+	if ((width > 0) && (height > 0))
 	{
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		m_viewWidth = width;
+		m_viewHeight = height;
+		g_bViewChanged = true;
 	}
+}
+
+/***********************************************************
+ *  SetCameraPose()
+ *
+ *  This method is used for placing the camera at a position
+ *  and turning it to look along the passed in direction.
+ ***********************************************************/
+void ViewManager::SetCameraPose(const glm::vec3& position, const glm::vec3& front)
+{
+	if (NULL == g_pCamera)
+	{
+		return;
+	}
+
+	g_pCamera->Position = position;
+	g_pCamera->Front = glm::normalize(front);
+	g_bViewChanged = true;
+}
+
+/***********************************************************
+ *  IsViewChanged()
+ *
+ *  This method is used for checking whether the camera, the
+ *  projection or the window changed since the flag was last
+ *  cleared, meaning the displayed frame is out of date.
+ ***********************************************************/
+bool ViewManager::IsViewChanged() const
+{
+	return(g_bViewChanged);
+}
+
+/***********************************************************
+ *  ClearViewChanged()
+ *
+ *  This method is used for clearing the view changed flag
+ *  before a frame is drawn.  Preparing the frame sets it
+ *  again while the camera is still moving.
+ ***********************************************************/
+void ViewManager::ClearViewChanged()
+{
+	g_bViewChanged = false;
+}
+
+/***********************************************************
+ *  ResetFrameTime()
+ *
+ *  This method is used for restarting the frame timing
+ *  after waiting for events, so the first frame drawn
+ *  afterwards does not move the camera by the time spent
+ *  waiting.
+ ***********************************************************/
+void ViewManager::ResetFrameTime()
+{
+	gLastFrame = glfwGetTime();
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "ShaderManager.h"
+#include "UniformBuffer.h"
 #include "camera.h"
 
 // GLFW library
@@ -25,15 +26,39 @@ public:
 
    // mouse position callback for mouse interaction with the 3D scene  
    static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);  
+   // key callback marking the view changed when a key is pressed or released
+   static void Key_Callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+   // refresh callback marking the view changed when the window must be repainted
+   static void Window_Refresh_Callback(GLFWwindow* window);
 
    // toggle between perspective and orthographic views  
    void ToggleProjectionMode();  
 
+   // binding point of the shader camera block
+   static const GLuint CAMERA_BLOCK_BINDING = 1;
+
+   // std140 layout of the shader camera block
+   struct CAMERA_BLOCK
+   {
+      glm::mat4 view;
+      glm::mat4 projection;
+      glm::vec3 viewPosition;
+      float padding;
+   };
+
 private:  
    // pointer to shader manager object  
    ShaderManager* m_pShaderManager;  
+   // view parameters mirrored in the shader camera block
+   UniformBuffer m_cameraBuffer;
    // active OpenGL display window  
    GLFWwindow* m_pWindow;  
+   // view and projection matrices of the current frame
+   glm::mat4 m_viewMatrix;
+   glm::mat4 m_projectionMatrix;
+   // size of the rendered view, used for the perspective aspect ratio
+   int m_viewWidth;
+   int m_viewHeight;
 
    // process keyboard events for interaction with the 3D scene  
    void ProcessKeyboardEvents();  
@@ -44,4 +69,23 @@ public:
 
    // prepare the conversion from 3D object display to 2D scene display  
    void PrepareSceneView();  
+
+   // view parameters of the current frame
+   const glm::mat4& GetViewMatrix() const { return(m_viewMatrix); }
+   const glm::mat4& GetProjectionMatrix() const { return(m_projectionMatrix); }
+   glm::vec3 GetViewPosition() const;
+
+   // set the size of the rendered view when it is not the window size
+   void SetViewSize(int width, int height);
+   // place the camera at a position looking along a direction
+   void SetCameraPose(const glm::vec3& position, const glm::vec3& front);
+
+   // true when the camera, the projection or the window changed
+   // since the view changed flag was last cleared
+   bool IsViewChanged() const;
+   // clear the view changed flag before drawing a frame
+   void ClearViewChanged();
+   // restart the frame timing, so time spent waiting for events
+   // does not move the camera
+   void ResetFrameTime();
 };
\ No newline at end of file
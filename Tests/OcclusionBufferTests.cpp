@@ -0,0 +1,293 @@
+#include <iostream>         // test results
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // bit comparison of depths
+#include <random>           // random occluders
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "OcclusionBuffer.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// seed of the random occluders, so every run checks the same ones
+	const uint32_t RANDOM_SEED = 330;
+	// random scenes rasterized with and without SSE
+	const int RANDOM_SCENES = 50;
+	// boxes tested against each random scene
+	const int RANDOM_TESTS = 2000;
+
+	// test results
+	int g_failures = 0;
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+BOUNDING_BOX MakeBox(glm::vec3 minimum, glm::vec3 maximum);
+glm::mat4 GetViewProjection();
+void Check(const char* name, bool bCondition);
+void TestWall();
+void TestFloor();
+void TestNearPlane();
+void TestMirrored();
+void TestSimdMatchesScalar();
+
+
+/***********************************************************
+ *  main()
+ *
+ *  This function gets called after the tests have been
+ *  launched.  It runs every test, even after one fails,
+ *  and returns EXIT_FAILURE if any of them failed.
+ ***********************************************************/
+int main()
+{
+	TestWall();
+	TestFloor();
+	TestNearPlane();
+	TestMirrored();
+	TestSimdMatchesScalar();
+
+	if (g_failures > 0)
+	{
+		std::cout << g_failures << " occlusion buffer checks failed" << std::endl;
+		return(EXIT_FAILURE);
+	}
+
+	std::cout << "All occlusion buffer tests passed" << std::endl;
+	return(EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *	MakeBox()
+ *
+ *  This function is used to make a bounding box from its
+ *  corners.
+ ***********************************************************/
+BOUNDING_BOX MakeBox(glm::vec3 minimum, glm::vec3 maximum)
+{
+	BOUNDING_BOX box;
+	box.min = minimum;
+	box.max = maximum;
+	return(box);
+}
+
+/***********************************************************
+ *	GetViewProjection()
+ *
+ *  This function is used to get the camera of the tests,
+ *  ten units in front of the origin, one unit up, looking
+ *  down the negative z axis.
+ ***********************************************************/
+glm::mat4 GetViewProjection()
+{
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.0f, 10.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	return(projection * view);
+}
+
+/***********************************************************
+ *	Check()
+ *
+ *  This function is used to report a failed check.
+ ***********************************************************/
+void Check(const char* name, bool bCondition)
+{
+	if (bCondition == false)
+	{
+		std::cout << "Failed: " << name << std::endl;
+		g_failures++;
+	}
+}
+
+/***********************************************************
+ *	TestWall()
+ *
+ *  This function is used to check that a wall hides the
+ *  boxes completely behind it, and only those.
+ ***********************************************************/
+void TestWall()
+{
+	OcclusionBuffer buffer;
+	buffer.Begin(GetViewProjection());
+	glm::mat4 wall = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(4.0f, 4.0f, 0.2f));
+	buffer.DrawBox(MakeBox(glm::vec3(-0.5f), glm::vec3(0.5f)), wall);
+	buffer.Finish();
+
+	Check("the wall is rasterized", buffer.GetTriangleCount() > 0);
+	Check("a box behind the wall is hidden",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(-0.5f, 0.5f, -3.0f), glm::vec3(0.5f, 1.5f, -2.0f))) == false);
+	Check("a box in front of the wall is visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(-0.5f, 0.5f, 2.0f), glm::vec3(0.5f, 1.5f, 3.0f))) == true);
+	Check("a box beside the wall is visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(5.0f, 0.5f, -3.0f), glm::vec3(6.0f, 1.5f, -2.0f))) == true);
+	Check("a box partly behind the wall is visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(1.5f, 0.5f, -3.0f), glm::vec3(3.0f, 1.5f, -2.0f))) == true);
+	Check("the bounds of the wall itself are visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(-2.0f, -1.0f, -0.1f), glm::vec3(2.0f, 3.0f, 0.1f))) == true);
+	Check("a far box above the wall is visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(-0.5f, 6.0f, -20.0f), glm::vec3(0.5f, 7.0f, -19.0f))) == true);
+}
+
+/***********************************************************
+ *	TestFloor()
+ *
+ *  This function is used to check that a floor plane, a
+ *  box with no thickness reaching behind the camera, hides
+ *  the boxes under it.
+ ***********************************************************/
+void TestFloor()
+{
+	OcclusionBuffer buffer;
+	buffer.Begin(GetViewProjection());
+	glm::mat4 floor = glm::scale(glm::mat4(1.0f), glm::vec3(50.0f, 1.0f, 50.0f));
+	buffer.DrawBox(MakeBox(glm::vec3(-1.0f, 0.0f, -1.0f), glm::vec3(1.0f, 0.0f, 1.0f)), floor);
+	buffer.Finish();
+
+	Check("a box under the floor is hidden",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(3.0f, -3.0f, -5.0f), glm::vec3(4.0f, -2.0f, -4.0f))) == false);
+	Check("a box on the floor is visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(3.0f, 0.1f, -5.0f), glm::vec3(4.0f, 1.0f, -4.0f))) == true);
+}
+
+/***********************************************************
+ *	TestNearPlane()
+ *
+ *  This function is used to check that a box crossing the
+ *  near plane is always visible, even behind an occluder
+ *  covering the whole view, and that an occluder crossing
+ *  the near plane is clipped instead of dropped.
+ ***********************************************************/
+void TestNearPlane()
+{
+	OcclusionBuffer buffer;
+	buffer.Begin(GetViewProjection());
+	glm::mat4 wall = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(100.0f, 100.0f, 0.2f));
+	buffer.DrawBox(MakeBox(glm::vec3(-0.5f), glm::vec3(0.5f)), wall);
+	buffer.Finish();
+
+	Check("a box crossing the near plane is visible",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(-1.0f, 0.0f, 9.0f), glm::vec3(1.0f, 2.0f, 11.0f))) == true);
+	Check("a box behind a view filling wall is hidden",
+		buffer.IsBoxVisible(MakeBox(glm::vec3(-0.5f, 0.5f, -3.0f), glm::vec3(0.5f, 1.5f, -2.0f))) == false);
+
+	// a tunnel wall from behind the camera to far in front
+	OcclusionBuffer tunnel;
+	tunnel.Begin(GetViewProjection());
+	glm::mat4 side = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(-1.0f, 1.0f, 0.0f)), glm::vec3(0.2f, 10.0f, 40.0f));
+	tunnel.DrawBox(MakeBox(glm::vec3(-0.5f), glm::vec3(0.5f)), side);
+	tunnel.Finish();
+
+	Check("an occluder crossing the near plane is rasterized", tunnel.GetTriangleCount() > 0);
+	Check("a box behind a wall crossing the near plane is hidden",
+		tunnel.IsBoxVisible(MakeBox(glm::vec3(-4.0f, 0.5f, -6.0f), glm::vec3(-3.0f, 1.5f, -5.0f))) == false);
+}
+
+/***********************************************************
+ *	TestMirrored()
+ *
+ *  This function is used to check that a wall with a
+ *  negative scale, whose faces are turned inside out by the
+ *  transform, still hides what is behind it.
+ ***********************************************************/
+void TestMirrored()
+{
+	glm::vec3 scales[3] =
+	{
+		glm::vec3(-4.0f, 4.0f, 0.2f),
+		glm::vec3(4.0f, -4.0f, 0.2f),
+		glm::vec3(-4.0f, -4.0f, -0.2f)
+	};
+
+	for (int i = 0; i < 3; i++)
+	{
+		OcclusionBuffer buffer;
+		buffer.Begin(GetViewProjection());
+		glm::mat4 wall = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)), scales[i]);
+		buffer.DrawBox(MakeBox(glm::vec3(-0.5f), glm::vec3(0.5f)), wall);
+		buffer.Finish();
+
+		Check("a mirrored wall hides the box behind it",
+			buffer.IsBoxVisible(MakeBox(glm::vec3(-0.5f, 0.5f, -3.0f), glm::vec3(0.5f, 1.5f, -2.0f))) == false);
+	}
+}
+
+/***********************************************************
+ *	TestSimdMatchesScalar()
+ *
+ *  This function is used to check that random occluders
+ *  rasterized four pixels at a time give the same depth
+ *  buffer, bit for bit, as one pixel at a time, and the
+ *  same visibility for random boxes.
+ ***********************************************************/
+void TestSimdMatchesScalar()
+{
+	std::mt19937 random(RANDOM_SEED);
+	std::uniform_real_distribution<float> position(-8.0f, 8.0f);
+	std::uniform_real_distribution<float> size(-3.0f, 3.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_int_distribution<int> resolution(1, 200);
+
+	OcclusionBuffer simd;
+	OcclusionBuffer scalar;
+	scalar.SetSimdEnabled(false);
+
+	int depthMismatches = 0;
+	int visibilityMismatches = 0;
+	for (int scene = 0; scene < RANDOM_SCENES; scene++)
+	{
+		// odd sizes make rows that end inside a group of four
+		int width = resolution(random);
+		int height = resolution(random);
+		simd.SetSize(width, height);
+		scalar.SetSize(width, height);
+
+		simd.Begin(GetViewProjection());
+		scalar.Begin(GetViewProjection());
+		for (int i = 0; i < 12; i++)
+		{
+			glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+			transform = glm::rotate(transform, angle(random), glm::normalize(glm::vec3(size(random), size(random), size(random)) + glm::vec3(0.01f)));
+			transform = glm::scale(transform, glm::vec3(size(random), size(random), size(random)));
+			BOUNDING_BOX box = MakeBox(glm::vec3(-0.5f), glm::vec3(0.5f));
+			simd.DrawBox(box, transform);
+			scalar.DrawBox(box, transform);
+		}
+		simd.Finish();
+		scalar.Finish();
+
+		for (int y = 0; y < simd.GetHeight(); y++)
+		{
+			for (int x = 0; x < simd.GetWidth(); x++)
+			{
+				float simdDepth = simd.GetDepth(x, y);
+				float scalarDepth = scalar.GetDepth(x, y);
+				if (std::memcmp(&simdDepth, &scalarDepth, sizeof(float)) != 0)
+				{
+					depthMismatches++;
+				}
+			}
+		}
+
+		for (int i = 0; i < RANDOM_TESTS; i++)
+		{
+			glm::vec3 center(position(random), position(random), position(random));
+			glm::vec3 extent = glm::abs(glm::vec3(size(random), size(random), size(random))) * 0.2f;
+			BOUNDING_BOX box = MakeBox(center - extent, center + extent);
+			if (simd.IsBoxVisible(box) != scalar.IsBoxVisible(box))
+			{
+				visibilityMismatches++;
+			}
+		}
+	}
+
+	if ((depthMismatches > 0) || (visibilityMismatches > 0))
+	{
+		std::cout << "TestSimdMatchesScalar: " << depthMismatches << " depths and "
+			<< visibilityMismatches << " visibility results differ" << std::endl;
+	}
+	Check("SSE and scalar rasterization give the same depths", depthMismatches == 0);
+	Check("SSE and scalar rasterization give the same visibility", visibilityMismatches == 0);
+}
@@ -0,0 +1,383 @@
+#include <iostream>         // test results
+#include <cstdlib>          // EXIT_FAILURE
+#include <cfloat>           // FLT_EPSILON
+#include <cmath>
+#include <cstring>          // bit comparison of matrices
+#include <random>           // random transforms
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "TransformBatch.h"
+#include "JobSystem.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// seed of the random transforms, so every run checks the same ones
+	const uint32_t RANDOM_SEED = 330;
+	// transforms added by the random tests - not a multiple of four,
+	// so the last group is computed one transform at a time
+	const int TRANSFORM_COUNT = 4099;
+	// largest difference from the GLM composition, in units of the
+	// float epsilon scaled by the largest value of the matrix column
+	const float MAX_REFERENCE_ULPS = 4.0f;
+	// rotations that make many terms exactly zero or one
+	const float SPECIAL_ANGLES[] = { 0.0f, 90.0f, 180.0f, 270.0f, -90.0f, 360.0f, -0.0f };
+
+	struct TRANSFORM_VALUES
+	{
+		glm::vec3 scale;
+		glm::vec3 rotation;
+		glm::vec3 position;
+	};
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+std::vector<TRANSFORM_VALUES> GenerateTransforms(int count, uint32_t seed);
+void AddTransforms(TransformBatch& batch, const std::vector<TRANSFORM_VALUES>& transforms);
+bool IsSameMatrix(const glm::mat4& a, const glm::mat4& b);
+bool TestFourMatchesOne();
+bool TestComputeMatchesOne();
+bool TestReferenceBound();
+bool TestChangedTransforms();
+bool TestRemovedTransforms();
+
+
+/***********************************************************
+ *  main()
+ *
+ *  This function gets called after the tests have been
+ *  launched.  It runs every test, even after one fails,
+ *  and returns EXIT_FAILURE if any of them failed.
+ ***********************************************************/
+int main()
+{
+	bool bPassed = true;
+
+	bPassed = TestFourMatchesOne() && bPassed;
+	bPassed = TestComputeMatchesOne() && bPassed;
+	bPassed = TestReferenceBound() && bPassed;
+	bPassed = TestChangedTransforms() && bPassed;
+	bPassed = TestRemovedTransforms() && bPassed;
+
+	std::cout << ((bPassed == true) ? "All transform batch tests passed" : "Transform batch tests failed") << std::endl;
+
+	return((bPassed == true) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/***********************************************************
+ *	GenerateTransforms()
+ *
+ *  This function is used to generate random transformation
+ *  values.  Some of the rotations use angles whose sines and
+ *  cosines are zero or one, and some of the scales are
+ *  negative or zero, since those give signed zero terms.
+ ***********************************************************/
+std::vector<TRANSFORM_VALUES> GenerateTransforms(int count, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> angle(-720.0f, 720.0f);
+	std::uniform_real_distribution<float> scale(-8.0f, 8.0f);
+	std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+	std::uniform_int_distribution<int> special(0, (int)(sizeof(SPECIAL_ANGLES) / sizeof(SPECIAL_ANGLES[0])) * 2);
+
+	std::vector<TRANSFORM_VALUES> transforms(count);
+	for (int i = 0; i < count; i++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			// half of the picks use a random angle
+			int pick = special(random);
+			transforms[i].rotation[axis] = (pick < (int)(sizeof(SPECIAL_ANGLES) / sizeof(SPECIAL_ANGLES[0]))) ?
+				SPECIAL_ANGLES[pick] : angle(random);
+			transforms[i].scale[axis] = ((i % 17) == axis) ? 0.0f : scale(random);
+			transforms[i].position[axis] = position(random);
+		}
+	}
+
+	return(transforms);
+}
+
+/***********************************************************
+ *	AddTransforms()
+ *
+ *  This function is used to add transformation values to
+ *  a batch.
+ ***********************************************************/
+void AddTransforms(TransformBatch& batch, const std::vector<TRANSFORM_VALUES>& transforms)
+{
+	batch.Reserve((int)transforms.size());
+	for (size_t i = 0; i < transforms.size(); i++)
+	{
+		batch.Add(
+			transforms[i].scale,
+			transforms[i].rotation.x,
+			transforms[i].rotation.y,
+			transforms[i].rotation.z,
+			transforms[i].position);
+	}
+}
+
+/***********************************************************
+ *	IsSameMatrix()
+ *
+ *  This function is used to check that two matrices have
+ *  the same bits, so even the signs of zeros must match.
+ ***********************************************************/
+bool IsSameMatrix(const glm::mat4& a, const glm::mat4& b)
+{
+	for (int column = 0; column < 4; column++)
+	{
+		for (int row = 0; row < 4; row++)
+		{
+			if (std::memcmp(&a[column][row], &b[column][row], sizeof(float)) != 0)
+			{
+				return(false);
+			}
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *	TestFourMatchesOne()
+ *
+ *  This function is used to check that every matrix
+ *  computed four at a time, with SSE when it is available,
+ *  is identical to the one computed on its own.
+ ***********************************************************/
+bool TestFourMatchesOne()
+{
+	TransformBatch batch;
+	AddTransforms(batch, GenerateTransforms(TRANSFORM_COUNT, RANDOM_SEED));
+
+	int mismatches = 0;
+	for (int first = 0; first + 4 <= batch.GetCount(); first += 4)
+	{
+		batch.ComputeFour(first);
+		glm::mat4 four[4];
+		for (int i = 0; i < 4; i++)
+		{
+			four[i] = batch.GetMatrix(first + i);
+		}
+
+		for (int i = 0; i < 4; i++)
+		{
+			batch.ComputeOne(first + i);
+			if (IsSameMatrix(four[i], batch.GetMatrix(first + i)) == false)
+			{
+				mismatches++;
+			}
+		}
+	}
+
+	if (mismatches > 0)
+	{
+		std::cout << "TestFourMatchesOne: " << mismatches << " matrices differ" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *	TestComputeMatchesOne()
+ *
+ *  This function is used to check that the pass computes
+ *  the same matrices with and without a job system as the
+ *  transforms computed one at a time.
+ ***********************************************************/
+bool TestComputeMatchesOne()
+{
+	std::vector<TRANSFORM_VALUES> transforms = GenerateTransforms(TRANSFORM_COUNT, RANDOM_SEED + 1);
+	JobSystem jobSystem;
+	jobSystem.Start(4);
+
+	TransformBatch single;
+	TransformBatch threaded;
+	TransformBatch expected;
+	AddTransforms(single, transforms);
+	AddTransforms(threaded, transforms);
+	AddTransforms(expected, transforms);
+	single.Compute();
+	threaded.Compute(&jobSystem);
+	jobSystem.Stop();
+
+	int mismatches = 0;
+	for (int i = 0; i < expected.GetCount(); i++)
+	{
+		expected.ComputeOne(i);
+		if ((IsSameMatrix(single.GetMatrix(i), expected.GetMatrix(i)) == false) ||
+			(IsSameMatrix(threaded.GetMatrix(i), expected.GetMatrix(i)) == false))
+		{
+			mismatches++;
+		}
+	}
+
+	if (mismatches > 0)
+	{
+		std::cout << "TestComputeMatchesOne: " << mismatches << " matrices differ" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *	TestReferenceBound()
+ *
+ *  This function is used to check the computed matrices
+ *  against the GLM composition.  The terms are summed in
+ *  another order, so every value may differ by a few units
+ *  of the float epsilon of the largest value in its column,
+ *  while the translations must be equal.
+ ***********************************************************/
+bool TestReferenceBound()
+{
+	TransformBatch batch;
+	AddTransforms(batch, GenerateTransforms(TRANSFORM_COUNT, RANDOM_SEED + 2));
+	batch.Compute();
+
+	float maxUlps = 0.0f;
+	int translationMismatches = 0;
+	for (int i = 0; i < batch.GetCount(); i++)
+	{
+		const glm::mat4& matrix = batch.GetMatrix(i);
+		glm::mat4 reference = batch.ComputeReference(i);
+
+		for (int column = 0; column < 3; column++)
+		{
+			float largest = 0.0f;
+			for (int row = 0; row < 4; row++)
+			{
+				largest = std::max(largest, std::abs(reference[column][row]));
+			}
+			for (int row = 0; row < 4; row++)
+			{
+				float difference = std::abs(matrix[column][row] - reference[column][row]);
+				if (difference > 0.0f)
+				{
+					maxUlps = std::max(maxUlps, difference / (FLT_EPSILON * largest));
+				}
+			}
+		}
+
+		if (matrix[3] != reference[3])
+		{
+			translationMismatches++;
+		}
+	}
+
+	std::cout << "TestReferenceBound: largest difference " << maxUlps << " ulps" << std::endl;
+	if ((maxUlps > MAX_REFERENCE_ULPS) || (translationMismatches > 0))
+	{
+		std::cout << "TestReferenceBound: more than " << MAX_REFERENCE_ULPS << " ulps, or "
+			<< translationMismatches << " translations differ" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *	TestChangedTransforms()
+ *
+ *  This function is used to check that a pass reports and
+ *  computes the transforms changed since the previous pass,
+ *  and leaves the others as they were.
+ ***********************************************************/
+bool TestChangedTransforms()
+{
+	std::vector<TRANSFORM_VALUES> transforms = GenerateTransforms(11, RANDOM_SEED + 3);
+	TransformBatch batch;
+	AddTransforms(batch, transforms);
+	batch.Compute();
+
+	std::vector<glm::mat4> before(batch.GetCount());
+	for (int i = 0; i < batch.GetCount(); i++)
+	{
+		before[i] = batch.GetMatrix(i);
+	}
+
+	// one change in a full group and one in the last group
+	batch.Set(5, glm::vec3(2.0f), 10.0f, 20.0f, 30.0f, glm::vec3(1.0f, 2.0f, 3.0f));
+	batch.Set(9, glm::vec3(0.5f), -45.0f, 0.0f, 90.0f, glm::vec3(-1.0f));
+	if (batch.IsDirty() == false)
+	{
+		std::cout << "TestChangedTransforms: the batch is not dirty after a change" << std::endl;
+		return(false);
+	}
+	batch.Compute();
+
+	const std::vector<int>& changes = batch.GetComputedChanges();
+	if ((batch.IsDirty() == true) || (changes.size() != 2) || (changes[0] != 5) || (changes[1] != 9))
+	{
+		std::cout << "TestChangedTransforms: the pass did not report the two changes" << std::endl;
+		return(false);
+	}
+
+	TransformBatch expected;
+	AddTransforms(expected, transforms);
+	expected.Set(5, glm::vec3(2.0f), 10.0f, 20.0f, 30.0f, glm::vec3(1.0f, 2.0f, 3.0f));
+	expected.Set(9, glm::vec3(0.5f), -45.0f, 0.0f, 90.0f, glm::vec3(-1.0f));
+	for (int i = 0; i < batch.GetCount(); i++)
+	{
+		expected.ComputeOne(i);
+		const glm::mat4& wanted = ((i == 5) || (i == 9)) ? expected.GetMatrix(i) : before[i];
+		if (IsSameMatrix(batch.GetMatrix(i), wanted) == false)
+		{
+			std::cout << "TestChangedTransforms: matrix " << i << " is wrong after the pass" << std::endl;
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *	TestRemovedTransforms()
+ *
+ *  This function is used to check that a removed transform
+ *  drops its pending change and that its index is reused
+ *  by the next transform added.
+ ***********************************************************/
+bool TestRemovedTransforms()
+{
+	TransformBatch batch;
+	AddTransforms(batch, GenerateTransforms(6, RANDOM_SEED + 4));
+	batch.Compute();
+
+	batch.Set(2, glm::vec3(3.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f));
+	batch.Set(4, glm::vec3(3.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f));
+	batch.Remove(2);
+	batch.Compute();
+
+	const std::vector<int>& changes = batch.GetComputedChanges();
+	if ((changes.size() != 1) || (changes[0] != 4))
+	{
+		std::cout << "TestRemovedTransforms: a removed transform was reported by the pass" << std::endl;
+		return(false);
+	}
+
+	// removing twice must not free the index twice
+	batch.Remove(2);
+	int reused = batch.Add(glm::vec3(1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(7.0f, 8.0f, 9.0f));
+	int added = batch.Add(glm::vec3(1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f));
+	if ((reused != 2) || (added != 6) || (batch.GetCount() != 7))
+	{
+		std::cout << "TestRemovedTransforms: the removed index was not reused once" << std::endl;
+		return(false);
+	}
+
+	batch.Compute();
+	if (batch.GetMatrix(2)[3] != glm::vec4(7.0f, 8.0f, 9.0f, 1.0f))
+	{
+		std::cout << "TestRemovedTransforms: the reused transform was not computed" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}